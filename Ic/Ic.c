@@ -1,5 +1,85 @@
 #include "Ic.h"
 
-/* Empty file for compatibility */
+#if IC_ISR_PROFILE
 
-/* Reserved for future development */
\ No newline at end of file
+/******************************************************************************/
+/*--------------------------Local Data Variables------------------------------*/
+/******************************************************************************/
+
+/** Execution time statistics of ISR callbacks **/
+static IcIsrProfile_t isrProfile[IC_PROFILE_COUNT];
+
+/******************************************************************************/
+/*----------------------External Function Definitions-------------------------*/
+/******************************************************************************/
+
+/*
+ *  Records execution time of a callback (used by IC_PROFILE_CALL())
+ */
+extern void IC_UpdateIsrProfile(IcProfileSlot_t slot, uint32_t ticks)
+{
+    /* Higher priority ISR may update statistics meanwhile */
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    
+    IcIsrProfile_t *profilePtr = &isrProfile[slot];
+    
+    if( (profilePtr->count == 0) || (ticks < profilePtr->minTicks) )
+    {
+        profilePtr->minTicks = ticks;
+    }
+    if( ticks > profilePtr->maxTicks )
+    {
+        profilePtr->maxTicks = ticks;
+    }
+    profilePtr->totalTicks += ticks;
+    profilePtr->count++;
+    
+    IC_SetInterruptState(intrStatus);
+}
+
+
+/*
+ *  Reads execution time statistics of a callback slot
+ *  Returns false if any input restriction is triggered
+ */
+extern bool IC_GetIsrProfile(IcProfileSlot_t slot, IcIsrProfile_t *const profilePtr)
+{
+    /* Input protection */
+    if( (slot >= IC_PROFILE_COUNT) || (profilePtr == NULL) )
+    {
+        return false;
+    }
+    
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    *profilePtr = isrProfile[slot];
+    IC_SetInterruptState(intrStatus);
+    
+    /* Average is computed here to keep ISR overhead low */
+    if( profilePtr->count > 0 )
+    {
+        profilePtr->avgTicks = (uint32_t)(profilePtr->totalTicks / profilePtr->count);
+    }
+    
+    return true;
+}
+
+
+/*
+ *  Clears execution time statistics of all callback slots
+ */
+extern void IC_ResetIsrProfile(void)
+{
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    
+    for( uint32_t idx = 0; idx < IC_PROFILE_COUNT; idx++ )
+    {
+        isrProfile[idx] = (IcIsrProfile_t){0};
+    }
+    
+    IC_SetInterruptState(intrStatus);
+}
+
+#endif  /* IC_ISR_PROFILE */
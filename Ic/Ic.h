@@ -29,6 +29,56 @@
 #define bool  bool
 #endif
 
+/* Set to 1 to measure execution time of ISR user-defined callbacks (compiled
+ * out completely otherwise) */
+#ifndef IC_ISR_PROFILE
+#define IC_ISR_PROFILE  0
+#endif
+
+/* Executes handler call and records its duration in core timer ticks */
+#if IC_ISR_PROFILE
+#define IC_PROFILE_CALL(slot, handlerCall)                                  \
+    do {                                                                    \
+        uint32_t profileStart = _CP0_GET_COUNT();                          \
+        handlerCall;                                                        \
+        IC_UpdateIsrProfile((slot), _CP0_GET_COUNT() - profileStart);       \
+    } while(0)
+#else
+#define IC_PROFILE_CALL(slot, handlerCall)  handlerCall
+#endif
+
+
+/******************************************************************************/
+/*----------------------------Enumeration Types-------------------------------*/
+/******************************************************************************/
+
+/* Profiled ISR callback slots */
+typedef enum {
+    IC_PROFILE_TMR1 = 0,
+    IC_PROFILE_TMR2 = 1,
+    IC_PROFILE_TMR3 = 2,
+    IC_PROFILE_TMR4 = 3,
+    IC_PROFILE_TMR5 = 4,
+    IC_PROFILE_CORE_TMR = 5,
+    IC_PROFILE_CNA = 6,
+    IC_PROFILE_CNB = 7,
+    IC_PROFILE_COUNT = 8
+} IcProfileSlot_t;
+
+
+/******************************************************************************/
+/*-----------------------------Data Structures--------------------------------*/
+/******************************************************************************/
+
+/* Execution time statistics of a callback slot (in core timer ticks) */
+typedef struct {
+    uint32_t    count;
+    uint32_t    minTicks;
+    uint32_t    maxTicks;
+    uint32_t    avgTicks;       // Computed when read
+    uint64_t    totalTicks;
+} IcIsrProfile_t;
+
 
 /******************************************************************************/
 /*-----------------------------Function Prototypes----------------------------*/
@@ -39,6 +89,13 @@ INLINE void IC_DisableInterrupts(void);
 INLINE void IC_SetInterruptState(volatile uint32_t intrState);
 INLINE volatile uint32_t IC_GetInterruptState(void);
 
+#if IC_ISR_PROFILE
+/* ISR execution time profiling functions */
+void IC_UpdateIsrProfile(IcProfileSlot_t slot, uint32_t ticks);
+bool IC_GetIsrProfile(IcProfileSlot_t slot, IcIsrProfile_t *const profilePtr);
+void IC_ResetIsrProfile(void);
+#endif
+
 
 /******************************************************************************/
 /*-----------------------------Function In-lines------------------------------*/
@@ -4,13 +4,122 @@
 static OscSfr_t *const oscSfr = &OSC_MODULE;
 static CfgSfr_t *const cfgSfr = &CFG_MODULE;      
 
-/** Local POSC variable **/
-static uint32_t poscFreq;
+/** Local cached clock tree (generation 0 means not yet decoded) **/
+static volatile OscClkState_t clkState;
+
+/** Local duration of last clock switch sequence in microseconds **/
+static uint32_t switchTimeUs;
+
+/** Local clock change hooks (pre-change hook gets old, post-change hook new
+ ** clock tree) **/
+static struct {
+    void (*preHook)(const OscClkState_t *const statePtr);
+    void (*postHook)(const OscClkState_t *const statePtr);
+} clkHook[OSC_CLK_HOOK_COUNT];
+static uint32_t clkHookCount;
+
+/** Local DFS governor state (idle time and windows counted in core timer
+ ** counts) **/
+static struct {
+    const OscGovConfig_t    *configPtr;     // NULL if governor is not running
+    uint32_t                windowStart;
+    uint32_t                windowCount;
+    uint32_t                idleStart;
+    uint32_t                idleCount;
+    uint32_t                holdLeft;
+    OscGovStatus_t          status;
+} gov;
+
+/** PLL output ratio (PLLMULT / PLLODIV) **/
+typedef struct {
+    uint8_t     mult;
+    uint8_t     multCode;
+    uint16_t    div;
+    uint8_t     divCode;
+} OscPllRatio_t;
+
+/** All PLL output ratios sorted in ascending order (all 64 are distinct) **/
+static const OscPllRatio_t pllRatio[64] = {
+    {15, OSC_PLLMULT_15, 256, OSC_PLLODIV_256},
+    {16, OSC_PLLMULT_16, 256, OSC_PLLODIV_256},
+    {17, OSC_PLLMULT_17, 256, OSC_PLLODIV_256},
+    {18, OSC_PLLMULT_18, 256, OSC_PLLODIV_256},
+    {19, OSC_PLLMULT_19, 256, OSC_PLLODIV_256},
+    {20, OSC_PLLMULT_20, 256, OSC_PLLODIV_256},
+    {21, OSC_PLLMULT_21, 256, OSC_PLLODIV_256},
+    {24, OSC_PLLMULT_24, 256, OSC_PLLODIV_256},
+    {15, OSC_PLLMULT_15,  64, OSC_PLLODIV_64},
+    {16, OSC_PLLMULT_16,  64, OSC_PLLODIV_64},
+    {17, OSC_PLLMULT_17,  64, OSC_PLLODIV_64},
+    {18, OSC_PLLMULT_18,  64, OSC_PLLODIV_64},
+    {19, OSC_PLLMULT_19,  64, OSC_PLLODIV_64},
+    {20, OSC_PLLMULT_20,  64, OSC_PLLODIV_64},
+    {21, OSC_PLLMULT_21,  64, OSC_PLLODIV_64},
+    {24, OSC_PLLMULT_24,  64, OSC_PLLODIV_64},
+    {15, OSC_PLLMULT_15,  32, OSC_PLLODIV_32},
+    {16, OSC_PLLMULT_16,  32, OSC_PLLODIV_32},
+    {17, OSC_PLLMULT_17,  32, OSC_PLLODIV_32},
+    {18, OSC_PLLMULT_18,  32, OSC_PLLODIV_32},
+    {19, OSC_PLLMULT_19,  32, OSC_PLLODIV_32},
+    {20, OSC_PLLMULT_20,  32, OSC_PLLODIV_32},
+    {21, OSC_PLLMULT_21,  32, OSC_PLLODIV_32},
+    {24, OSC_PLLMULT_24,  32, OSC_PLLODIV_32},
+    {15, OSC_PLLMULT_15,  16, OSC_PLLODIV_16},
+    {16, OSC_PLLMULT_16,  16, OSC_PLLODIV_16},
+    {17, OSC_PLLMULT_17,  16, OSC_PLLODIV_16},
+    {18, OSC_PLLMULT_18,  16, OSC_PLLODIV_16},
+    {19, OSC_PLLMULT_19,  16, OSC_PLLODIV_16},
+    {20, OSC_PLLMULT_20,  16, OSC_PLLODIV_16},
+    {21, OSC_PLLMULT_21,  16, OSC_PLLODIV_16},
+    {24, OSC_PLLMULT_24,  16, OSC_PLLODIV_16},
+    {15, OSC_PLLMULT_15,   8, OSC_PLLODIV_8},
+    {16, OSC_PLLMULT_16,   8, OSC_PLLODIV_8},
+    {17, OSC_PLLMULT_17,   8, OSC_PLLODIV_8},
+    {18, OSC_PLLMULT_18,   8, OSC_PLLODIV_8},
+    {19, OSC_PLLMULT_19,   8, OSC_PLLODIV_8},
+    {20, OSC_PLLMULT_20,   8, OSC_PLLODIV_8},
+    {21, OSC_PLLMULT_21,   8, OSC_PLLODIV_8},
+    {24, OSC_PLLMULT_24,   8, OSC_PLLODIV_8},
+    {15, OSC_PLLMULT_15,   4, OSC_PLLODIV_4},
+    {16, OSC_PLLMULT_16,   4, OSC_PLLODIV_4},
+    {17, OSC_PLLMULT_17,   4, OSC_PLLODIV_4},
+    {18, OSC_PLLMULT_18,   4, OSC_PLLODIV_4},
+    {19, OSC_PLLMULT_19,   4, OSC_PLLODIV_4},
+    {20, OSC_PLLMULT_20,   4, OSC_PLLODIV_4},
+    {21, OSC_PLLMULT_21,   4, OSC_PLLODIV_4},
+    {24, OSC_PLLMULT_24,   4, OSC_PLLODIV_4},
+    {15, OSC_PLLMULT_15,   2, OSC_PLLODIV_2},
+    {16, OSC_PLLMULT_16,   2, OSC_PLLODIV_2},
+    {17, OSC_PLLMULT_17,   2, OSC_PLLODIV_2},
+    {18, OSC_PLLMULT_18,   2, OSC_PLLODIV_2},
+    {19, OSC_PLLMULT_19,   2, OSC_PLLODIV_2},
+    {20, OSC_PLLMULT_20,   2, OSC_PLLODIV_2},
+    {21, OSC_PLLMULT_21,   2, OSC_PLLODIV_2},
+    {24, OSC_PLLMULT_24,   2, OSC_PLLODIV_2},
+    {15, OSC_PLLMULT_15,   1, OSC_PLLODIV_1},
+    {16, OSC_PLLMULT_16,   1, OSC_PLLODIV_1},
+    {17, OSC_PLLMULT_17,   1, OSC_PLLODIV_1},
+    {18, OSC_PLLMULT_18,   1, OSC_PLLODIV_1},
+    {19, OSC_PLLMULT_19,   1, OSC_PLLODIV_1},
+    {20, OSC_PLLMULT_20,   1, OSC_PLLODIV_1},
+    {21, OSC_PLLMULT_21,   1, OSC_PLLODIV_1},
+    {24, OSC_PLLMULT_24,   1, OSC_PLLODIV_1}
+};
+
+/** FRCDIV and PBDIV division factors indexed by bit-field value **/
+static const uint16_t frcDivFactor[8] = {1, 2, 4, 8, 16, 32, 64, 256};
+static const uint16_t pbDivFactor[4] = {1, 2, 4, 8};
 
 /** Local sub-functions **/
-static uint32_t GetPllMultDiv(float pllFactor);
-static uint32_t GetFrcDiv(float divFactor);
-static uint32_t GetPbDiv(float divFactor);
+static void ClkStateUpdate(void);
+static void ClkHookNotify(bool isPostChange);
+static uint32_t SwitchPhaseUs(uint32_t *const countPtr, uint32_t sysFreq);
+static bool GovSwitch(const OscGovConfig_t *const configPtr, uint32_t oppIdx);
+static void GovWindowStart(const OscGovConfig_t *const configPtr);
+static uint32_t ReadSysFreq(void);
+static uint32_t GetPllInDiv(void);
+static uint32_t GetPllMultDiv(uint32_t inFreq, uint32_t inDiv, uint32_t outFreq);
+static uint32_t GetNearestDiv(uint32_t inFreq, uint32_t outFreq, const uint16_t *divPtr, uint32_t divCount);
 
 
 /*  
@@ -34,9 +143,12 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
     /* PBCLK zero check */
     if( oscConfig.pbFreq == 0 )
     {
-        oscConfig.pbFreq = oscConfig.pbFreq;
+        oscConfig.pbFreq = oscConfig.sysFreq;
     }
     
+    /* Dependent drivers are notified before clock change */
+    ClkHookNotify(false);
+    
     /* NOTE: pllOutFreq = (inFreq * PLLMULT) / (FPLLIDIV * PLLDIV) */
     
     uint32_t pllCode = 0;
@@ -45,7 +157,7 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
     if( oscConfig.oscSource == OSC_COSC_FRCPLL )
     {
         /* Return bit-field values for PLLDIV and PLLMULT configure */
-        pllCode = GetPllMultDiv((float)oscConfig.sysFreq / OSC_FRC_FREQ);
+        pllCode = GetPllMultDiv(OSC_FRC_FREQ, GetPllInDiv(), oscConfig.sysFreq);
     }
     else if( oscConfig.oscSource == OSC_COSC_POSCPLL )
     {
@@ -53,13 +165,13 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
         if( OSC_XTAL_FREQ != 0 )
         {
             /* Return bit-field values for PLLDIV and PLLMULT configure */
-            pllCode = GetPllMultDiv((float)oscConfig.sysFreq / OSC_XTAL_FREQ);
+            pllCode = GetPllMultDiv(OSC_XTAL_FREQ, GetPllInDiv(), oscConfig.sysFreq);
         }
     }
     else if( oscConfig.oscSource == OSC_COSC_FRCDIV )
     {
         /* Return bit-field value for FRCDIV configure */
-        frcCode = GetFrcDiv((float)OSC_FRC_FREQ / oscConfig.sysFreq);
+        frcCode = GetNearestDiv(OSC_FRC_FREQ, oscConfig.sysFreq, frcDivFactor, 8);
     }
     /* SOSC, LPRC, FRC or POSC */
     else
@@ -68,7 +180,7 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
     }
     
     /* Return bit-field value for PBDIV configure */
-    OscPbDiv_t pbDiv = GetPbDiv((float)oscConfig.sysFreq / oscConfig.pbFreq);
+    OscPbDiv_t pbDiv = GetNearestDiv(oscConfig.sysFreq, oscConfig.pbFreq, pbDivFactor, 4);
     OscPbDiv_t oldPbDiv = (oscSfr->OSCxCON.W & OSC_PBDIV_MASK) >> OSC_PBDIV_POS;
     
     bool isPbDiv = false;
@@ -85,17 +197,58 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
         isClkSwtch = true;
     }
     
-    /* Unlock access for CFG register */
-    volatile uint32_t intrStatus = CFG_UnlockSystemAccess();
-    
     uint8_t pllMult = (pllCode >> 8) & 0x07;
     uint8_t pllDiv = (pllCode >> 0) & 0x07;
     uint8_t frcDiv = frcCode & 0x07;
     
+    /* Fast retune within current source: PLLODIV and FRCDIV are changed on
+     * the fly, PLLMULT change or other source requires clock switch */
+    uint32_t oscCon = oscSfr->OSCxCON.W;
+    bool isFastRetune = false;
+    uint32_t retuneMask = 0;
+    uint32_t retuneValue = 0;
+    
+    if( ((oscCon & OSC_COSC_MASK) >> OSC_COSC_POS) == oscConfig.oscSource )
+    {
+        if( (oscConfig.oscSource == OSC_COSC_FRCPLL) || (oscConfig.oscSource == OSC_COSC_POSCPLL) )
+        {
+            isFastRetune = (((oscCon & OSC_PLLMULT_MASK) >> OSC_PLLMULT_POS) == pllMult);
+            retuneMask = OSC_PLLODIV_MASK;
+            retuneValue = pllDiv << OSC_PLLODIV_POS;
+        }
+        else if( oscConfig.oscSource == OSC_COSC_FRCDIV )
+        {
+            isFastRetune = true;
+            retuneMask = OSC_FRCDIV_MASK;
+            retuneValue = frcDiv << OSC_FRCDIV_POS;
+        }
+        /* Nothing to retune with fixed frequency sources */
+        else
+        {
+            isFastRetune = true;
+        }
+    }
+    
+    /* SYSCLK before clock change (core timer rate of first switch phase) */
+    uint32_t oldSysFreq = OSC_GetSysFreq();
+    
+    /* Unlock access for CFG register */
+    volatile uint32_t intrStatus = CFG_UnlockSystemAccess();
+    
+    /* Switch time is accumulated per phase at SYSCLK of that phase */
+    uint32_t phaseCount = _CP0_GET_COUNT();
+    uint32_t switchUs = 0;
+    
+    /* Single atomic write of changed bits (no intermediate divider setting) */
+    if( isFastRetune )
+    {
+        oscSfr->OSCxCON.INV = (oscCon ^ retuneValue) & retuneMask;
+        switchUs += SwitchPhaseUs(&phaseCount, oldSysFreq);
+    }
     /* Clock switch sequence and PLL configuration (clock switch code always
      * executes if FCKM enabled however hardware automatically terminates
      * second part of the switch if FRC source is selected */
-    if( isClkSwtch )
+    else if( isClkSwtch )
     {
         /* Switch to FRC first, then to PLL (if enabled) */
         oscSfr->OSCxCON.CLR = OSC_NOSC_MASK;
@@ -104,6 +257,7 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
 
         /* Wait until clock switch to FRC is complete */
         while( oscSfr->OSCxCON.W & OSC_OSWEN_MASK );
+        switchUs += SwitchPhaseUs(&phaseCount, oldSysFreq);
         
         oscSfr->OSCxCON.CLR = OSC_PLLMULT_MASK | OSC_PLLODIV_MASK | OSC_NOSC_MASK | OSC_FRCDIV_MASK;
         oscSfr->OSCxCON.SET = (pllMult << OSC_PLLMULT_POS) |
@@ -114,6 +268,7 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
 
         /* Wait until clock switch to new source complete */
         while( oscSfr->OSCxCON.W & OSC_OSWEN_MASK );
+        switchUs += SwitchPhaseUs(&phaseCount, OSC_FRC_FREQ);
     }
     /* In case clock switching is disabled but PLL source was set at device
      * programming only configure PLL */
@@ -123,17 +278,16 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
         oscSfr->OSCxCON.SET = (pllMult << OSC_PLLMULT_POS) |
                               (pllDiv << OSC_PLLODIV_POS) |
                               (frcDiv << OSC_FRCDIV_POS);
+        switchUs += SwitchPhaseUs(&phaseCount, oldSysFreq);
     }
     
-    /* PBCLK division configuration */
+    /* PBCLK division configuration (skipped if unchanged) */
     if( isPbDiv )
     {
-        oscSfr->OSCxCON.CLR = OSC_PBDIV_MASK;
-        
         /* Wait until PBDIV can be written */
         while( !(oscSfr->OSCxCON.W & OSC_PBDIVRDY_MASK) );
         
-        oscSfr->OSCxCON.SET = pbDiv << OSC_PBDIV_POS;
+        oscSfr->OSCxCON.INV = ((oldPbDiv ^ pbDiv) << OSC_PBDIV_POS) & OSC_PBDIV_MASK;
     }
     
     /* SOSC Enabled */
@@ -149,45 +303,394 @@ extern bool OSC_ConfigOsc(OscConfig_t oscConfig)
         oscSfr->OSCxCON.CLR = OSC_SOSCEN_MASK;
     }
     
+    /* Clock tree cache is updated while interrupts are still disabled */
+    ClkStateUpdate();
+    
+    /* PBDIV and SOSC waits run at new SYSCLK */
+    switchUs += SwitchPhaseUs(&phaseCount, clkState.sysFreq);
+    switchTimeUs = switchUs;
+    
     /* Lock access for CFG register */
     CFG_LockSystemAccess(intrStatus);
     
+    /* Dependent drivers rescale their settings to new clock tree */
+    ClkHookNotify(true);
+    
     return true;
 }
 
 
 /*  
- *  Returns the system clock frequency (SYSCLK)
+ *  Returns the system clock frequency (SYSCLK) from cached clock tree
  */
 extern uint32_t OSC_GetSysFreq(void)
+{
+    if( clkState.generation == 0 )
+    {
+        ClkStateUpdate();
+    }
+    
+    return clkState.sysFreq;
+}
+
+
+/*
+ *  Returns the frequency of the peripheral bus (PBCLK) from cached clock tree
+ */
+extern uint32_t OSC_GetPbFreq(void)
+{
+    if( clkState.generation == 0 )
+    {
+        ClkStateUpdate();
+    }
+    
+    return clkState.pbFreq;
+}
+
+
+/*
+ *  Returns consistent copy of cached clock tree
+ */
+extern void OSC_GetClkState(OscClkState_t *const statePtr)
+{
+    uint32_t generation;
+    
+    /* Copy again if clock tree was updated in the meantime (from ISR) */
+    do
+    {
+        generation = OSC_GetClkGeneration();
+        
+        statePtr->oscSource = clkState.oscSource;
+        statePtr->sysFreq = clkState.sysFreq;
+        statePtr->pbFreq = clkState.pbFreq;
+        statePtr->cyclesPerUs = clkState.cyclesPerUs;
+        statePtr->generation = generation;
+    }
+    while( generation != clkState.generation );
+}
+
+
+/*
+ *  Returns clock tree generation (changes on every OSC_ConfigOsc() call)
+ */
+extern uint32_t OSC_GetClkGeneration(void)
+{
+    if( clkState.generation == 0 )
+    {
+        ClkStateUpdate();
+    }
+    
+    return clkState.generation;
+}
+
+
+/*
+ *  Returns duration of last clock switch sequence of OSC_ConfigOsc() in
+ *  microseconds (without clock change hooks)
+ */
+extern uint32_t OSC_GetSwitchTimeUs(void)
+{
+    return switchTimeUs;
+}
+
+
+/*
+ *  Adds hooks executed before and after every clock change by OSC_ConfigOsc()
+ *  (either hook may be NULL, adding the same pair again has no effect)
+ *  Returns false if any input restriction is triggered
+ */
+extern bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    /* Input protection */
+    if( (preHook == NULL) && (postHook == NULL) )
+    {
+        return false;
+    }
+    
+    for( uint32_t idx = 0; idx < clkHookCount; idx++ )
+    {
+        if( (clkHook[idx].preHook == preHook) && (clkHook[idx].postHook == postHook) )
+        {
+            return true;
+        }
+    }
+    
+    /* No free hook */
+    if( clkHookCount >= OSC_CLK_HOOK_COUNT )
+    {
+        return false;
+    }
+    
+    clkHook[clkHookCount].preHook = preHook;
+    clkHook[clkHookCount].postHook = postHook;
+    clkHookCount++;
+    
+    return true;
+}
+
+
+/*
+ *  Starts DFS governor at given operating point. Points whose expected switch
+ *  time exceeds latency budget are never selected
+ *  Returns false if any input restriction is triggered
+ */
+extern bool OSC_StartGovernor(const OscGovConfig_t *const govConfigPtr, uint32_t oppIdx)
+{
+    /* Input protection */
+    if( (govConfigPtr == NULL) || (govConfigPtr->oppTable == NULL) ||
+        (govConfigPtr->oppCount == 0) || (govConfigPtr->oppCount > OSC_GOV_OPP_MAX) ||
+        (oppIdx >= govConfigPtr->oppCount) || (govConfigPtr->windowUs == 0) ||
+        (govConfigPtr->downLoadPct >= govConfigPtr->upLoadPct) )
+    {
+        return false;
+    }
+    
+    uint32_t excludedMask = 0;
+    
+    for( uint32_t idx = 0; idx < govConfigPtr->oppCount; idx++ )
+    {
+        if( govConfigPtr->oppTable[idx].switchTimeUs > govConfigPtr->latencyBudgetUs )
+        {
+            excludedMask |= (1u << idx);
+        }
+    }
+    
+    /* Initial point over latency budget */
+    if( excludedMask & (1u << oppIdx) )
+    {
+        return false;
+    }
+    
+    gov.configPtr = NULL;
+    gov.status.stepCount = 0;
+    gov.status.loadPct = 0;
+    gov.status.excludedMask = excludedMask;
+    
+    if( !GovSwitch(govConfigPtr, oppIdx) )
+    {
+        return false;
+    }
+    
+    gov.configPtr = govConfigPtr;
+    
+    return true;
+}
+
+
+/*
+ *  Stops DFS governor (clock stays at current operating point)
+ */
+extern void OSC_StopGovernor(void)
+{
+    gov.configPtr = NULL;
+}
+
+
+/*
+ *  Marks start of idle time (called from main loop before it idles)
+ */
+extern void OSC_GovIdleBegin(void)
+{
+    gov.idleStart = _CP0_GET_COUNT();
+}
+
+
+/*
+ *  Marks end of idle time (called from main loop when work is pending again)
+ */
+extern void OSC_GovIdleEnd(void)
+{
+    gov.idleCount += _CP0_GET_COUNT() - gov.idleStart;
+}
+
+
+/*
+ *  Evaluates load of elapsed window and steps one operating point up or down
+ *  (called from main loop outside of idle time)
+ *  Returns true if clock was changed
+ */
+extern bool OSC_GovUpdate(void)
+{
+    const OscGovConfig_t *configPtr = gov.configPtr;
+    
+    if( configPtr == NULL )
+    {
+        return false;
+    }
+    
+    uint32_t elapsed = _CP0_GET_COUNT() - gov.windowStart;
+    
+    /* Window not yet elapsed */
+    if( (elapsed == 0) || (elapsed < gov.windowCount) )
+    {
+        return false;
+    }
+    
+    uint32_t idle = (gov.idleCount < elapsed) ? gov.idleCount : elapsed;
+    gov.status.loadPct = 100 - (uint32_t)(((uint64_t)idle * 100) / elapsed);
+    
+    GovWindowStart(configPtr);
+    
+    /* Hysteresis in time (point is kept for a number of windows) */
+    if( gov.holdLeft > 0 )
+    {
+        gov.holdLeft--;
+        return false;
+    }
+    
+    uint32_t oppIdx = gov.status.oppIdx;
+    
+    /* Nearest point within latency budget above or below current one */
+    if( gov.status.loadPct > configPtr->upLoadPct )
+    {
+        for( uint32_t idx = oppIdx + 1; idx < configPtr->oppCount; idx++ )
+        {
+            if( !(gov.status.excludedMask & (1u << idx)) )
+            {
+                return GovSwitch(configPtr, idx);
+            }
+        }
+    }
+    else if( gov.status.loadPct < configPtr->downLoadPct )
+    {
+        for( uint32_t idx = oppIdx; idx > 0; idx-- )
+        {
+            if( !(gov.status.excludedMask & (1u << (idx - 1))) )
+            {
+                return GovSwitch(configPtr, idx - 1);
+            }
+        }
+    }
+    
+    return false;
+}
+
+
+/*
+ *  Returns current governor status
+ */
+extern void OSC_GetGovStatus(OscGovStatus_t *const statusPtr)
+{
+    *statusPtr = gov.status;
+}
+
+
+/*
+ *  Switches clock to operating point of governor
+ */
+static bool GovSwitch(const OscGovConfig_t *const configPtr, uint32_t oppIdx)
+{
+    if( !OSC_ConfigOsc(configPtr->oppTable[oppIdx].oscConfig) )
+    {
+        return false;
+    }
+    
+    gov.status.lastSwitchUs = OSC_GetSwitchTimeUs();
+    
+    gov.status.oppIdx = oppIdx;
+    gov.status.stepCount++;
+    gov.holdLeft = configPtr->holdWindows;
+    
+    /* Window length depends on SYSCLK */
+    GovWindowStart(configPtr);
+    
+    return true;
+}
+
+
+/*
+ *  Restarts load sampling window at current SYSCLK
+ */
+static void GovWindowStart(const OscGovConfig_t *const configPtr)
+{
+    gov.windowCount = (uint32_t)(((uint64_t)configPtr->windowUs * (OSC_GetSysFreq() / 2)) / 1000000);
+    gov.windowStart = _CP0_GET_COUNT();
+    gov.idleCount = 0;
+}
+
+
+/*
+ *  Returns time elapsed since *countPtr in microseconds at given SYSCLK (core
+ *  timer counts at SYSCLK/2) and restarts *countPtr
+ */
+static uint32_t SwitchPhaseUs(uint32_t *const countPtr, uint32_t sysFreq)
+{
+    uint32_t count = _CP0_GET_COUNT();
+    uint32_t elapsed = count - *countPtr;
+    
+    *countPtr = count;
+    
+    /* No valid core timer rate */
+    if( sysFreq < 2 )
+    {
+        return 0;
+    }
+    
+    return (uint32_t)(((uint64_t)elapsed * 1000000) / (sysFreq / 2));
+}
+
+
+/*
+ *  Executes pre-change or post-change hooks with current clock tree
+ */
+static void ClkHookNotify(bool isPostChange)
+{
+    OscClkState_t state;
+    OSC_GetClkState(&state);
+    
+    for( uint32_t idx = 0; idx < clkHookCount; idx++ )
+    {
+        void (*hook)(const OscClkState_t *const statePtr) = isPostChange ? clkHook[idx].postHook : clkHook[idx].preHook;
+        
+        if( hook != NULL )
+        {
+            hook(&state);
+        }
+    }
+}
+
+
+/*
+ *  Decodes OSCCON and DEVCFG2 into cached clock tree and bumps its generation
+ */
+static void ClkStateUpdate(void)
+{
+    OscPbDiv_t pbDiv = (oscSfr->OSCxCON.W & OSC_PBDIV_MASK) >> OSC_PBDIV_POS;
+    uint32_t sysFreq = ReadSysFreq();
+    
+    clkState.oscSource = (oscSfr->OSCxCON.W & OSC_COSC_MASK) >> OSC_COSC_POS;
+    clkState.sysFreq = sysFreq;
+    clkState.pbFreq = sysFreq / (1 << pbDiv);
+    clkState.cyclesPerUs = sysFreq / 1000000;
+    
+    /* Generation 0 is reserved for not yet decoded clock tree */
+    uint32_t generation = clkState.generation + 1;
+    if( generation == 0 )
+    {
+        generation = 1;
+    }
+    
+    clkState.generation = generation;
+}
+
+
+/*  
+ *  Returns the system clock frequency (SYSCLK) decoded from registers
+ */
+static uint32_t ReadSysFreq(void)
 {
     uint32_t sysFreq;
     
     /* Read existing settings from OSCCON and DEVCFG2 */
     OscClkSource_t oscSource = (oscSfr->OSCxCON.W & OSC_COSC_MASK) >> OSC_COSC_POS;
     OscPllOutDiv_t pllOutDiv = (oscSfr->OSCxCON.W & OSC_PLLODIV_MASK) >> OSC_PLLODIV_POS;
-    CfgPllInDiv_t pllInDiv = (cfgSfr->DEVxCFG2.W & CFG_FPLLIDIV_MASK) >> CFG_FPLLIDIV_POS;
     OscPllMult_t pllMult = (oscSfr->OSCxCON.W & OSC_PLLMULT_MASK) >> OSC_PLLMULT_POS;
     OscFrcDiv_t frcDiv = (oscSfr->OSCxCON.W & OSC_FRCDIV_MASK) >> OSC_FRCDIV_POS;
             
     /* Internal fast RC oscillator or primary oscillator (XT, HS or EC) with PLL */
     if( (oscSource == OSC_COSC_FRCPLL) || (oscSource == OSC_COSC_POSCPLL) )
     {
-        uint32_t inDiv;
-        
-        /* PLL Input Division setting in DEVCFG2 register */
-        if( pllInDiv == CFG_FPLLIDIV_12 )
-        {
-            inDiv = 12;
-        }
-        else if( pllInDiv == CFG_FPLLIDIV_10 )
-        {
-            inDiv = 10;
-        }
-        else
-        {
-            inDiv = pllInDiv + 1;
-        }
+        uint32_t inDiv = GetPllInDiv();
         
         uint32_t mult;
         
@@ -221,7 +724,7 @@ extern uint32_t OSC_GetSysFreq(void)
         /* External POSC source */
         else
         {
-            sysFreq = (uint32_t)((poscFreq * mult) / (inDiv * outDiv));
+            sysFreq = (uint32_t)(((uint64_t)OSC_XTAL_FREQ * mult) / (inDiv * outDiv));
         }
     }
     /* Primary oscillator (XT, HS or EC) */
@@ -272,312 +775,116 @@ extern uint32_t OSC_GetSysFreq(void)
 
 
 /*
- *  Returns the frequency of the peripheral bus (PBCLK)
- */
-extern uint32_t OSC_GetPbFreq(void)
-{
-    OscPbDiv_t pbDiv = (oscSfr->OSCxCON.W & OSC_PBDIV_MASK) >> OSC_PBDIV_POS;
-    
-    uint32_t sysFreq = OSC_GetSysFreq();
-    
-    return (uint32_t)(sysFreq / (1 << pbDiv));
-}
-
-
-/*
- *  Returns PLLOMULT and PLLDIV based on PLL multiplication factor requested
+ *  Returns PLL input division factor (FPLLIDIV in DEVCFG2 register)
  */
-static uint32_t GetPllMultDiv(float pllFactor)
+static uint32_t GetPllInDiv(void)
 {
-    /* NOTE: pllFactor = newFreq / currentFreq = (1 / FPLLIDIV) * (PLLMULT / PLLDIV) */
-    
     CfgPllInDiv_t pllInDiv = (cfgSfr->DEVxCFG2.W & CFG_FPLLIDIV_MASK) >> CFG_FPLLIDIV_POS;
     
-    uint8_t pllDiv;
-    /* PLL Input Division setting in DEVCFG2 register */
     if( pllInDiv == CFG_FPLLIDIV_12 )
     {
-        pllDiv = 12;
+        return 12;
     }
     else if( pllInDiv == CFG_FPLLIDIV_10 )
     {
-        pllDiv = 10;
+        return 10;
     }
     else
     {
-        pllDiv = (uint8_t)pllInDiv + 1;
+        return (uint32_t)pllInDiv + 1;
     }
+}
+
+
+/*
+ *  Returns PLLMULT and PLLODIV bit-field values for PLL output frequency
+ *  closest to requested one (lower one on a tie) with given PLL input divider
+ */
+static uint32_t GetPllMultDiv(uint32_t inFreq, uint32_t inDiv, uint32_t outFreq)
+{
+    /* NOTE: PLLMULT / PLLODIV = (outFreq * FPLLIDIV) / inFreq, therefore
+     * ratio mult/div is compared to target as mult * inFreq vs. target * div */
     
-    /* PLLMULT / PLLDIV = pllFactor * FPLLIDIV  */
-    float pllMultDiv = pllFactor * pllDiv;
+    uint64_t target = (uint64_t)outFreq * inDiv;
     
-    uint32_t retVal = 0;
+    /* Binary search for first ratio not below target */
+    uint32_t low = 0;
+    uint32_t high = 64;
     
-    /* Min. output PLL factor is 15/256 */
-    if( pllMultDiv < 0.06 )
+    while( low < high )
     {
-        retVal = ((0 << 8) | 7);
-    }
-    /* Max. output PLL factor is 24/1 */
-    else if( pllMultDiv >= 24.0 )
-    {
-        retVal = ((7 << 8) | 0);
-    }
-    /* Other factors */
-    else
-    {
-        /* Operating with integers most of the time*/
-        uint32_t inputFactor = (uint32_t)(pllMultDiv * 1000000);    // 10^6 since float precision is 6 digits
-        
-        /* PLL output multiply and divide possible values */
-        uint32_t pllDiv[] = {1,2,4,8,16,32,64,256};
-        uint32_t pllMult[] = {15,16,17,18,19,20,21,24};
+        uint32_t mid = (low + high) / 2;
         
-        /* All possible factors inside LUT */
-        uint32_t pllLut[64] = {0};
-        
-        /* Create LUT - divide each multiplicand with each divisor */
-        for(uint8_t k = 0; k < 8; k++)
-        {
-            for(uint8_t l = 0; l < 8; l++)
-            {
-                /* Multiplicands indexed in order low to high, divisors vice versa */
-                pllLut[(k*8)+l] = (pllMult[l] * 1000000) / pllDiv[7-k];
-            }
-        }
-        
-        uint8_t i, j;
-        
-        /* Find two closest PLL factors to actual one */
-        for(i = 0; i < 8; i++)
-        {
-            for(j = 0; j < 8; j++)
-            {
-                if( pllLut[(i*8)+j] >= inputFactor )
-                {
-                    /* End both loops */
-                    goto endLoop;
-                }
-            }
-        }
-
-        endLoop:;
-
-        /* NOTE: This function searches for two divisors, since the closest is
-         * required to be found, which means it is possible to also have two
-         * divisors, but this is the case only when both multiplicands are
-         *  15 and 24 (e.g. if "input" is between 15/1 and 24/2) */
-        
-        uint32_t multVal[2], divdVal[2];    // Actual integer multiplicands and divisors
-        uint8_t divdIndx[2], multIndx[2];   // Indexes for actual multiplicands and divisors
-
-        bool isTwoMult;
-        
-        /* In case of two divisors */
-        if( j == 0 )
-        {
-            isTwoMult = true;
-            
-            multVal[0] = pllMult[7];
-            multVal[1] = pllMult[0];
-            divdVal[0] = pllDiv[7-i+1];
-            divdVal[1] = pllDiv[7-i];
-
-            multIndx[0] = 7;
-            multIndx[1] = 0;
-            divdIndx[0] = 7-i+1;
-            divdIndx[1] = 7-i;
-        }
-        /* Other cases with one divisors */
-        else
-        {
-            isTwoMult = false;
-            
-            multVal[0] = pllMult[j];
-            multVal[1] = pllMult[j];    // Non-valid multiplicand
-            divdVal[0] = pllDiv[7-i+1];
-            divdVal[1] = pllDiv[7-i];
-
-            multIndx[0] = j;
-            multIndx[1] = j;            // This one not valid
-            divdIndx[0] = 7-i+1;
-            divdIndx[1] = 7-i;
-        }
-
-        
-        float res[2];       // Stores two possible PLL factors
-        
-        /* Each multiplicand by each divisor */
-        if( isTwoMult )
-        {
-            res[0] = ((float)multVal[0]) / divdVal[0];
-            res[1] = ((float)multVal[1]) / divdVal[1];
-        }
-        /* One multiplicand by two divisors */
-        else
-        {
-            res[0] = ((float)multVal[0]) / divdVal[0];
-            res[1] = ((float)multVal[0]) / divdVal[1];
-        }
-
-
-        float absRes[2];    // Stores two possible absolute PLL factors
-        
-        /* Find absolute of both possible PLL factors and actual factor */
-        
-        absRes[0] = res[0] - pllMultDiv;
-        if(absRes[0] < 0)
-        {
-            absRes[0] *= (-1.0);
-        }
-        
-        absRes[1] = res[1] - pllMultDiv;
-        if(absRes[1] < 0)
+        if( ((uint64_t)pllRatio[mid].mult * inFreq) < (target * pllRatio[mid].div) )
         {
-            absRes[1] *= (-1.0);
-        }
-
-        /* Lesser value is the closest, therfore indexes bound to that PLL factor are returned */
-        if( absRes[0] <= absRes[1] )
-        {
-            retVal = (multIndx[0] << 8) | divdIndx[0];
+            low = mid + 1;
         }
         else
         {
-            retVal = (multIndx[1] << 8) | divdIndx[1];
+            high = mid;
         }
     }
     
-    /* HIGH BYTE for PLL MULT and LOW BYTE for PLL DIV indexes */
-    return retVal;
-}
-
-
-/*
- *  Returns FRCDIV base on requested FRC division factor
- */
-static uint32_t GetFrcDiv(float divFactor)
-{
-    uint32_t frcDiv[] = {1,2,4,8,16,32,64,256};
-
-    uint32_t retVal = 0;
+    uint32_t idx;
     
-    /* Min. output DIV factor is 1 */
-    if( divFactor <= 1.0 )
+    /* Target below min. or above max. ratio */
+    if( low == 0 )
     {
-        retVal = 1;
+        idx = 0;
     }
-    /* Max. output DIV factor is 256 */
-    else if( divFactor >= 256.0)
+    else if( low == 64 )
     {
-        retVal = 7;
+        idx = 63;
     }
-    /* Other factors */
+    /* Closer of two neighbouring ratios */
     else
     {
-        uint8_t i;
-        /* Find two closest DIV factors to actual one */
-        for(i = 0; i < 8; i++)
-        {
-            if( frcDiv[i] > divFactor )
-            {
-                break;
-            }
-        }
-
-        float absRes[2];
-
-        /* Find absolute of both possible DIV factors and actual factor */
-
-        absRes[0] = frcDiv[i] - divFactor;
-        if(absRes[0] < 0.0)
-        {
-            absRes[0] *= (-1.0);
-        }
-
-        absRes[1] = frcDiv[i-1] - divFactor;
-        if(absRes[1] < 0.0)
-        {
-            absRes[1] *= (-1.0);
-        }
-
-        float retVal = 0;
-
-        /* Lesser value is the closest, therfore index bound to that DIV factor are returned */
-        if( absRes[0] <= absRes[1] )
+        const OscPllRatio_t *upperPtr = &pllRatio[low];
+        const OscPllRatio_t *lowerPtr = &pllRatio[low - 1];
+        
+        /* Errors scaled by (div * inFreq), compared cross-multiplied */
+        uint64_t upperErr = ((uint64_t)upperPtr->mult * inFreq) - (target * upperPtr->div);
+        uint64_t lowerErr = (target * lowerPtr->div) - ((uint64_t)lowerPtr->mult * inFreq);
+        
+        if( (lowerErr * upperPtr->div) <= (upperErr * lowerPtr->div) )
         {
-            retVal = i;
+            idx = low - 1;
         }
         else
         {
-            retVal = i-1;
+            idx = low;
         }
     }
     
-    /* FRC DIV index */
-    return retVal;
+    /* HIGH BYTE for PLL MULT and LOW BYTE for PLL DIV bit-field values */
+    return (pllRatio[idx].multCode << 8) | pllRatio[idx].divCode;
 }
 
 
 /*
- *  Returns PBDIV for the requested PBCLK division factor
+ *  Returns bit-field value of division factor (from ascending table) for output
+ *  frequency closest to requested one (lower one on a tie)
  */
-static uint32_t GetPbDiv(float divFactor)
+static uint32_t GetNearestDiv(uint32_t inFreq, uint32_t outFreq, const uint16_t *divPtr, uint32_t divCount)
 {
-    uint32_t pbDiv[] = {1,2,4,8};
-
-    uint32_t retVal = 0;
+    uint32_t bestIdx = 0;
+    uint64_t bestErr = UINT64_MAX;
+    uint32_t bestDiv = 1;
     
-    /* Min. output DIV factor is 1 */
-    if( divFactor <= 1.0 )
-    {
-        retVal = 0;
-    }
-    /* Max. output DIV factor is 8 */
-    else if( divFactor >= 8.0)
-    {
-        retVal = 3;
-    }
-    /* Other factors */
-    else
+    for( uint32_t idx = 0; idx < divCount; idx++ )
     {
-        uint8_t i;
-        /* Find two closest DIV factors to actual one */
-        for(i = 0; i < 4; i++)
-        {
-            if( pbDiv[i] >= divFactor )
-            {
-                break;
-            }
-        }
-
-        float absRes[2];
-
-        /* Find absolute of both possible DIV factors and actual factor */
-
-        absRes[0] = pbDiv[i] - divFactor;
-        if(absRes[0] < 0.0)
-        {
-            absRes[0] *= (-1.0);
-        }
-
-        absRes[1] = pbDiv[i-1] - divFactor;
-        if(absRes[1] < 0.0)
-        {
-            absRes[1] *= (-1.0);
-        }
-
-        /* Lesser value is the closest, therfore index bound to that DIV factor are returned */
-        if( absRes[0] <= absRes[1] )
-        {
-            retVal = i;
-        }
-        else
+        /* Error scaled by division factor: |inFreq - outFreq * div| */
+        uint64_t scaledOut = (uint64_t)outFreq * divPtr[idx];
+        uint64_t err = (scaledOut > inFreq) ? (scaledOut - inFreq) : (inFreq - scaledOut);
+        
+        /* err / div <= bestErr / bestDiv */
+        if( (bestErr == UINT64_MAX) || ((err * bestDiv) <= (bestErr * divPtr[idx])) )
         {
-            retVal = i-1;
+            bestIdx = idx;
+            bestErr = err;
+            bestDiv = divPtr[idx];
         }
     }
     
-    /* PB DIV index */
-    return retVal;
-}
\ No newline at end of file
+    return bestIdx;
+}
@@ -28,6 +28,14 @@
 
 #define OSC_SYSCLK_MAX  50000000
 
+/** Max. number of clock change hooks (see OSC_AddClkHook()) **/
+#ifndef OSC_CLK_HOOK_COUNT
+#define OSC_CLK_HOOK_COUNT  4
+#endif
+
+/** Max. number of governor operating points **/
+#define OSC_GOV_OPP_MAX     32
+
 /******************************************************************************/
 /*----------------------------Enumeration Types-------------------------------*/
 /******************************************************************************/
@@ -94,6 +102,41 @@ typedef struct {
     uint32_t        pbFreq;
 } OscConfig_t;
 
+/* Cached clock tree (updated by OSC_ConfigOsc) */
+typedef struct {
+    OscClkSource_t  oscSource;
+    uint32_t        sysFreq;
+    uint32_t        pbFreq;
+    uint32_t        cyclesPerUs;    // SYSCLK cycles per microsecond
+    uint32_t        generation;     // Changes on every clock tree update
+} OscClkState_t;
+
+/* Governor operating point */
+typedef struct {
+    OscConfig_t     oscConfig;
+    uint32_t        switchTimeUs;       // Expected clock switch time to this point
+} OscOpp_t;
+
+/* Governor settings (must remain valid while governor is running) */
+typedef struct {
+    const OscOpp_t  *oppTable;          // Sorted by ascending SYSCLK
+    uint32_t        oppCount;
+    uint32_t        windowUs;           // Load sampling window
+    uint32_t        upLoadPct;          // Step up if load is above
+    uint32_t        downLoadPct;        // Step down if load is below (< upLoadPct)
+    uint32_t        holdWindows;        // Windows spent at point after a step
+    uint32_t        latencyBudgetUs;    // Max. clock switch time of a step
+} OscGovConfig_t;
+
+/* Governor status */
+typedef struct {
+    uint32_t        oppIdx;             // Current operating point
+    uint32_t        loadPct;            // Load of last window
+    uint32_t        stepCount;
+    uint32_t        lastSwitchUs;       // Measured time of last clock switch
+    uint32_t        excludedMask;       // Points with switchTimeUs over latency budget
+} OscGovStatus_t;
+
 /******************************************************************************/
 /*---------------------------- Function Prototypes----------------------------*/
 /******************************************************************************/
@@ -104,8 +147,22 @@ bool OSC_ConfigOsc(OscConfig_t oscConfig);
 /* Read clock value functions */
 uint32_t OSC_GetSysFreq(void);
 uint32_t OSC_GetPbFreq(void);
+void OSC_GetClkState(OscClkState_t *const statePtr);
+uint32_t OSC_GetClkGeneration(void);
+uint32_t OSC_GetSwitchTimeUs(void);
 INLINE OscClkSource_t OSC_GetClkSource(void);
 
+/* Clock change notification function */
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr));
+
+/* Dynamic frequency scaling governor functions */
+bool OSC_StartGovernor(const OscGovConfig_t *const govConfigPtr, uint32_t oppIdx);
+void OSC_StopGovernor(void);
+void OSC_GovIdleBegin(void);
+void OSC_GovIdleEnd(void);
+bool OSC_GovUpdate(void);
+void OSC_GetGovStatus(OscGovStatus_t *const statusPtr);
+
 /******************************************************************************/
 /*-----------------------------Function In-lines------------------------------*/
 /******************************************************************************/
@@ -207,7 +207,7 @@ void __ISR(CHANGE_NOTICE_VECTOR, CN_ISR_IPL) ISR_ChangeNotice(void)
     if( (icSfr->ICxIEC1.W & IC_CNAIE_MASK) && (icSfr->ICxIFS1.W & IC_CNAIF_MASK) )
     {   
         /* User-defined function */
-        Isr1HandlerPtr();
+        IC_PROFILE_CALL(IC_PROFILE_CNA, Isr1HandlerPtr());
         
         /* Clear persistent interrupt flag */
         dummy = PIOA_MODULE.PIOxPORT.W;
@@ -218,7 +218,7 @@ void __ISR(CHANGE_NOTICE_VECTOR, CN_ISR_IPL) ISR_ChangeNotice(void)
     if( (icSfr->ICxIEC1.W & IC_CNBIE_MASK) && (icSfr->ICxIFS1.W & IC_CNBIF_MASK) )
     {   
         /* User-defined function */
-        Isr2HandlerPtr();
+        IC_PROFILE_CALL(IC_PROFILE_CNB, Isr2HandlerPtr());
         
         /* Clear persistent interrupt flag */
         dummy = PIOB_MODULE.PIOxPORT.W;
@@ -1,50 +1,143 @@
 #include "Spi.h"
 
+/******************************************************************************/
+/*--------------------------Local Data Structures-----------------------------*/
+/******************************************************************************/
+
+/** Per-module transfer context (one for each SPI module) **/
+typedef struct SpiContext SpiContext_t;
+
+/** Frame-width-specialized FIFO fill/drain routines (index 0 normal, 1 dummy) **/
+typedef struct {
+    void (*fill[2])(SpiContext_t *const ctx, uint32_t size);
+    void (*drain[2])(SpiContext_t *const ctx, uint32_t size);
+    uint32_t    fifoDepth;              // Number of frames in TX/RX FIFO
+    uint32_t    frameSize;              // Number of bytes per frame in memory
+} SpiFifoOps_t;
+
+struct SpiContext {
+    /* SPI module served by this context */
+    SpiSfr_t *const     spiSfr;
+    
+    /* ISR TX and RX data variables (of current segment) */
+    volatile void      *txDataPtr;
+    volatile void      *rxDataPtr;
+    volatile uint32_t   txDataSize;
+    volatile uint32_t   rxDataSize;
+    volatile uint32_t   intrStatus;
+    
+    /* Remaining scatter-gather segments (TX and RX advance independently) */
+    const SpiSegment_t *txSegPtr;
+    const SpiSegment_t *rxSegPtr;
+    volatile uint32_t   txSegCount;
+    volatile uint32_t   rxSegCount;
+    
+    /* FIFO routines of configured frame width (NULL until configured) */
+    const SpiFifoOps_t *fifoOps;
+    
+    /* FIFO routines of current segment (normal or dummy write/read) */
+    void (*txFill)(SpiContext_t *const ctx, uint32_t size);
+    void (*rxDrain)(SpiContext_t *const ctx, uint32_t size);
+    
+    /* Audio streaming ping-pong halves (of user TX and RX buffers) */
+    volatile void      *txHalfPtr[2];
+    volatile void      *rxHalfPtr[2];
+    uint32_t            halfSize;
+    volatile uint32_t   txHalfCount;        // Halves loaded to TX FIFO (free running)
+    volatile uint32_t   rxHalfCount;        // Halves read from RX FIFO (free running)
+    volatile uint32_t   doneHalfCount;      // Halves reported to user (free running)
+    void (*isrHalfHandlerPtr)(uint32_t half);
+    
+    /* Audio streaming error counters (SPITUR and SPIROV events) */
+    volatile uint32_t   underrunCount;
+    volatile uint32_t   overrunCount;
+    
+    /* Slave RX ring buffer (NULL if not active), head written only by ISR
+     * and tail only by consumer (free running indices) */
+    volatile void      *ringPtr;
+    uint32_t            ringMask;
+    volatile uint32_t   ringHead;
+    volatile uint32_t   ringTail;
+    volatile uint32_t   ringOverrunCount;
+    
+    /* Handle of non-blocking transfer in progress (NULL if none) */
+    SpiXfer_t *volatile xferPtr;
+    
+    /* FIFO watermark streaming transfer in progress */
+    volatile bool       isStreaming;
+    
+    /* Requested SCK frequency of Master mode kept on clock change (0 if
+     * Slave mode) */
+    uint32_t            sckFreq;
+    
+    /* Slave Select pins selected for transfers, GPIO Slave Select pins of
+     * configured pin set and pins captured at the start of transfer */
+    volatile SpiSsState_t   ssState;
+    SpiSsState_t            ssMask;
+    volatile SpiSsState_t   ssActive;
+    
+    /* Interrupt enable and flag masks */
+    const struct {
+        uint32_t    spiTxIe;
+        uint32_t    spiTxIf;
+        uint32_t    spiRxIe;
+        uint32_t    spiRxIf;
+        uint32_t    spiEIe;
+        uint32_t    spiEIf;
+    } ic;
+    
+    /* Transaction queue (ring buffer, oldest job is being transferred) */
+    SpiJob_t            queue[SPI_QUEUE_SIZE];
+    volatile uint32_t   queueHead;
+    volatile uint32_t   queueTail;
+    volatile uint32_t   queueCount;
+    
+    /* Frame width (SPIxCON.MODE bits) and FIFO routines restored once queue
+     * drains (jobs may use other frame width) */
+    uint32_t            queueModeBits;
+    const SpiFifoOps_t *queueFifoOps;
+    
+    /* ISR function pointers */
+    void (*isrTxHandlerPtr)(SpiContext_t *const ctx);
+    void (*isrRxHandlerPtr)(SpiContext_t *const ctx);
+    void (*isrErrHandlerPtr)(SpiContext_t *const ctx);
+    void (*isrExtraHandlerPtr)(void);
+};
+
+
 /******************************************************************************/
 /*--------------------------Local Data Variables------------------------------*/
 /******************************************************************************/
 
-/** ISR TX and RX data variables **/
-static volatile void *txDataPtr;
-static volatile void *rxDataPtr;
-static volatile uint8_t txDataSize;
-static volatile uint32_t intrStatus;
+/** Transfer context of SPI1 (index 0) and SPI2 (index 1) **/
+static SpiContext_t spiCtx[] = {
+    {
+        .spiSfr = &SPI1_MODULE,
+        .ic = { IC_SPI1TXIE_MASK, IC_SPI1TXIF_MASK, IC_SPI1RXIE_MASK, IC_SPI1RXIF_MASK, IC_SPI1EIE_MASK, IC_SPI1EIF_MASK }
+    },
+    {
+        .spiSfr = &SPI2_MODULE,
+        .ic = { IC_SPI2TXIE_MASK, IC_SPI2TXIF_MASK, IC_SPI2RXIE_MASK, IC_SPI2RXIF_MASK, IC_SPI2EIE_MASK, IC_SPI2EIF_MASK }
+    }
+};
 
 /** Dummy write/read variables **/
 static volatile uint32_t dummyTxData = 0;
 static volatile uint32_t dummyRxData = 0;
-static volatile bool isDummyWrite = false;
-static volatile bool isDummyRead = false;
 
 /** Pointers for PIO access for Slave Select control **/
 static PioSfr_t *const pioSfrA = &PIOA_MODULE;
 static PioSfr_t *const pioSfrB = &PIOB_MODULE;
 
-/** Pointers for IC and SPI access within ISR **/
+/** Pointer for IC access within ISR **/
 static IcSfr_t *const icSfr = &IC_MODULE;
-static SpiSfr_t *isrSpiSfr;
-
-/** ISR function pointers **/
-static void (*isrTxHandlerPtr)(void);
-static void (*isrRxHandlerPtr)(void);
-static void (*isrExtraHandlerPtr)(void);
-
-/** Indicates current Slave Select active pins during SPI operation **/
-static volatile SpiSsState_t ssState;
-static volatile SpiSsState_t ssMask;
-
 
-/******************************************************************************/
-/*--------------------------Local Data Structures-----------------------------*/
-/******************************************************************************/
+/** Pointers for DMA channel access (RX and TX channel of DMA-based transfer) **/
+static DmaChSfr_t *const dmaRxSfr = &DMA_CH0_MODULE;
+static DmaChSfr_t *const dmaTxSfr = &DMA_CH1_MODULE;
 
-/** Interrupt enable and flag masks **/
-static volatile struct {
-    uint32_t    spiTxIe;
-    uint32_t    spiTxIf;
-    uint32_t    spiRxIe;
-    uint32_t    spiRxIf;
-} ic;
+/** Context served by DMA channels (NULL when DMA channels are free) **/
+static SpiContext_t *volatile dmaCtx = NULL;
 
 
 /******************************************************************************/
@@ -52,22 +145,69 @@ static volatile struct {
 /******************************************************************************/
 
 /** Non-ISR sub-function **/
-static INLINE void IsrHandlerPtrConfig(IsrSpiMode_t isrMode);
-static INLINE bool SpiInterruptMaskSet(SpiSfr_t * spiSfr);
+static INLINE void IsrHandlerPtrConfig(SpiContext_t *const ctx, IsrSpiMode_t isrMode);
+static INLINE uint32_t SpiBaudRateGet(uint32_t sckFreq);
+static INLINE uint32_t SpiSckFreqKeep(uint32_t sckFreq, uint32_t brgWord);
+static bool SpiStandardModeApply(SpiSfr_t *const spiSfr, SpiPin_t pinSelect, uint32_t conWord, uint32_t brgWord, uint32_t sckFreq);
+static INLINE void SpiIcConfig(SpiSfr_t *const spiSfr);
+static void SpiStreamModeApply(SpiContext_t *const ctx, SpiPin_t pinSelect, bool isMasterEnabled, uint32_t sckFreq);
+static INLINE bool SpiIsClkContinuous(SpiSfr_t *const spiSfr);
+static INLINE SpiContext_t *SpiContextGet(SpiSfr_t *const spiSfr);
+static INLINE void DmaChannelReset(DmaChSfr_t *const dmaSfr);
+static bool SpiMasterWriteStart(SpiContext_t *const ctx);
+static bool SpiMasterReadWritePoll(SpiContext_t *const ctx);
+static INLINE void SpiPacketSet(SpiContext_t *const ctx, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize);
+static INLINE bool SpiPacketSetSg(SpiContext_t *const ctx, const SpiSegment_t *segPtr, uint32_t segCount);
+static INLINE bool SpiMasterCheck(SpiContext_t *const ctx);
+static INLINE void SpiMasterWriteLoad(SpiContext_t *const ctx);
+static void SpiJobStart(SpiContext_t *const ctx);
+static void SpiFrameModeSet(SpiContext_t *const ctx, uint32_t modeBits, const SpiFifoOps_t *fifoOps);
+static void SpiClkPreHook(const OscClkState_t *const statePtr);
+static void SpiClkPostHook(const OscClkState_t *const statePtr);
 
 /** ISR and non-ISR sub-functions **/
-static INLINE void SpiWrite8(void);
-static INLINE void SpiWrite16(void);
-static INLINE void SpiWrite32(void);
-static INLINE void SpiRead8(void);
-static INLINE void SpiRead16(void);
-static INLINE void SpiRead32(void);
+static INLINE void SpiWrite(SpiContext_t *const ctx);
+static INLINE void SpiWriteUpTo(SpiContext_t *const ctx, uint32_t fifoFree);
+static INLINE void SpiRead(SpiContext_t *const ctx);
+static void SpiFill8(SpiContext_t *const ctx, uint32_t size);
+static void SpiFill16(SpiContext_t *const ctx, uint32_t size);
+static void SpiFill32(SpiContext_t *const ctx, uint32_t size);
+static void SpiFillDummy(SpiContext_t *const ctx, uint32_t size);
+static void SpiDrain8(SpiContext_t *const ctx, uint32_t size);
+static void SpiDrain16(SpiContext_t *const ctx, uint32_t size);
+static void SpiDrain32(SpiContext_t *const ctx, uint32_t size);
+static void SpiDrainDummy(SpiContext_t *const ctx, uint32_t size);
+static INLINE bool SpiTxSegmentNext(SpiContext_t *const ctx);
+static INLINE bool SpiRxSegmentNext(SpiContext_t *const ctx);
+static INLINE void SpiSsAssert(SpiContext_t *const ctx);
+static INLINE void SpiSsRelease(SpiContext_t *const ctx);
+static INLINE void SpiSsAssertPin(SpiContext_t *const ctx, const uint32_t pinCode);
 
 /** ISR handlers **/
-static void ISR_SpiTxHandler_MasterWrite(void);
-static void ISR_SpiRxHandler_MasterWrite(void);
-static void ISR_SpiTxHandler_MasterWrite2(void);
-static void ISR_SpiRxHandler_MasterWrite2(void);
+static void ISR_SpiTxHandler_MasterWrite(SpiContext_t *const ctx);
+static void ISR_SpiRxHandler_MasterWrite(SpiContext_t *const ctx);
+static void ISR_SpiTxHandler_MasterWrite2(SpiContext_t *const ctx);
+static void ISR_SpiRxHandler_MasterWrite2(SpiContext_t *const ctx);
+static void ISR_SpiTxHandler_Queue(SpiContext_t *const ctx);
+static void ISR_SpiHandler_Stream(SpiContext_t *const ctx);
+static void ISR_SpiTxHandler_Async(SpiContext_t *const ctx);
+static void ISR_SpiTxHandler_Audio(SpiContext_t *const ctx);
+static void ISR_SpiErrHandler_Audio(SpiContext_t *const ctx);
+static void ISR_SpiRxHandler_SlaveRing(SpiContext_t *const ctx);
+static void ISR_SpiTxHandler_Dma(SpiContext_t *const ctx);
+static void ISR_SpiDmaHandler_MasterWrite(void);
+
+
+/******************************************************************************/
+/*----------------------------Local Constant Data-----------------------------*/
+/******************************************************************************/
+
+/** FIFO routines of each frame width (indexed by "SpiFrameWidth_t") **/
+static const SpiFifoOps_t spiFifoOps[] = {
+    [SPI_WIDTH_8BIT]  = { { SpiFill8,  SpiFillDummy }, { SpiDrain8,  SpiDrainDummy }, 16, 1 },
+    [SPI_WIDTH_16BIT] = { { SpiFill16, SpiFillDummy }, { SpiDrain16, SpiDrainDummy },  8, 2 },
+    [SPI_WIDTH_32BIT] = { { SpiFill32, SpiFillDummy }, { SpiDrain32, SpiDrainDummy },  4, 4 }
+};
 
 
 /******************************************************************************/
@@ -80,8 +220,63 @@ static void ISR_SpiRxHandler_MasterWrite2(void);
  */
 extern bool SPI_ConfigStandardModeSfr(SpiSfr_t *const spiSfr, SpiStandardConfig_t spiConfig)
 {
-    /* SPI base address check */
-    if( !(spiSfr == &SPI1_MODULE) && !(spiSfr == &SPI2_MODULE) )
+    /* Frame width range check */
+    if( spiConfig.frameWidth > SPI_WIDTH_32BIT )
+    {
+        return false;
+    }
+    
+    /* SPIxCON and SPIxBRG values (baud rate set in SPI Master mode only) */
+    uint32_t conWord = SPI_CON_VALUE(spiConfig.isMasterEnabled, spiConfig.frameWidth, spiConfig.clkMode);
+    uint32_t brgWord = spiConfig.isMasterEnabled ? SpiBaudRateGet(spiConfig.sckFreq) : 0;
+    
+    return SpiStandardModeApply(spiSfr, spiConfig.pinSelect, conWord, brgWord, spiConfig.sckFreq);
+}
+
+
+/*
+ *  Configures SPI module in Standard mode with SFR values computed at compile
+ *  time (see SPI_STATIC_CONFIG() macro), no baud rate math is done at runtime
+ *  Returns false, if any input restriction is triggered
+ */
+extern bool SPI_ConfigStaticModeSfr(SpiSfr_t *const spiSfr, SpiPin_t pinSelect, const SpiStaticConfig_t *const staticConfig)
+{
+    if( staticConfig == NULL )
+    {
+        return false;
+    }
+    
+    return SpiStandardModeApply(spiSfr, pinSelect, staticConfig->conWord, staticConfig->brgWord, staticConfig->sckFreq);
+}
+
+
+/*
+ *  Configures SPI module in Audio Protocol Interface mode (I2S, left/right
+ *  justified or PCM/DSP) with passed structure settings
+ *  Returns false, if any input restriction is triggered
+ */
+extern bool SPI_ConfigAudioModeSfr(SpiSfr_t *const spiSfr, SpiAudioConfig_t audioConfig)
+{
+    /* Context of given SPI module (also an SPI base address check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Data width and protocol range check */
+    if( (audioConfig.dataWidth > SPI_WIDTH_24DATA_32CH) || (audioConfig.protocolMode > SPI_AUDMOD_PMC_DSP) )
+    {
+        return false;
+    }
+    
+    /* If value not assigned to pin setting the pin code is zero */
+    bool isSdiEnabled = audioConfig.pinSelect.sdiPin ? true : false;
+    bool isSdoEnabled = audioConfig.pinSelect.sdoPin ? true : false;
+    
+    /* Either SDI or SDO must be enabled, frame sync (SS1) pin is mandatory */
+    if( (!isSdiEnabled && !isSdoEnabled) || !audioConfig.pinSelect.ss1Pin )
     {
         return false;
     }
@@ -102,11 +297,6 @@ extern bool SPI_ConfigStandardModeSfr(SpiSfr_t *const spiSfr, SpiStandardConfig_
     spiSfr->SPIxCON2.CLR = 0xFFFFFFFF;
     spiSfr->SPIxSTAT.CLR = 0xFFFFFFFF;
     
-    /* If value not assigned to pin setting the pin code is zero */
-    bool isSdiEnabled = spiConfig.pinSelect.sdiPin ? true : false;
-    bool isSdoEnabled = spiConfig.pinSelect.sdoPin ? true : false;
-    bool isSsEnabled  = spiConfig.pinSelect.ss1Pin ? true : false;
-    
     /* If pin not used, disable it in hardware */
     if( !isSdiEnabled )
     {
@@ -116,153 +306,107 @@ extern bool SPI_ConfigStandardModeSfr(SpiSfr_t *const spiSfr, SpiStandardConfig_
     {
         spiSfr->SPIxCON.SET = SPI_DISSDO_MASK;
     }
-    /* If Slave mode */
-    if( !spiConfig.isMasterEnabled )
-    {
-        if( isSsEnabled )
-        {
-            spiSfr->SPIxCON.SET = SPI_SSEN_MASK;
-        }
-        /* SS pin selection wasn't provided by user */
-        else
-        {
-            return false;
-        }
-    }
     
-    /* Other user controllable settings */
-    spiSfr->SPIxCON.SET = ((spiConfig.clkMode & 0x01) << SPI_CKE_POS)  |
-                          ((spiConfig.clkMode & 0x02) << SPI_CKP_POS)  |
-                          (spiConfig.isMasterEnabled << SPI_MSTEN_POS) |
-                          (spiConfig.frameWidth << SPI_MODE_POS);
+    /* Other user controllable settings ("MODE" selects audio data/channel width) */
+    spiSfr->SPIxCON.SET = ((audioConfig.clkMode & 0x01) << SPI_CKE_POS)         |
+                          (((audioConfig.clkMode >> 1) & 0x01) << SPI_CKP_POS) |
+                          (audioConfig.isMasterEnabled << SPI_MSTEN_POS)        |
+                          (audioConfig.dataWidth << SPI_MODE_POS);
+    spiSfr->SPIxCON2.SET = (audioConfig.protocolMode << SPI_AUDMOD_POS)   |
+                           (audioConfig.isMonoEnabled << SPI_AUDMONO_POS) |
+                           SPI_AUDEN_MASK;
     /* Fixed setting */
     spiSfr->SPIxCON.SET = (0x01 << SPI_ENHBUF_POS);
     
-    /* Indirect access of "ssState" structure members */
-    uint32_t *ssMembPtr = (uint32_t *)&ssState.pioA;
-    const uint8_t ssMembCount = sizeof(SpiSsState_t) / sizeof(uint32_t);
-    uint8_t ssModuleOffset = 0;
-    uint8_t ssPinPos = 0;
-    
-    /* Reset SS mask */
-    for(uint8_t j = 0; j < ssMembCount; j++, ssMembPtr++)
+    /* Bind FIFO routines of selected channel width */
+    if( audioConfig.dataWidth == SPI_WIDTH_16DATA_16CH )
     {
-        *ssMembPtr = 0;
+        ctx->fifoOps = &spiFifoOps[SPI_WIDTH_16BIT];
     }
-    
-    /* Configure PPS and PIO */
-    if( isSdiEnabled || isSdoEnabled )
+    else
     {
-        /* Indirect access of structure members */
-        const uint32_t *membPtr = (uint32_t *)&spiConfig.pinSelect;
-        const uint8_t membCount = sizeof(SpiPin_t) / sizeof(uint32_t);
-
-        /* PIO configuration of each valid member */
-        for(uint8_t i = 0; i < membCount; i++, membPtr++)
-        {
-            /* Configure Peripheral Pin Select register (non-GPIO) */
-            PIO_ConfigPpsSfr(*membPtr);
+        ctx->fifoOps = &spiFifoOps[SPI_WIDTH_32BIT];
+    }
+    
+    /* Pins, baud rate and interrupt sources, module enabled */
+    SpiStreamModeApply(ctx, audioConfig.pinSelect, audioConfig.isMasterEnabled, audioConfig.sckFreq);
+    
+    return true;
+}
 
-            /* GPIO SS pin digital output pin */
-            if( spiConfig.isMasterEnabled && (membPtr >= &spiConfig.pinSelect.ss1Pin) )
-            {
-                PIO_SetPin(*membPtr);
-                PIO_ConfigGpioPin(*membPtr, PIO_TYPE_DIGITAL, PIO_DIR_OUTPUT);
-                
-                /* If valid GPIO pin, modify SS mask */
-                if( *membPtr & 0xFFFF )
-                {   
-                    ssModuleOffset = (*membPtr >> 28);
-                    ssPinPos = PIO_ReadPinPosition(*membPtr);
 
-                    /* Set a bit in appropriate member */
-                    *(ssMembPtr + ssModuleOffset) |= (1 << ssPinPos);
-                }
-            }
-            /* SDI, SDO (or SSI when in Slave mode) PPS pin */
-            else
-            {
-                PIO_ConfigPpsPin(*membPtr, PIO_TYPE_DIGITAL);
-            }
-        }
-        
-        /* SCK digital pin */
-        if( spiSfr == &SPI1_MODULE )
-        {
-            PIO_ConfigGpioPinType(GPIO_RPB14, PIO_TYPE_DIGITAL);
-        }
-        else
-        {
-            PIO_ConfigGpioPinType(GPIO_RPB15, PIO_TYPE_DIGITAL);
-        }
-    }
-    /* Either SDI or SDO must be enabled for any SPI operation */
-    else
+/*
+ *  Configures SPI module in Framed mode (PCM/TDM streams, frame sync pulse on
+ *  SS1 pin) with passed structure settings
+ *  Returns false, if any input restriction is triggered
+ */
+extern bool SPI_ConfigFramedModeSfr(SpiSfr_t *const spiSfr, SpiFramedConfig_t framedConfig)
+{
+    /* Context of given SPI module (also an SPI base address check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
     {
         return false;
     }
     
-    /* Set baud rate in SPI Master mode */
-    if( spiConfig.isMasterEnabled )
+    /* Frame width and frame sync count range check */
+    if( (framedConfig.frameWidth > SPI_WIDTH_32BIT) || (framedConfig.syncCount > SPI_FRMCNT_32) )
     {
-        /* Peripheral bus frequency */
-        uint32_t pbFreq = OSC_GetPbFreq();
-        
-        uint32_t baudRate;
-        
-        /* Max. F_sck is PBCLK/2 */
-        if( spiConfig.sckFreq >= (pbFreq/2) )
-        {
-            baudRate = 0;
-        }
-        else
-        {
-            baudRate = (uint32_t)( (pbFreq / (2 * spiConfig.sckFreq)) - 1 );
-        }
-        
-        /* Max. baud rate value is 511 (slowest setting) */
-        if( baudRate > 511 )
-        {
-            baudRate = 511;
-        }
-        
-        spiSfr->SPIxBRG.SET = baudRate;
+        return false;
     }
     
-    /* Dummy buffer read */
-    SPI_DummyRead(spiSfr);
+    /* If value not assigned to pin setting the pin code is zero */
+    bool isSdiEnabled = framedConfig.pinSelect.sdiPin ? true : false;
+    bool isSdoEnabled = framedConfig.pinSelect.sdoPin ? true : false;
     
-    /* Multi-vector interrupt mode */
-    icSfr->ICxINTCON.SET = IC_MVEC_MASK;
-
-    /* Interrupt sources for SPI1 */
-    if( spiSfr == &SPI1_MODULE )
+    /* Either SDI or SDO must be enabled, frame sync (SS1) pin is mandatory */
+    if( (!isSdiEnabled && !isSdoEnabled) || !framedConfig.pinSelect.ss1Pin )
     {
-        icSfr->ICxIFS1.CLR = (IC_SPI1EIF_MASK | IC_SPI1RXIF_MASK | IC_SPI1TXIF_MASK);                   // Clear flags
-        icSfr->ICxIPC7.CLR = (IC_SPI1IP_MASK | IC_SPI1IS_MASK);                                         // Clear (sub)priority
-        icSfr->ICxIPC7.SET = ( (SPI1_ICX_IPL << IC_SPI1IP_POS) | (SPI1_ICX_ISL << IC_SPI1IS_POS) );     // Set (sub)priority
-        icSfr->ICxIEC1.CLR = (IC_SPI1EIE_MASK | IC_SPI1RXIE_MASK | IC_SPI1TXIE_MASK);                   // Disable sources
+        return false;
     }
-    /* Interrupt sources for SPI2 */
-    else if ( spiSfr == &SPI2_MODULE )
+    
+    /* Not safe to be configured while operating */
+    if( SPI_IsSpiBusy(spiSfr) )
     {
-        icSfr->ICxIFS1.CLR = (IC_SPI2EIF_MASK | IC_SPI2RXIF_MASK | IC_SPI2TXIF_MASK);
-        icSfr->ICxIPC9.CLR = (IC_SPI2IP_MASK | IC_SPI2IS_MASK);
-        icSfr->ICxIPC9.SET = ( (SPI2_ICX_IPL << IC_SPI2IP_POS) | (SPI2_ICX_ISL << IC_SPI2IS_POS) );
-        icSfr->ICxIEC1.CLR = (IC_SPI2EIE_MASK | IC_SPI2RXIE_MASK | IC_SPI2TXIE_MASK);
+        return false;
     }
-    /* This is also SPI base address check */
-    else
+    
+    /* Disable the module */
+    spiSfr->SPIxCON.CLR = SPI_ON_MASK;
+    asm("nop");
+    
+    /* Clear all SPIx SFRs */
+    spiSfr->SPIxCON.CLR = 0xFFFFFFFF;
+    spiSfr->SPIxBRG.CLR = 0xFFFFFFFF;
+    spiSfr->SPIxCON2.CLR = 0xFFFFFFFF;
+    spiSfr->SPIxSTAT.CLR = 0xFFFFFFFF;
+    
+    /* If pin not used, disable it in hardware */
+    if( !isSdiEnabled )
     {
-        return false;
+        spiSfr->SPIxCON.SET = SPI_DISSDI_MASK;
+    }
+    if( !isSdoEnabled )
+    {
+        spiSfr->SPIxCON.SET = SPI_DISSDO_MASK;
     }
     
-    /* Clear the overflow flag */
-    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    /* Standard mode settings (CKE is not used in Framed mode and must be
+     * cleared) and frame sync pulse settings */
+    spiSfr->SPIxCON.SET = (SPI_CON_VALUE(framedConfig.isMasterEnabled, framedConfig.frameWidth, framedConfig.clkMode) & ~SPI_CKE_MASK) |
+                          (framedConfig.isSyncInput << SPI_FRMSYNC_POS)      |
+                          (framedConfig.isSyncActiveHigh << SPI_FRMPOL_POS)  |
+                          (framedConfig.isSyncFrameWide << SPI_FRMSYPW_POS)  |
+                          (framedConfig.isSyncCoincident << SPI_SPIFE_POS)   |
+                          (framedConfig.syncCount << SPI_FRMCNT_POS)         |
+                          SPI_FRMEN_MASK;
     
-    /* Enable the module */
-    spiSfr->SPIxCON.SET = SPI_ON_MASK;
-    asm("nop");
+    /* Bind FIFO routines of selected frame width */
+    ctx->fifoOps = &spiFifoOps[framedConfig.frameWidth];
+    
+    /* Pins, baud rate and interrupt sources, module enabled */
+    SpiStreamModeApply(ctx, framedConfig.pinSelect, framedConfig.isMasterEnabled, framedConfig.sckFreq);
     
     return true;
 }
@@ -270,20 +414,29 @@ extern bool SPI_ConfigStandardModeSfr(SpiSfr_t *const spiSfr, SpiStandardConfig_
 
 /*
  *  Modifies status of Slave Select devices to be activated during communication
- *  Returns "true" if proper pin code was passed to a function
+ *  of given SPI module
+ *  Returns "true" if proper module and Slave Select pin of its configured pin
+ *  set were passed to a function
  */
-extern bool SPI_EnableSsState(const uint32_t pinCode)
+extern bool SPI_EnableSsState(SpiSfr_t *const spiSfr, const uint32_t pinCode)
 {
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     PinInfo_t pinInfo = PIO_ReadPinCode(pinCode);
     
-    /* Each bit corresponds to each Slave current status (1 - active, 0 - not active) */
-    if( pinInfo.pinMod == &PIOA_MODULE )
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Each bit corresponds to each Slave current status (1 - active, 0 - not active),
+     * only Slave Select pins of configured pin set */
+    if( (pinInfo.pinMod == &PIOA_MODULE) && (ctx->ssMask.pioA & (1 << pinInfo.pinPos)) )
     {
-        ssState.pioA |= (1 << pinInfo.pinPos);
+        ctx->ssState.pioA |= (1 << pinInfo.pinPos);
     }
-    else if( pinInfo.pinMod == &PIOB_MODULE )
+    else if( (pinInfo.pinMod == &PIOB_MODULE) && (ctx->ssMask.pioB & (1 << pinInfo.pinPos)) )
     {
-        ssState.pioB |= (1 << pinInfo.pinPos);
+        ctx->ssState.pioB |= (1 << pinInfo.pinPos);
     }
     /* Other non-available module codes */
     else
@@ -297,20 +450,27 @@ extern bool SPI_EnableSsState(const uint32_t pinCode)
 
 /*
  *  Modifies status of Slave Select devices to be activated during transmission
- *  Returns "true" if proper pin code was passed to a function
+ *  of given SPI module
+ *  Returns "true" if proper module and pin code were passed to a function
  */
-extern bool SPI_DisableSsState(const uint32_t pinCode)
+extern bool SPI_DisableSsState(SpiSfr_t *const spiSfr, const uint32_t pinCode)
 {
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     PinInfo_t pinInfo = PIO_ReadPinCode(pinCode);
     
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
     /* Each bit corresponds to each Slave current status (1 - active, 0 - not active) */
     if( pinInfo.pinMod == &PIOA_MODULE )
     {
-        ssState.pioA &= ~(1 << pinInfo.pinPos);
+        ctx->ssState.pioA &= ~(1 << pinInfo.pinPos);
     }
     else if( pinInfo.pinMod == &PIOB_MODULE )
     {
-        ssState.pioB &= ~(1 << pinInfo.pinPos);
+        ctx->ssState.pioB &= ~(1 << pinInfo.pinPos);
     }
     /* Other non-available module codes */
     else
@@ -323,23 +483,42 @@ extern bool SPI_DisableSsState(const uint32_t pinCode)
 
 
 /*
- *  Gets status of Slave Select devices to be activated during transmission
+ *  Gets status of Slave Select devices to be activated during transmission of
+ *  given SPI module (no devices if module is not valid)
  */
-extern SpiSsState_t SPI_GetSsState(void)
+extern SpiSsState_t SPI_GetSsState(SpiSfr_t *const spiSfr)
 {
-    return ssState;
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    SpiSsState_t state = {0};
+    
+    if( ctx != NULL )
+    {
+        state.pioA = ctx->ssState.pioA;
+        state.pioB = ctx->ssState.pioB;
+    }
+    
+    return state;
 }
 
 
 /*
- *  Sets status of Slave Select devices to be activated during transmission
+ *  Sets status of Slave Select devices to be activated during transmission of
+ *  given SPI module (only Slave Select pins of its configured pin set)
+ *  Returns false if module is not valid
  */
-extern void SPI_SetSsState(const SpiSsState_t input)
+extern bool SPI_SetSsState(SpiSfr_t *const spiSfr, const SpiSsState_t input)
 {
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
     /* Indirect access of "SpiSsState_t" structure members */
     const uint32_t *inputMembPtr = (uint32_t *)&input.pioA;
-    const uint32_t *maskMembPtr = (uint32_t *)&ssMask.pioA;
-    uint32_t *stateMembPtr = (uint32_t *)&ssState.pioA;
+    const uint32_t *maskMembPtr = (uint32_t *)&ctx->ssMask.pioA;
+    volatile uint32_t *stateMembPtr = (volatile uint32_t *)&ctx->ssState.pioA;
     uint8_t membCount = sizeof(SpiSsState_t) / sizeof(uint32_t);
     
     /* Copy input SS state into "ssState", don't copy any non-SS pin bits */
@@ -351,6 +530,8 @@ extern void SPI_SetSsState(const SpiSsState_t input)
         maskMembPtr++;
         stateMembPtr++;
     }
+    
+    return true;
 }
 
 
@@ -362,17 +543,24 @@ extern bool SPI_IsSpiBusy(SpiSfr_t *const spiSfr)
 {
     bool flag;
     
+    /* NOTE: SPIBUSY is sampled before interrupt flags, frame completing in
+     *       between leaves its TX flag pending instead of looking idle;
+     *       it stays set in Audio and Framed mode (continuous clock), where
+     *       streaming state tells whether module is in use */
+    
     /* Interrupt sources for SPI1 */
     if( spiSfr == &SPI1_MODULE )
     {
-        flag = (icSfr->ICxIEC1.W & IC_SPI1TXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1TXIF_MASK) || \
+        flag = ((spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) && !SpiIsClkContinuous(spiSfr)) || \
+               (icSfr->ICxIEC1.W & IC_SPI1TXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1TXIF_MASK) || \
                (icSfr->ICxIEC1.W & IC_SPI1RXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1RXIF_MASK) || \
                (icSfr->ICxIEC1.W & IC_SPI1EIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1EIF_MASK);
     }
     /* Interrupt sources for SPI2 */
     else if ( spiSfr == &SPI2_MODULE )
     {
-        flag = (icSfr->ICxIEC1.W & IC_SPI2TXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2TXIF_MASK) || \
+        flag = ((spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) && !SpiIsClkContinuous(spiSfr)) || \
+               (icSfr->ICxIEC1.W & IC_SPI2TXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2TXIF_MASK) || \
                (icSfr->ICxIEC1.W & IC_SPI2RXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2RXIF_MASK) || \
                (icSfr->ICxIEC1.W & IC_SPI2EIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2EIF_MASK);  
     }
@@ -382,7 +570,13 @@ extern bool SPI_IsSpiBusy(SpiSfr_t *const spiSfr)
         return false;
     }
     
-    return flag || ((spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) >> SPI_SPIBUSY_POS);
+    /* DMA-based transfer in progress */
+    flag = flag || ((dmaCtx != NULL) && (dmaCtx->spiSfr == spiSfr));
+    
+    /* Queued transactions pending or streaming transfer in progress */
+    flag = flag || (SpiContextGet(spiSfr)->queueCount != 0) || SpiContextGet(spiSfr)->isStreaming;
+    
+    return flag;
 }
 
 
@@ -414,11 +608,10 @@ extern bool SPI_IsRxDone(SpiSfr_t *const spiSfr, uint8_t rxbufSize)
  */
 extern bool SPI_MasterReadWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize)
 {
-    /* Set SPI base address for SFR access */
-    isrSpiSfr = spiSfr;     // ISR not used, this variable used for read/write function only
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     
-    /* SPI base address check */
-    if( !(spiSfr == &SPI1_MODULE) && !(spiSfr == &SPI2_MODULE) )
+    if( ctx == NULL )
     {
         return false;
     }
@@ -428,104 +621,54 @@ extern bool SPI_MasterReadWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, vo
     {
         return false;
     }
-        
-    /* Number of active slaves must be positive */
-    if( (ssState.pioA == 0) && (ssState.pioB == 0) )
+    
+    /* Either write/read only (or both) must be selected */
+    if( (txPtr == NULL) && (rxPtr == NULL) )
     {
         return false;
     }
     
-    /* Proceed only if Master mode is enabled */
-    if( !(spiSfr->SPIxCON.W & SPI_MSTEN_MASK) )
+    /* Master mode, Slave Select and busy checks */
+    if( !SpiMasterCheck(ctx) )
     {
         return false;
     }
     
-    /* One SPI activity at a time check */
-    if( SPI_IsSpiBusy(spiSfr) )
+    /* TX/RX data and size are handled by module context */
+    SpiPacketSet(ctx, rxPtr, txPtr, txSize);
+    
+    return SpiMasterReadWritePoll(ctx);
+}
+
+
+/*
+ *  Transmit segments of data in Master mode and wait for Slave data (polling)
+ *  All segments are transferred under single Slave Select assertion
+ *  Returns false if any input restriction is triggered
+ */
+extern bool SPI_MasterReadWriteSg(SpiSfr_t *const spiSfr, const SpiSegment_t *segPtr, uint32_t segCount)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
     {
         return false;
     }
     
-    /* Dummy write/read if pointer NULL */
-    isDummyWrite = (txPtr == NULL) ? true : false;
-    isDummyRead = (rxPtr == NULL) ? true : false;
-    
-    /* Either write/read only (or both) must be selected */
-    if( isDummyWrite && isDummyRead )
+    /* Master mode, Slave Select and busy checks */
+    if( !SpiMasterCheck(ctx) )
     {
         return false;
     }
     
-    /* TX/RX data and size are handled by private variables */
-    txDataPtr = txPtr;
-    txDataSize = txSize;
-    rxDataPtr = rxPtr;
-    
-    /* Read RX FIFO until empty */
-    SPI_DummyRead(spiSfr);
-    
-    SpiFrameWidth_t frameWidth = (spiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
-    
-    /* Obtain old interrupt status and disable interrupts */
-    intrStatus = IC_GetInterruptState();
-    IC_DisableInterrupts();             // Ensure atomic operation for SPIxBUF
-    
-    /* Enable appropriate Slave Select pins */
-    pioSfrA->PIOxLAT.CLR = ssState.pioA;
-    pioSfrB->PIOxLAT.CLR = ssState.pioB;
-    
-    /* Write N-bit wide data frame packet */
-    if( frameWidth == SPI_WIDTH_8BIT )
-    {
-        do{
-            SpiWrite8();
-            
-            /* Wait until SPI bus free */
-            while( (spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) >> SPI_SPIBUSY_POS );
-            
-            SpiRead8();
-            
-        } while( txDataSize != 0);
-    }
-    else if( frameWidth == SPI_WIDTH_16BIT)
-    {
-        do{
-            SpiWrite16();
-            
-            /* Wait until SPI bus free */
-            while( (spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) >> SPI_SPIBUSY_POS );
-            
-            SpiRead16();
-            
-        } while( txDataSize != 0);
-    }
-    else if( frameWidth == SPI_WIDTH_32BIT )
-    {
-        do{
-            SpiWrite32();
-            
-            /* Wait until SPI bus free */
-            while( (spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) >> SPI_SPIBUSY_POS );
-            
-            SpiRead32();
-            
-        } while( txDataSize != 0);
-    }
-    /* Out of range "MODE" SFR value */
-    else
+    /* TX/RX segments are handled by module context (also a size check) */
+    if( !SpiPacketSetSg(ctx, segPtr, segCount) )
     {
         return false;
     }
     
-    /* Disable appropriate Slave Select pins */
-    pioSfrA->PIOxLAT.SET = ssState.pioA;
-    pioSfrB->PIOxLAT.SET = ssState.pioB;
-    
-    /* Restore interrupt state */
-    IC_SetInterruptState(intrStatus);
-    
-    return true;
+    return SpiMasterReadWritePoll(ctx);
 }
 
 
@@ -536,11 +679,10 @@ extern bool SPI_MasterReadWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, vo
  */
 extern bool SPI_MasterWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize)
 {
-    /* Set SPI base address for SFR access */
-    isrSpiSfr = spiSfr;
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     
-    /* Set SPI interrupt IE and IF bit-masks (also an SPI module check) */
-    if( !SpiInterruptMaskSet(isrSpiSfr) )
+    if( ctx == NULL )
     {
         return false;
     }
@@ -550,145 +692,264 @@ extern bool SPI_MasterWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, volati
     {
         return false;
     }
-        
-    /* Number of active slaves must be positive */
-    if( (ssState.pioA == 0) && (ssState.pioB == 0) )
+    
+    /* Either write/read only (or both) must be selected */
+    if( (txPtr == NULL) && (rxPtr == NULL) )
     {
         return false;
     }
     
-    /* Proceed only if Master mode is enabled */
-    if( !(isrSpiSfr->SPIxCON.W & SPI_MSTEN_MASK) )
+    /* Master mode, Slave Select and busy checks */
+    if( !SpiMasterCheck(ctx) )
     {
         return false;
     }
     
-    /* One SPI activity at a time check */
-    if( SPI_IsSpiBusy(spiSfr) )
+    /* Use appropriate TX handler */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_0);
+    
+    /* TX/RX data and size are handled by module context */
+    SpiPacketSet(ctx, rxPtr, txPtr, txSize);
+    
+    return SpiMasterWriteStart(ctx);
+}
+
+
+/*
+ *  Transmit segments of data in Master mode (RX data available after SPI not
+ *  busy, interrupt-based)
+ *  All segments are transferred under single Slave Select assertion
+ *  Returns false if any input restriction is triggered
+ * 
+ *  NOTE: Segment array must remain valid until transfer is complete
+ */
+extern bool SPI_MasterWriteSg(SpiSfr_t *const spiSfr, const SpiSegment_t *segPtr, uint32_t segCount)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
     {
         return false;
     }
     
-    /* Dummy write/read if pointer NULL */
-    isDummyWrite = (txPtr == NULL) ? true : false;
-    isDummyRead = (rxPtr == NULL) ? true : false;
-    
-    /* Either write/read only (or both) must be selected */
-    if( isDummyWrite && isDummyRead )
+    /* Master mode, Slave Select and busy checks */
+    if( !SpiMasterCheck(ctx) )
     {
         return false;
     }
     
-    /* TX/RX data and size are handled by private variables */
-    txDataPtr = txPtr;
-    txDataSize = txSize;
-    rxDataPtr = rxPtr;
+    /* TX/RX segments are handled by module context (also a size check) */
+    if( !SpiPacketSetSg(ctx, segPtr, segCount) )
+    {
+        return false;
+    }
     
     /* Use appropriate TX handler */
-    IsrHandlerPtrConfig(ISR_SPI_MODE_0);
-    
-    /* Read RX FIFO until empty */
-    SPI_DummyRead(isrSpiSfr);
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_0);
     
-    /* TX and RX interrupt flag trigger setting */
-    isrSpiSfr->SPIxCON.CLR = SPI_STXISEL_MASK;       // TX flag set on last SPISR transfer
+    return SpiMasterWriteStart(ctx);
+}
+
+
+/*
+ *  Transmit data in Master mode (RX data available after SPI not busy,
+ *  interrupt-based)
+ *  Returns false if any input restriction is triggered
+ * 
+ *  NOTE: This function is exactly the same as the SPI_MasterWrite(),
+ *        except that a modified ISR handler is used where isrHandler() is used
+ */
+extern bool SPI_MasterWrite2(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, volatile void (*isrHandler)(void))
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     
-    SpiFrameWidth_t frameWidth = (isrSpiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
+    if( ctx == NULL )
+    {
+        return false;
+    }
     
-    /* Obtain old interrupt status and disable interrupts */
-    intrStatus = IC_GetInterruptState();
-    IC_DisableInterrupts();             // Ensure atomic operation for SPIxBUF
+    /* Packet size check */
+    if( txSize == 0 )
+    {
+        return false;
+    }
     
-    /* Enable appropriate Slave Select pins */
-    pioSfrA->PIOxLAT.CLR = ssState.pioA;
-    pioSfrB->PIOxLAT.CLR = ssState.pioB;
+    /* Either write/read only (or both) must be selected */
+    if( (txPtr == NULL) && (rxPtr == NULL) )
+    {
+        return false;
+    }
     
-    /* Write N-bit wide data frame packet */
-    if( frameWidth == SPI_WIDTH_8BIT )
+    /* Master mode, Slave Select and busy checks (handler of running transfer kept) */
+    if( !SpiMasterCheck(ctx) )
     {
-        SpiWrite8();
+        return false;
     }
-    else if( frameWidth == SPI_WIDTH_16BIT)
+    
+    /* Use appropriate TX handler and configure additional function pointer */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_1);
+    ctx->isrExtraHandlerPtr = (void (*)(void))isrHandler;
+    
+    /* TX/RX data and size are handled by module context */
+    SpiPacketSet(ctx, rxPtr, txPtr, txSize);
+    
+    /* Execute standard functions */
+    return SpiMasterWriteStart(ctx);
+}
+
+
+/*
+ *  Transmit data in Master mode and return immediately (non-blocking,
+ *  interrupt-based), transfer completion is reported through given handle
+ *  Interrupts are disabled only while SPIxBUF is being loaded
+ *  Returns false if any input restriction is triggered
+ * 
+ *  NOTE: Handle must remain valid until transfer is complete
+ */
+extern bool SPI_MasterReadWriteAsync(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, SpiXfer_t *const xferPtr)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( (ctx == NULL) || (xferPtr == NULL) )
     {
-        SpiWrite16();
+        return false;
     }
-    else if( frameWidth == SPI_WIDTH_32BIT )
+    
+    /* Packet size check */
+    if( txSize == 0 )
     {
-        SpiWrite32();
+        return false;
     }
-    /* Out of range "MODE" SFR value */
-    else
+    
+    /* Either write/read only (or both) must be selected */
+    if( (txPtr == NULL) && (rxPtr == NULL) )
     {
         return false;
     }
     
-    /* Clear TX flag only if transfer is still in progress */
-    if( isrSpiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK )
+    /* Master mode, Slave Select and busy checks */
+    if( !SpiMasterCheck(ctx) )
     {
-        icSfr->ICxIFS1.CLR = ic.spiTxIf;
+        return false;
     }
-    icSfr->ICxIEC1.SET = ic.spiTxIe;    // TX source enabled
     
-    /* Restore interrupt state */
-    IC_SetInterruptState(intrStatus);
+    /* Handle is pending until ISR completes the transfer */
+    xferPtr->isDone = false;
+    xferPtr->isrHandler = NULL;
+    ctx->xferPtr = xferPtr;
     
-    return true;
+    /* Use appropriate TX handler */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_4);
+    
+    /* TX/RX data and size are handled by module context */
+    SpiPacketSet(ctx, rxPtr, txPtr, txSize);
+    
+    return SpiMasterWriteStart(ctx);
 }
 
 
 /*
- *  Transmit data in Master mode (RX data available after SPI not busy,
- *  interrupt-based)
- *  Returns false if any input restriction is triggered
- * 
- *  NOTE: This function is exactly the same as the SPI_MasterWrite(),
- *        except that a modified ISR handler is used where isrHandler() is used
+ *  Check if non-blocking transfer of given handle is complete
+ *  Returns false if transfer is still in progress or handle is not valid
  */
-extern bool SPI_MasterWrite2(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, volatile void (*isrHandler)(void))
+extern bool SPI_IsXferDone(const SpiXfer_t *const xferPtr)
 {
-    /* Use appropriate TX handler and configure additional function pointer */
-    IsrHandlerPtrConfig(ISR_SPI_MODE_1);
-    isrExtraHandlerPtr = isrHandler;
+    if( xferPtr == NULL )
+    {
+        return false;
+    }
     
-    /* Execute standard functions */
-    return SPI_MasterWrite(spiSfr, rxPtr, txPtr, txSize);
+    return xferPtr->isDone;
 }
 
 
 /*
- *  Empties RX FIFO buffer if there is any RX data pending
+ *  Attach user-defined function executed from ISR when transfer of given
+ *  handle completes (executed immediately if transfer is already complete)
+ *  Returns false if any input restriction is triggered
  */
-extern bool SPI_DummyRead(SpiSfr_t *const spiSfr)
+extern bool SPI_SetXferCallback(SpiXfer_t *const xferPtr, void (*isrHandler)(void))
 {
-    /* SPI base address check */
-    if( (spiSfr == &SPI1_MODULE) || (spiSfr == &SPI2_MODULE) )
+    if( (xferPtr == NULL) || (isrHandler == NULL) )
     {
-        /* Read RX FIFO until empty */
-        while( !(spiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) )
-        {
-            dummyRxData = spiSfr->SPIxBUF.W;
-        }
-        
-        return true;
+        return false;
     }
-    else
+    
+    /* Obtain old interrupt status and disable interrupts */
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Ensure completion is not missed
+    
+    bool isDone = xferPtr->isDone;
+    
+    if( !isDone )
+    {
+        xferPtr->isrHandler = isrHandler;
+    }
+    
+    /* Restore interrupt state */
+    IC_SetInterruptState(intrStatus);
+    
+    /* Transfer completed before callback was attached */
+    if( isDone )
+    {
+        isrHandler();
+    }
+    
+    return true;
+}
+
+
+/*
+ *  Wait until non-blocking transfer of given handle completes, or until
+ *  timeout (in microseconds) expires
+ *  Returns false on timeout (transfer keeps running) or if handle is not valid
+ */
+extern bool SPI_WaitXfer(const SpiXfer_t *const xferPtr, uint32_t timeoutUs)
+{
+    if( xferPtr == NULL )
     {
         return false;
     }
+    
+    /* Core timer runs at half of system clock frequency (64-bit, so that
+     * neither SYSCLK below 2 MHz nor long timeouts truncate the count) */
+    uint64_t timeoutCount = ((uint64_t)timeoutUs * (OSC_GetSysFreq() / 2)) / 1000000;
+    uint64_t elapsedCount = 0;
+    uint32_t lastCount = _CP0_GET_COUNT();
+    
+    /* Wrap-safe elapsed time check (accumulated over core timer wraps) */
+    while( !xferPtr->isDone )
+    {
+        uint32_t count = _CP0_GET_COUNT();
+        elapsedCount += count - lastCount;
+        lastCount = count;
+        
+        if( elapsedCount >= timeoutCount )
+        {
+            return xferPtr->isDone;
+        }
+    }
+    
+    return true;
 }
 
 
 /*
- *  Load Slave TX data
+ *  Transmit data in Master mode with FIFO watermark interrupts (streaming,
+ *  interrupt-based): TX FIFO is refilled when half empty and RX FIFO is
+ *  drained when half full, so SCK keeps running during long packets
+ *  Optional user-defined function is executed from ISR at the end of transfer
  *  Returns false if any input restriction is triggered
  */
-extern bool SPI_SlaveWrite(SpiSfr_t *const spiSfr, volatile void *txPtr, uint32_t txSize)
+extern bool SPI_MasterWriteStream(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, void (*isrHandler)(void))
 {
-    /* Set SPI base address for SFR access */
-    isrSpiSfr = spiSfr;         // ISR not used, this variable used for write function only
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     
-    /* SPI base address check */
-    if( !(spiSfr == &SPI1_MODULE) && !(spiSfr == &SPI2_MODULE) )
+    if( ctx == NULL )
     {
         return false;
     }
@@ -699,453 +960,2125 @@ extern bool SPI_SlaveWrite(SpiSfr_t *const spiSfr, volatile void *txPtr, uint32_
         return false;
     }
     
-    /* Proceed only if Slave mode is enabled */
-    if( spiSfr->SPIxCON.W & SPI_MSTEN_MASK )
+    /* Either write/read only (or both) must be selected */
+    if( (txPtr == NULL) && (rxPtr == NULL) )
     {
         return false;
     }
     
-    /* One SPI activity at a time check */
-    if( SPI_IsSpiBusy(spiSfr) )
+    /* Master mode, Slave Select and busy checks */
+    if( !SpiMasterCheck(ctx) )
     {
         return false;
     }
     
-    /* Dummy write/read if pointer NULL */
-    isDummyWrite = (txPtr == NULL) ? true : false;
+    /* Use streaming handler for both TX and RX interrupt sources */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_3);
+    ctx->isrExtraHandlerPtr = isrHandler;
+    
+    /* TX/RX data and size are handled by module context */
+    SpiPacketSet(ctx, rxPtr, txPtr, txSize);
     
-    /* TX data and size are handled by global variables */
-    txDataPtr = txPtr;
-    txDataSize = txSize;
+    /* Read RX FIFO until empty */
+    SPI_DummyRead(spiSfr);
     
-    SpiFrameWidth_t frameWidth = (spiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
+    /* TX and RX interrupt flag trigger setting (FIFO watermarks) */
+    spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK | SPI_SRXISEL_MASK;
+    spiSfr->SPIxCON.SET = (SPI_STXISEL_INTR_WHEN_BUFF_HALF_EMPTY << SPI_STXISEL_POS) |
+                          (SPI_SRXISEL_INTR_WHEN_BUFF_HALF_FULL << SPI_SRXISEL_POS);
+    
+    ctx->isStreaming = true;
     
     /* Obtain old interrupt status and disable interrupts */
-    volatile uint32_t intrStatus = IC_GetInterruptState();
-    IC_DisableInterrupts();                                 // Ensure atomic operation for SPIxBUF
+    ctx->intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Ensure atomic operation for SPIxBUF
     
-    /* Write N-bit wide data frame packet */
-    if( frameWidth == SPI_WIDTH_8BIT )
+    /* Enable appropriate Slave Select pins */
+    SpiSsAssert(ctx);
+    
+    /* Fill whole TX FIFO (RX FIFO of same depth is empty) */
+    SpiWrite(ctx);
+    
+    /* Whole packet loaded, remaining frames are drained one by one */
+    if( !SpiTxSegmentNext(ctx) )
+    {
+        spiSfr->SPIxCON.CLR = SPI_SRXISEL_MASK;
+        spiSfr->SPIxCON.SET = (SPI_SRXISEL_INTR_WHEN_BUFF_NOT_EMPTY << SPI_SRXISEL_POS);
+    }
+    /* TX source enabled */
+    else
+    {
+        icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
+        icSfr->ICxIEC1.SET = ctx->ic.spiTxIe;
+    }
+    
+    /* RX source enabled */
+    icSfr->ICxIFS1.CLR = ctx->ic.spiRxIf;
+    icSfr->ICxIEC1.SET = ctx->ic.spiRxIe;
+    
+    /* Restore interrupt state */
+    IC_SetInterruptState(ctx->intrStatus);
+    
+    return true;
+}
+
+
+/*
+ *  Starts continuous audio streaming with ping-pong buffers (interrupt-based)
+ *  Each buffer holds two halves of given size (in frames, more than FIFO
+ *  depth), user-defined function is executed from ISR with index of half
+ *  which has just been transmitted and received (only one of them for
+ *  transmit-only or receive-only streaming) and may be refilled
+ *  Returns false if any input restriction is triggered
+ * 
+ *  NOTE: Module must be configured with SPI_ConfigAudioModeSfr() or
+ *        SPI_ConfigFramedModeSfr() beforehand
+ */
+extern bool SPI_StartAudioStream(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t halfSize, void (*isrHandler)(uint32_t half))
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Either write/read only (or both) must be selected */
+    if( (txPtr == NULL) && (rxPtr == NULL) )
     {
-        SpiWrite8();
+        return false;
     }
-    else if( frameWidth == SPI_WIDTH_16BIT)
+    
+    /* Proceed only if Audio Protocol Interface or Framed mode is enabled */
+    if( !SpiIsClkContinuous(spiSfr) || (ctx->fifoOps == NULL) )
     {
-        SpiWrite16();
+        return false;
     }
-    else if( frameWidth == SPI_WIDTH_32BIT )
+    
+    /* Half buffer must outlast frames held by FIFO (a half is refilled while
+     * the other one is being loaded) */
+    if( halfSize <= ctx->fifoOps->fifoDepth )
     {
-        SpiWrite32();
+        return false;
     }
-    /* Out of range "MODE" SFR value */
-    else
+    
+    /* One SPI activity at a time check */
+    if( SPI_IsSpiBusy(spiSfr) )
     {
         return false;
     }
     
+    /* Ping-pong halves of user buffers (NULL for dummy write/read) */
+    uint32_t halfBytes = halfSize * ctx->fifoOps->frameSize;
+    
+    ctx->txHalfPtr[0] = txPtr;
+    ctx->txHalfPtr[1] = (txPtr == NULL) ? NULL : (uint8_t *)txPtr + halfBytes;
+    ctx->rxHalfPtr[0] = rxPtr;
+    ctx->rxHalfPtr[1] = (rxPtr == NULL) ? NULL : (uint8_t *)rxPtr + halfBytes;
+    ctx->halfSize = halfSize;
+    ctx->txHalfCount = 0;
+    ctx->rxHalfCount = 0;
+    ctx->doneHalfCount = 0;
+    ctx->isrHalfHandlerPtr = isrHandler;
+    ctx->underrunCount = 0;
+    ctx->overrunCount = 0;
+    
+    /* Use audio handlers */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_5);
+    
+    /* First half is handled by module context */
+    SpiPacketSet(ctx, rxPtr, txPtr, halfSize);
+    
+    /* Read RX FIFO until empty, clear error flags */
+    SPI_DummyRead(spiSfr);
+    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK | SPI_SPITUR_MASK;
+    
+    /* TX interrupt flag set when TX FIFO is half empty */
+    spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK;
+    spiSfr->SPIxCON.SET = (SPI_STXISEL_INTR_WHEN_BUFF_HALF_EMPTY << SPI_STXISEL_POS);
+    
+    /* Underrun and overrun generate error interrupt */
+    spiSfr->SPIxCON2.SET = SPI_SPITUREN_MASK | SPI_SPIROVEN_MASK;
+    
+    ctx->isStreaming = true;
+    
+    /* Obtain old interrupt status and disable interrupts */
+    ctx->intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    
+    /* Fill whole TX FIFO */
+    ISR_SpiTxHandler_Audio(ctx);
+    
+    /* TX and error sources enabled */
+    icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf | ctx->ic.spiEIf;
+    icSfr->ICxIEC1.SET = ctx->ic.spiTxIe | ctx->ic.spiEIe;
+    
     /* Restore interrupt state */
-    IC_SetInterruptState(intrStatus);
+    IC_SetInterruptState(ctx->intrStatus);
     
     return true;
 }
 
 
+/*
+ *  Stops audio streaming started with SPI_StartAudioStream()
+ *  Returns false if any input restriction is triggered
+ */
+extern bool SPI_StopAudioStream(SpiSfr_t *const spiSfr)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Audio streaming must be in progress */
+    if( !ctx->isStreaming || (ctx->isrTxHandlerPtr != ISR_SpiTxHandler_Audio) )
+    {
+        return false;
+    }
+    
+    /* Disable TX and error interrupt sources */
+    icSfr->ICxIEC1.CLR = ctx->ic.spiTxIe | ctx->ic.spiEIe;
+    icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf | ctx->ic.spiEIf;
+    
+    /* Default TX interrupt flag trigger setting, error interrupts disabled */
+    spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK;
+    spiSfr->SPIxCON2.CLR = SPI_SPITUREN_MASK | SPI_SPIROVEN_MASK;
+    
+    ctx->isStreaming = false;
+    
+    return true;
+}
+
 
 /*
- *  Read Slave RX data
+ *  Reads number of TX underrun and RX overrun events since audio streaming
+ *  was started
  *  Returns false if any input restriction is triggered
  */
-extern bool SPI_SlaveRead(SpiSfr_t *const spiSfr, volatile void *rxPtr)
+extern bool SPI_GetAudioErrorCount(SpiSfr_t *const spiSfr, uint32_t *const underrunPtr, uint32_t *const overrunPtr)
 {
-    /* Set SPI base address for SFR access */
-    isrSpiSfr = spiSfr;         // ISR not used, this variable used for write function only
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
     
-    /* SPI base address check */
-    if( !(spiSfr == &SPI1_MODULE) && !(spiSfr == &SPI2_MODULE) )
+    if( (ctx == NULL) || (underrunPtr == NULL) || (overrunPtr == NULL) )
     {
         return false;
     }
     
-    /* Proceed only if Slave mode is enabled */
-    if( spiSfr->SPIxCON.W & SPI_MSTEN_MASK )
+    *underrunPtr = ctx->underrunCount;
+    *overrunPtr = ctx->overrunCount;
+    
+    return true;
+}
+
+
+/*
+ *  Adds transaction to SPI module queue (interrupt-based, Master mode)
+ *  Transaction starts immediately if queue is empty, otherwise it is started
+ *  from ISR right after the previous one completes
+ *  Returns false if any input restriction is triggered or queue is full
+ * 
+ *  NOTE: Only the job's Slave Select pin is toggled, SS state set with
+ *        SPI_EnableSsState() is not used by queued transactions
+ */
+extern bool SPI_QueueJob(SpiSfr_t *const spiSfr, SpiJob_t job)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
     {
         return false;
     }
     
-    /* One SPI activity at a time check */
-    if( SPI_IsSpiBusy(spiSfr) )
+    /* Packet size check */
+    if( job.txSize == 0 )
+    {
+        return false;
+    }
+    
+    /* Either write/read only (or both) must be selected */
+    if( (job.txPtr == NULL) && (job.rxPtr == NULL) )
+    {
+        return false;
+    }
+    
+    /* Frame width check */
+    if( job.frameWidth > SPI_WIDTH_32BIT )
     {
         return false;
     }
     
-    /* Dummy write/read if pointer NULL */
-    isDummyRead = (rxPtr == NULL) ? true : false;
+    /* Slave Select pin must be located on available PIO module */
+    PioSfr_t *const ssPioSfr = PIO_ReadPinModule(job.ssPin);
+    if( (ssPioSfr != &PIOA_MODULE) && (ssPioSfr != &PIOB_MODULE) )
+    {
+        return false;
+    }
+    
+    /* Proceed only if Master mode is enabled */
+    if( !(spiSfr->SPIxCON.W & SPI_MSTEN_MASK) )
+    {
+        return false;
+    }
+    
+    /* Queue is modified from ISR as well */
+    volatile uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    
+    /* Queue full or SPI busy with non-queued operation */
+    if( (ctx->queueCount == SPI_QUEUE_SIZE) ||
+        ((ctx->queueCount == 0) && SPI_IsSpiBusy(spiSfr)) )
+    {
+        IC_SetInterruptState(intrStatus);
+        
+        return false;
+    }
+    
+    /* Add job at the head of queue */
+    ctx->queue[ctx->queueHead] = job;
+    ctx->queueHead = (ctx->queueHead + 1) % SPI_QUEUE_SIZE;
+    ctx->queueCount++;
+    
+    /* Start immediately if this is the only job (configured frame width is
+     * kept to be restored after the last job) */
+    if( ctx->queueCount == 1 )
+    {
+        ctx->queueModeBits = spiSfr->SPIxCON.W & SPI_MODE_MASK;
+        ctx->queueFifoOps = ctx->fifoOps;
+        
+        SpiJobStart(ctx);
+    }
+    
+    /* Restore interrupt state */
+    IC_SetInterruptState(intrStatus);
+    
+    return true;
+}
+
+
+/*
+ *  Returns number of queued transactions (including one in progress)
+ */
+extern uint32_t SPI_GetQueueCount(SpiSfr_t *const spiSfr)
+{
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    /* SPI base address check */
+    if( ctx == NULL )
+    {
+        return 0;
+    }
+    
+    return ctx->queueCount;
+}
+
+
+/*
+ *  Transmit data in Master mode using DMA (RX channel moves SPIxBUF to RX
+ *  buffer, TX channel moves TX buffer to SPIxBUF, both triggered by SPI IRQs)
+ *  Returns false if any input restriction is triggered
+ * 
+ *  NOTE: Function isrHandler() (if not NULL) is executed once from DMA ISR
+ *        after whole packet is transferred
+ *  NOTE: Dummy write (txPtr is NULL) clears RX buffer which is then used as
+ *        TX data source (TX frame is always read before RX frame is written)
+ */
+extern bool SPI_MasterWriteDma(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, void (*isrHandler)(void))
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Packet size check */
+    if( txSize == 0 )
+    {
+        return false;
+    }
+    
+    /* Dummy write/read if pointer NULL */
+    bool isDmaDummyWrite = (txPtr == NULL) ? true : false;
+    bool isDmaDummyRead = (rxPtr == NULL) ? true : false;
+    
+    /* Either write/read only (or both) must be selected */
+    if( isDmaDummyWrite && isDmaDummyRead )
+    {
+        return false;
+    }
+    
+    /* Module must be configured (FIFO routines bound) */
+    if( ctx->fifoOps == NULL )
+    {
+        return false;
+    }
+    
+    /* DMA cell size equals N-bit wide data frame */
+    uint32_t cellSize = ctx->fifoOps->frameSize;
+    
+    /* DMA block size is limited by 16-bit DCHxSSIZ and DCHxDSIZ */
+    if( txSize > (0xFFFF / cellSize) )
+    {
+        return false;
+    }
+    
+    uint32_t blockSize = txSize * cellSize;
+    uint32_t txIrq, rxIrq;
+    
+    /* DMA start events for selected SPI module */
+    if( spiSfr == &SPI1_MODULE )
+    {
+        txIrq = SPI1_TX_IRQ;
+        rxIrq = SPI1_RX_IRQ;
+    }
+    else
+    {
+        txIrq = SPI2_TX_IRQ;
+        rxIrq = SPI2_RX_IRQ;
+    }
+    
+    /* Busy check and DMA channel reservation must not be interrupted */
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    
+    /* Master mode, Slave Select and busy checks (DMA channels are shared) */
+    if( !SpiMasterCheck(ctx) || (dmaCtx != NULL) )
+    {
+        IC_SetInterruptState(intrStatus);
+        return false;
+    }
+    
+    /* TX data source is cleared RX buffer in case of dummy write */
+    if( isDmaDummyWrite )
+    {
+        volatile uint8_t *clrPtr = (uint8_t *)rxPtr;
+        uint32_t clrSize = blockSize;
+        
+        while( clrSize-- )
+        {
+            *clrPtr++ = (uint8_t)dummyTxData;
+        }
+        
+        txPtr = rxPtr;
+    }
+    
+    /* Reserve DMA channels and set completion function (SPI TX source ends
+     * transfer once DMA is done) */
+    dmaCtx = ctx;
+    ctx->isrExtraHandlerPtr = isrHandler;
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_7);
+    
+    /* Read RX FIFO until empty */
+    SPI_DummyRead(spiSfr);
+    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    
+    /* TX flag set while TX FIFO not full, RX flag set while RX FIFO not empty */
+    spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK | SPI_SRXISEL_MASK;
+    spiSfr->SPIxCON.SET = (SPI_STXISEL_INTR_WHEN_BUFF_NOT_FULL << SPI_STXISEL_POS) |
+                          (SPI_SRXISEL_INTR_WHEN_BUFF_NOT_EMPTY << SPI_SRXISEL_POS);
+    
+    /* Enable DMA controller */
+    DMA_DMACONSET = DMA_ON_MASK;
+    
+    /* RX channel (highest priority so RX FIFO is never overrun) */
+    DmaChannelReset(dmaRxSfr);
+    dmaRxSfr->DCHxECON.SET = (rxIrq << DMA_CHSIRQ_POS) | DMA_SIRQEN_MASK;
+    dmaRxSfr->DCHxSSA.W = DMA_KVA_TO_PA(&spiSfr->SPIxBUF.W);
+    dmaRxSfr->DCHxSSIZ.W = cellSize;
+    dmaRxSfr->DCHxCSIZ.W = cellSize;
+    dmaRxSfr->DCHxCON.SET = (3 << DMA_CHPRI_POS);
+    
+    /* TX channel */
+    DmaChannelReset(dmaTxSfr);
+    dmaTxSfr->DCHxECON.SET = (txIrq << DMA_CHSIRQ_POS) | DMA_SIRQEN_MASK;
+    dmaTxSfr->DCHxSSA.W = DMA_KVA_TO_PA(txPtr);
+    dmaTxSfr->DCHxDSA.W = DMA_KVA_TO_PA(&spiSfr->SPIxBUF.W);
+    dmaTxSfr->DCHxSSIZ.W = blockSize;
+    dmaTxSfr->DCHxDSIZ.W = cellSize;
+    dmaTxSfr->DCHxCSIZ.W = cellSize;
+    dmaTxSfr->DCHxCON.SET = (2 << DMA_CHPRI_POS);
+    
+    /* Dummy read: RX channel drains FIFO continuously (auto-enable), packet
+     * completion is signaled by TX channel */
+    if( isDmaDummyRead )
+    {
+        dmaRxSfr->DCHxDSA.W = DMA_KVA_TO_PA(&dummyRxData);
+        dmaRxSfr->DCHxDSIZ.W = cellSize;
+        dmaRxSfr->DCHxCON.SET = DMA_CHAEN_MASK;
+        dmaTxSfr->DCHxINT.SET = DMA_CHBCIE_MASK | DMA_CHERIE_MASK;
+    }
+    /* Normal read: packet completion is signaled by RX channel */
+    else
+    {
+        dmaRxSfr->DCHxDSA.W = DMA_KVA_TO_PA(rxPtr);
+        dmaRxSfr->DCHxDSIZ.W = blockSize;
+        dmaRxSfr->DCHxINT.SET = DMA_CHBCIE_MASK | DMA_CHERIE_MASK;
+    }
+    
+    /* Configure DMA interrupt sources */
+    icSfr->ICxINTCON.SET = IC_MVEC_MASK;
+    icSfr->ICxIPC10.CLR = (IC_DMA0IP_MASK | IC_DMA0IS_MASK | IC_DMA1IP_MASK | IC_DMA1IS_MASK);
+    icSfr->ICxIPC10.SET = (SPI_DMA_ICX_IPL << IC_DMA0IP_POS) | (SPI_DMA_ICX_ISL << IC_DMA0IS_POS) |
+                          (SPI_DMA_ICX_IPL << IC_DMA1IP_POS) | (SPI_DMA_ICX_ISL << IC_DMA1IS_POS);
+    icSfr->ICxIFS1.CLR = (IC_DMA0IF_MASK | IC_DMA1IF_MASK);
+    icSfr->ICxIEC1.SET = isDmaDummyRead ? IC_DMA1IE_MASK : IC_DMA0IE_MASK;
+    
+    /* Enable appropriate Slave Select pins */
+    SpiSsAssert(ctx);
+    
+    /* Arm both channels and force first TX cell (TX flag may already be set) */
+    dmaRxSfr->DCHxCON.SET = DMA_CHEN_MASK;
+    dmaTxSfr->DCHxCON.SET = DMA_CHEN_MASK;
+    dmaTxSfr->DCHxECON.SET = DMA_CFORCE_MASK;
+    
+    /* Restore interrupt state of caller */
+    IC_SetInterruptState(intrStatus);
+    
+    return true;
+}
+
+
+/*
+ *  Empties RX FIFO buffer if there is any RX data pending
+ */
+extern bool SPI_DummyRead(SpiSfr_t *const spiSfr)
+{
+    /* SPI base address check */
+    if( (spiSfr == &SPI1_MODULE) || (spiSfr == &SPI2_MODULE) )
+    {
+        /* Read RX FIFO until empty */
+        while( !(spiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) )
+        {
+            dummyRxData = spiSfr->SPIxBUF.W;
+        }
+        
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+/*
+ *  Load Slave TX data
+ *  Returns false if any input restriction is triggered
+ */
+extern bool SPI_SlaveWrite(SpiSfr_t *const spiSfr, volatile void *txPtr, uint32_t txSize)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Packet size check */
+    if( txSize == 0 )
+    {
+        return false;
+    }
+    
+    /* Proceed only if Slave mode is enabled */
+    if( spiSfr->SPIxCON.W & SPI_MSTEN_MASK )
+    {
+        return false;
+    }
+    
+    /* One SPI activity at a time check */
+    if( SPI_IsSpiBusy(spiSfr) )
+    {
+        return false;
+    }
+    
+    /* Module must be configured (FIFO routines bound) */
+    if( ctx->fifoOps == NULL )
+    {
+        return false;
+    }
+    
+    /* Dummy write if pointer NULL */
+    ctx->txFill = ctx->fifoOps->fill[txPtr == NULL];
+    
+    /* TX data and size are handled by module context */
+    ctx->txDataPtr = txPtr;
+    ctx->txDataSize = txSize;
+    ctx->txSegCount = 0;
+    
+    /* Obtain old interrupt status and disable interrupts */
+    volatile uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();                                 // Ensure atomic operation for SPIxBUF
+    
+    /* Write N-bit wide data frame packet */
+    SpiWrite(ctx);
+    
+    /* Restore interrupt state */
+    IC_SetInterruptState(intrStatus);
+    
+    return true;
+}
+
+
+
+/*
+ *  Read Slave RX data
+ *  Returns false if any input restriction is triggered
+ */
+extern bool SPI_SlaveRead(SpiSfr_t *const spiSfr, volatile void *rxPtr)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Proceed only if Slave mode is enabled */
+    if( spiSfr->SPIxCON.W & SPI_MSTEN_MASK )
+    {
+        return false;
+    }
+    
+    /* One SPI activity at a time check */
+    if( SPI_IsSpiBusy(spiSfr) )
+    {
+        return false;
+    }
+    
+    /* Module must be configured (FIFO routines bound), RX data of active ring
+     * buffer is read from ISR */
+    if( (ctx->fifoOps == NULL) || (ctx->ringPtr != NULL) )
+    {
+        return false;
+    }
+    
+    /* Dummy read if pointer NULL */
+    ctx->rxDrain = ctx->fifoOps->drain[rxPtr == NULL];
+    
+    /* RX data is handled by module context (read until RX FIFO empty) */
+    ctx->rxDataPtr = rxPtr;
+    ctx->rxDataSize = UINT32_MAX;
+    ctx->rxSegCount = 0;
+    
+    /* Read N-bit wide data frame packet */
+    SpiRead(ctx);
+    
+    return true;
+}
+
+
+/*
+ *  Starts interrupt-based Slave reception into ring buffer of given size (in
+ *  frames, must be power of two)
+ *  Returns false if any input restriction is triggered
+ * 
+ *  NOTE: Ring buffer is lock-free for single consumer outside of ISR
+ */
+extern bool SPI_StartSlaveRing(SpiSfr_t *const spiSfr, volatile void *bufPtr, uint32_t bufSize)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( (ctx == NULL) || (bufPtr == NULL) )
+    {
+        return false;
+    }
+    
+    /* Ring buffer size must be power of two */
+    if( (bufSize == 0) || (bufSize & (bufSize - 1)) )
+    {
+        return false;
+    }
+    
+    /* Proceed only if Slave mode is enabled */
+    if( spiSfr->SPIxCON.W & SPI_MSTEN_MASK )
+    {
+        return false;
+    }
+    
+    /* Module must be configured and ring buffer not yet active */
+    if( (ctx->fifoOps == NULL) || (ctx->ringPtr != NULL) )
+    {
+        return false;
+    }
+    
+    /* Ring buffer is handled by module context */
+    ctx->ringMask = bufSize - 1;
+    ctx->ringHead = 0;
+    ctx->ringTail = 0;
+    ctx->ringOverrunCount = 0;
+    ctx->ringPtr = bufPtr;
+    
+    /* Use ring buffer RX handler */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_6);
+    
+    /* RX interrupt flag set when RX FIFO is not empty */
+    spiSfr->SPIxCON.CLR = SPI_SRXISEL_MASK;
+    spiSfr->SPIxCON.SET = (SPI_SRXISEL_INTR_WHEN_BUFF_NOT_EMPTY << SPI_SRXISEL_POS);
+    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    
+    /* RX source enabled */
+    icSfr->ICxIFS1.CLR = ctx->ic.spiRxIf;
+    icSfr->ICxIEC1.SET = ctx->ic.spiRxIe;
+    
+    return true;
+}
+
+
+/*
+ *  Stops Slave reception into ring buffer (unread data is discarded)
+ *  Returns false if any input restriction is triggered
+ */
+extern bool SPI_StopSlaveRing(SpiSfr_t *const spiSfr)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( (ctx == NULL) || (ctx->ringPtr == NULL) )
+    {
+        return false;
+    }
+    
+    /* Disable RX interrupt source */
+    icSfr->ICxIEC1.CLR = ctx->ic.spiRxIe;
+    icSfr->ICxIFS1.CLR = ctx->ic.spiRxIf;
+    
+    /* Default RX interrupt flag trigger setting */
+    spiSfr->SPIxCON.CLR = SPI_SRXISEL_MASK;
+    
+    ctx->ringPtr = NULL;
+    
+    return true;
+}
+
+
+/*
+ *  Obtains contiguous span of unread frames in Slave ring buffer (data can be
+ *  parsed in place, span is released with SPI_ReleaseSlaveRingSpan())
+ *  Returns number of frames in span (zero if empty or ring buffer not active)
+ */
+extern uint32_t SPI_GetSlaveRingSpan(SpiSfr_t *const spiSfr, volatile void **dataPtr)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( (ctx == NULL) || (ctx->ringPtr == NULL) || (dataPtr == NULL) )
+    {
+        return 0;
+    }
+    
+    uint32_t tail = ctx->ringTail;
+    uint32_t count = ctx->ringHead - tail;
+    uint32_t countToEnd = (ctx->ringMask + 1) - (tail & ctx->ringMask);
+    
+    /* Span ends at ring buffer wrap */
+    *dataPtr = (uint8_t *)ctx->ringPtr + (tail & ctx->ringMask) * ctx->fifoOps->frameSize;
+    
+    return (count > countToEnd) ? countToEnd : count;
+}
+
+
+/*
+ *  Releases given number of frames read from Slave ring buffer
+ *  Returns false if any input restriction is triggered
+ */
+extern bool SPI_ReleaseSlaveRingSpan(SpiSfr_t *const spiSfr, uint32_t count)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( (ctx == NULL) || (ctx->ringPtr == NULL) )
+    {
+        return false;
+    }
+    
+    /* Only unread frames can be released */
+    if( count > (ctx->ringHead - ctx->ringTail) )
+    {
+        return false;
+    }
+    
+    ctx->ringTail += count;
+    
+    return true;
+}
+
+
+/*
+ *  Returns number of frames lost since Slave ring buffer was started (frames
+ *  dropped while ring buffer was full, plus RX FIFO overflow events)
+ */
+extern uint32_t SPI_GetSlaveRingOverrunCount(SpiSfr_t *const spiSfr)
+{
+    /* Context of given SPI module (also an SPI module check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return 0;
+    }
+    
+    return ctx->ringOverrunCount;
+}
+
+
+/******************************************************************************/
+/*------------------------Local Function Definitions--------------------------*/
+/******************************************************************************/
+
+/*
+ *  Write data to SPI TX FIFO (continues across segment boundaries)
+ */
+static INLINE void SpiWrite(SpiContext_t *const ctx)
+{
+    SpiWriteUpTo(ctx, ctx->fifoOps->fifoDepth);
+}
+
+
+/*
+ *  Write at most given number of frames to SPI TX FIFO (continues across
+ *  segment boundaries)
+ */
+static INLINE void SpiWriteUpTo(SpiContext_t *const ctx, uint32_t fifoFree)
+{
+    uint32_t tempSize;
+    
+    do
+    {
+        /* Load only maximum amount of frames to TX FIFO */
+        tempSize = (ctx->txDataSize > fifoFree) ? fifoFree : ctx->txDataSize;
+        ctx->txDataSize -= tempSize;
+        fifoFree -= tempSize;
+        
+        /* Normal or dummy write bound to current segment */
+        ctx->txFill(ctx, tempSize);
+    }
+    while( (fifoFree != 0) && SpiTxSegmentNext(ctx) );
+}
+
+
+/*
+ *  Read data from SPI RX FIFO (continues across segment boundaries)
+ */
+static INLINE void SpiRead(SpiContext_t *const ctx)
+{
+    uint32_t tempSize;
+    
+    do
+    {
+        /* Read only frames waiting in RX FIFO which belong to current segment */
+        tempSize = (ctx->spiSfr->SPIxSTAT.W & SPI_RXBUFELM_MASK) >> SPI_RXBUFELM_POS;
+        tempSize = (tempSize > ctx->rxDataSize) ? ctx->rxDataSize : tempSize;
+        ctx->rxDataSize -= tempSize;
+        
+        /* Normal or dummy read bound to current segment */
+        ctx->rxDrain(ctx, tempSize);
+    }
+    while( !(ctx->spiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) && SpiRxSegmentNext(ctx) );
+}
+
+
+/*
+ *  Write 8-bit data frames to SPI TX FIFO
+ */
+static void SpiFill8(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint8_t *dataPtr = (uint8_t *)ctx->txDataPtr;
+    
+    while( size-- )
+    {
+        spiSfr->SPIxBUF.W = *dataPtr++;
+    }
+    
+    ctx->txDataPtr = dataPtr;
+}
+
+
+/*
+ *  Write 16-bit data frames to SPI TX FIFO
+ */
+static void SpiFill16(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint16_t *dataPtr = (uint16_t *)ctx->txDataPtr;
+    
+    while( size-- )
+    {
+        spiSfr->SPIxBUF.W = *dataPtr++;
+    }
+    
+    ctx->txDataPtr = dataPtr;
+}
+
+
+/*
+ *  Write 32-bit data frames to SPI TX FIFO
+ */
+static void SpiFill32(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint32_t *dataPtr = (uint32_t *)ctx->txDataPtr;
+    
+    while( size-- )
+    {
+        spiSfr->SPIxBUF.W = *dataPtr++;
+    }
+    
+    ctx->txDataPtr = dataPtr;
+}
+
+
+/*
+ *  Write dummy data frames to SPI TX FIFO (any frame width)
+ */
+static void SpiFillDummy(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    while( size-- )
+    {
+        spiSfr->SPIxBUF.W = dummyTxData;
+    }
+}
+
+
+/*
+ *  Read 8-bit data frames from SPI RX FIFO
+ */
+static void SpiDrain8(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint8_t *dataPtr = (uint8_t *)ctx->rxDataPtr;
+    
+    while( size-- )
+    {
+        *dataPtr++ = spiSfr->SPIxBUF.W;
+    }
+    
+    ctx->rxDataPtr = dataPtr;
+}
+
+
+/*
+ *  Read 16-bit data frames from SPI RX FIFO
+ */
+static void SpiDrain16(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint16_t *dataPtr = (uint16_t *)ctx->rxDataPtr;
+    
+    while( size-- )
+    {
+        *dataPtr++ = spiSfr->SPIxBUF.W;
+    }
+    
+    ctx->rxDataPtr = dataPtr;
+}
+
+
+/*
+ *  Read 32-bit data frames from SPI RX FIFO
+ */
+static void SpiDrain32(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint32_t *dataPtr = (uint32_t *)ctx->rxDataPtr;
+    
+    while( size-- )
+    {
+        *dataPtr++ = spiSfr->SPIxBUF.W;
+    }
+    
+    ctx->rxDataPtr = dataPtr;
+}
+
+
+/*
+ *  Read data frames from SPI RX FIFO and discard them (any frame width)
+ */
+static void SpiDrainDummy(SpiContext_t *const ctx, uint32_t size)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    while( size-- )
+    {
+        dummyRxData = spiSfr->SPIxBUF.W;
+    }
+}
+
+
+/*
+ *  Moves TX data to next non-empty segment once current one is loaded
+ *  Returns true if there is TX data left to be loaded
+ */
+static INLINE bool SpiTxSegmentNext(SpiContext_t *const ctx)
+{
+    while( (ctx->txDataSize == 0) && (ctx->txSegCount != 0) )
+    {
+        ctx->txDataPtr = ctx->txSegPtr->txPtr;
+        ctx->txDataSize = ctx->txSegPtr->size;
+        ctx->txFill = ctx->fifoOps->fill[ctx->txSegPtr->txPtr == NULL];
+        
+        ctx->txSegPtr++;
+        ctx->txSegCount--;
+    }
+    
+    return (ctx->txDataSize != 0);
+}
+
+
+/*
+ *  Moves RX data to next non-empty segment once current one is read
+ *  Returns true if there is RX data left to be read
+ */
+static INLINE bool SpiRxSegmentNext(SpiContext_t *const ctx)
+{
+    while( (ctx->rxDataSize == 0) && (ctx->rxSegCount != 0) )
+    {
+        ctx->rxDataPtr = ctx->rxSegPtr->rxPtr;
+        ctx->rxDataSize = ctx->rxSegPtr->size;
+        ctx->rxDrain = ctx->fifoOps->drain[ctx->rxSegPtr->rxPtr == NULL];
+        
+        ctx->rxSegPtr++;
+        ctx->rxSegCount--;
+    }
+    
+    return (ctx->rxDataSize != 0);
+}
+
+
+/*
+ *  Returns transfer context of given SPI module
+ *  Returns NULL if SPI base address is not valid
+ */
+static INLINE SpiContext_t *SpiContextGet(SpiSfr_t *const spiSfr)
+{
+    if( spiSfr == &SPI1_MODULE )
+    {
+        return &spiCtx[0];
+    }
+    else if( spiSfr == &SPI2_MODULE )
+    {
+        return &spiCtx[1];
+    }
+    /* SPI base address check */
+    else
+    {
+        return NULL;
+    }
+}
+
+
+/*
+ *  Captures active Slave Select pins and enables Slave devices
+ */
+static INLINE void SpiSsAssert(SpiContext_t *const ctx)
+{
+    ctx->ssActive.pioA = ctx->ssState.pioA;
+    ctx->ssActive.pioB = ctx->ssState.pioB;
+    
+    pioSfrA->PIOxLAT.CLR = ctx->ssActive.pioA;
+    pioSfrB->PIOxLAT.CLR = ctx->ssActive.pioB;
+}
+
+
+/*
+ *  Disables Slave devices enabled with SpiSsAssert()
+ */
+static INLINE void SpiSsRelease(SpiContext_t *const ctx)
+{
+    pioSfrA->PIOxLAT.SET = ctx->ssActive.pioA;
+    pioSfrB->PIOxLAT.SET = ctx->ssActive.pioB;
+}
+
+
+/*
+ *  Enables single Slave device given by pin code
+ */
+static INLINE void SpiSsAssertPin(SpiContext_t *const ctx, const uint32_t pinCode)
+{
+    PinInfo_t pinInfo = PIO_ReadPinCode(pinCode);
+    
+    ctx->ssActive.pioA = (pinInfo.pinMod == &PIOA_MODULE) ? (1 << pinInfo.pinPos) : 0;
+    ctx->ssActive.pioB = (pinInfo.pinMod == &PIOB_MODULE) ? (1 << pinInfo.pinPos) : 0;
+    
+    pioSfrA->PIOxLAT.CLR = ctx->ssActive.pioA;
+    pioSfrB->PIOxLAT.CLR = ctx->ssActive.pioB;
+}
+
+
+/*
+ *  Disables DMA channel and clears all of its settings
+ */
+static INLINE void DmaChannelReset(DmaChSfr_t *const dmaSfr)
+{
+    /* Disable and abort any pending transfer */
+    dmaSfr->DCHxCON.CLR = DMA_CHEN_MASK;
+    dmaSfr->DCHxECON.SET = DMA_CABORT_MASK;
+    while( dmaSfr->DCHxCON.W & DMA_CHBUSY_MASK );
+    
+    /* Clear channel SFRs */
+    dmaSfr->DCHxCON.CLR = 0xFFFFFFFF;
+    dmaSfr->DCHxECON.CLR = 0xFFFFFFFF;
+    dmaSfr->DCHxINT.CLR = 0xFFFFFFFF;
+}
+
+
+/*
+ *  Configures TX and RX ISR handler function pointers
+ */
+static INLINE void IsrHandlerPtrConfig(SpiContext_t *const ctx, IsrSpiMode_t isrMode)
+{
+    switch( isrMode )
+    {
+        /* Standard Master mode transmission */
+        case ISR_SPI_MODE_0:
+            ctx->isrTxHandlerPtr = ISR_SpiTxHandler_MasterWrite;
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite;
+            break;
+        /* Standard Master mode transmission with extra function at the end */
+        case ISR_SPI_MODE_1:
+            ctx->isrTxHandlerPtr = ISR_SpiTxHandler_MasterWrite2;
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite2;
+            break;
+        /* Queued Master mode transmission (next job chained from ISR) */
+        case ISR_SPI_MODE_2:
+            ctx->isrTxHandlerPtr = ISR_SpiTxHandler_Queue;
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite;
+            break;
+        /* Streaming Master mode transmission (FIFO watermark interrupts) */
+        case ISR_SPI_MODE_3:
+            ctx->isrTxHandlerPtr = ISR_SpiHandler_Stream;
+            ctx->isrRxHandlerPtr = ISR_SpiHandler_Stream;
+            break;
+        /* Non-blocking Master mode transmission (completion via handle) */
+        case ISR_SPI_MODE_4:
+            ctx->isrTxHandlerPtr = ISR_SpiTxHandler_Async;
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite;
+            break;
+        /* Audio streaming (ping-pong buffers, error counters) */
+        case ISR_SPI_MODE_5:
+            ctx->isrTxHandlerPtr = ISR_SpiTxHandler_Audio;
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite;
+            ctx->isrErrHandlerPtr = ISR_SpiErrHandler_Audio;
+            break;
+        /* Slave mode reception into ring buffer (TX source not used) */
+        case ISR_SPI_MODE_6:
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_SlaveRing;
+            break;
+        /* End of DMA-based Master mode transmission (TX source enabled by DMA ISR) */
+        case ISR_SPI_MODE_7:
+            ctx->isrTxHandlerPtr = ISR_SpiTxHandler_Dma;
+            ctx->isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite;
+            break;
+        /* Non-valid input */
+        default:
+            break;
+    }
+}
+
+
+/*
+ *  Configures SPI module in Standard mode with given SPIxCON and SPIxBRG
+ *  values (shared by SPI_ConfigStandardModeSfr() and SPI_ConfigStaticModeSfr())
+ *  Returns false, if any input restriction is triggered
+ */
+static bool SpiStandardModeApply(SpiSfr_t *const spiSfr, SpiPin_t pinSelect, uint32_t conWord, uint32_t brgWord, uint32_t sckFreq)
+{
+    /* Context of given SPI module (also an SPI base address check) */
+    SpiContext_t *const ctx = SpiContextGet(spiSfr);
+    
+    if( ctx == NULL )
+    {
+        return false;
+    }
+    
+    /* Frame width range check */
+    if( ((conWord & SPI_MODE_MASK) >> SPI_MODE_POS) > SPI_WIDTH_32BIT )
+    {
+        return false;
+    }
+    
+    /* Not safe to be configured while operating */
+    if( SPI_IsSpiBusy(spiSfr) )
+    {
+        return false;
+    }
+    
+    /* Disable the module */
+    spiSfr->SPIxCON.CLR = SPI_ON_MASK;
+    asm("nop");
+    
+    /* Clear all SPIx SFRs */
+    spiSfr->SPIxCON.CLR = 0xFFFFFFFF;
+    spiSfr->SPIxBRG.CLR = 0xFFFFFFFF;
+    spiSfr->SPIxCON2.CLR = 0xFFFFFFFF;
+    spiSfr->SPIxSTAT.CLR = 0xFFFFFFFF;
+    
+    /* Mode settings encoded in SPIxCON value */
+    bool isMasterEnabled = (conWord & SPI_MSTEN_MASK) ? true : false;
+    SpiFrameWidth_t frameWidth = (conWord & SPI_MODE_MASK) >> SPI_MODE_POS;
+    
+    /* If value not assigned to pin setting the pin code is zero */
+    bool isSdiEnabled = pinSelect.sdiPin ? true : false;
+    bool isSdoEnabled = pinSelect.sdoPin ? true : false;
+    bool isSsEnabled  = pinSelect.ss1Pin ? true : false;
+    
+    /* If pin not used, disable it in hardware */
+    if( !isSdiEnabled )
+    {
+        spiSfr->SPIxCON.SET = SPI_DISSDI_MASK;
+    }
+    if( !isSdoEnabled )
+    {
+        spiSfr->SPIxCON.SET = SPI_DISSDO_MASK;
+    }
+    /* If Slave mode */
+    if( !isMasterEnabled )
+    {
+        if( isSsEnabled )
+        {
+            spiSfr->SPIxCON.SET = SPI_SSEN_MASK;
+        }
+        /* SS pin selection wasn't provided by user */
+        else
+        {
+            return false;
+        }
+    }
+    
+    /* Other user controllable settings (including fixed ENHBUF setting) */
+    spiSfr->SPIxCON.SET = conWord;
+    
+    /* Bind FIFO routines of selected frame width */
+    ctx->fifoOps = &spiFifoOps[frameWidth];
+    
+    /* Indirect access of "ssMask" structure members of this module */
+    uint32_t *ssMembPtr = (uint32_t *)&ctx->ssMask.pioA;
+    uint8_t ssModuleOffset = 0;
+    uint8_t ssPinPos = 0;
+    
+    /* Reset SS state and mask of this module only */
+    ctx->ssState.pioA = 0;
+    ctx->ssState.pioB = 0;
+    ctx->ssMask.pioA = 0;
+    ctx->ssMask.pioB = 0;
+    
+    /* Configure PPS and PIO */
+    if( isSdiEnabled || isSdoEnabled )
+    {
+        /* Indirect access of structure members */
+        const uint32_t *membPtr = (uint32_t *)&pinSelect;
+        const uint8_t membCount = sizeof(SpiPin_t) / sizeof(uint32_t);
+
+        /* PIO configuration of each valid member */
+        for(uint8_t i = 0; i < membCount; i++, membPtr++)
+        {
+            /* Configure Peripheral Pin Select register (non-GPIO) */
+            PIO_ConfigPpsSfr(*membPtr);
+
+            /* GPIO SS pin digital output pin */
+            if( isMasterEnabled && (membPtr >= &pinSelect.ss1Pin) )
+            {
+                PIO_SetPin(*membPtr);
+                PIO_ConfigGpioPin(*membPtr, PIO_TYPE_DIGITAL, PIO_DIR_OUTPUT);
+                
+                /* If valid GPIO pin, modify SS mask */
+                if( *membPtr & 0xFFFF )
+                {   
+                    ssModuleOffset = (*membPtr >> 28);
+                    ssPinPos = PIO_ReadPinPosition(*membPtr);
+
+                    /* Set a bit in appropriate member */
+                    *(ssMembPtr + ssModuleOffset) |= (1 << ssPinPos);
+                }
+            }
+            /* SDI, SDO (or SSI when in Slave mode) PPS pin */
+            else
+            {
+                PIO_ConfigPpsPin(*membPtr, PIO_TYPE_DIGITAL);
+            }
+        }
+        
+        /* SCK digital pin */
+        if( spiSfr == &SPI1_MODULE )
+        {
+            PIO_ConfigGpioPinType(GPIO_RPB14, PIO_TYPE_DIGITAL);
+        }
+        else
+        {
+            PIO_ConfigGpioPinType(GPIO_RPB15, PIO_TYPE_DIGITAL);
+        }
+    }
+    /* Either SDI or SDO must be enabled for any SPI operation */
+    else
+    {
+        return false;
+    }
+    
+    /* Set baud rate in SPI Master mode (rescaled on clock change) */
+    ctx->sckFreq = 0;
+    if( isMasterEnabled )
+    {
+        spiSfr->SPIxBRG.SET = brgWord;
+        ctx->sckFreq = SpiSckFreqKeep(sckFreq, brgWord);
+        OSC_AddClkHook(SpiClkPreHook, SpiClkPostHook);
+    }
+    
+    /* Dummy buffer read */
+    SPI_DummyRead(spiSfr);
+    
+    /* Interrupt sources cleared, disabled and (sub)priority set */
+    SpiIcConfig(spiSfr);
+    
+    /* Clear the overflow flag */
+    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    
+    /* Enable the module */
+    spiSfr->SPIxCON.SET = SPI_ON_MASK;
+    asm("nop");
+    
+    return true;
+}
+
+
+/*
+ *  Completes Audio or Framed mode configuration: PPS and PIO of SDI, SDO and
+ *  frame sync (SS1) pins, SCK pin, baud rate in Master mode and interrupt
+ *  sources, then enables the module (SPIxCON and SPIxCON2 already set)
+ */
+static void SpiStreamModeApply(SpiContext_t *const ctx, SpiPin_t pinSelect, bool isMasterEnabled, uint32_t sckFreq)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    /* Configure PPS and PIO of SDI, SDO and frame sync (SS1) pins */
+    const uint32_t pinCode[] = { pinSelect.sdiPin,
+                                 pinSelect.sdoPin,
+                                 pinSelect.ss1Pin };
+    
+    for(uint8_t i = 0; i < (sizeof(pinCode) / sizeof(uint32_t)); i++)
+    {
+        if( pinCode[i] )
+        {
+            PIO_ConfigPpsSfr(pinCode[i]);
+            PIO_ConfigPpsPin(pinCode[i], PIO_TYPE_DIGITAL);
+        }
+    }
+    
+    /* SCK digital pin */
+    if( spiSfr == &SPI1_MODULE )
+    {
+        PIO_ConfigGpioPinType(GPIO_RPB14, PIO_TYPE_DIGITAL);
+    }
+    else
+    {
+        PIO_ConfigGpioPinType(GPIO_RPB15, PIO_TYPE_DIGITAL);
+    }
+    
+    /* Set baud rate in SPI Master mode (rescaled on clock change) */
+    ctx->sckFreq = 0;
+    if( isMasterEnabled )
+    {
+        uint32_t brgWord = SpiBaudRateGet(sckFreq);
+        
+        spiSfr->SPIxBRG.SET = brgWord;
+        ctx->sckFreq = SpiSckFreqKeep(sckFreq, brgWord);
+        OSC_AddClkHook(SpiClkPreHook, SpiClkPostHook);
+    }
+    
+    /* Dummy buffer read */
+    SPI_DummyRead(spiSfr);
+    
+    /* Interrupt sources cleared, disabled and (sub)priority set */
+    SpiIcConfig(spiSfr);
+    
+    /* Clear the overflow flag */
+    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    
+    /* Enable the module */
+    spiSfr->SPIxCON.SET = SPI_ON_MASK;
+    asm("nop");
+}
+
+
+/*
+ *  Returns true if module is in Audio Protocol Interface or Framed mode, in
+ *  which SCK runs continuously (Master mode)
+ */
+static INLINE bool SpiIsClkContinuous(SpiSfr_t *const spiSfr)
+{
+    return (spiSfr->SPIxCON2.W & SPI_AUDEN_MASK) || (spiSfr->SPIxCON.W & SPI_FRMEN_MASK);
+}
+
+
+/*
+ *  Returns SPIxBRG value of SPI Master mode closest to given SCK frequency
+ */
+static INLINE uint32_t SpiBaudRateGet(uint32_t sckFreq)
+{
+    /* Peripheral bus frequency */
+    uint32_t pbFreq = OSC_GetPbFreq();
+    
+    uint32_t baudRate;
+    
+    /* Slowest setting if no frequency given */
+    if( sckFreq == 0 )
+    {
+        baudRate = 511;
+    }
+    /* Max. F_sck is PBCLK/2 */
+    else if( sckFreq >= pbFreq )
+    {
+        baudRate = 0;
+    }
+    /* Highest SCK frequency not above requested one (as SPI_BRG_VALUE()) */
+    else
+    {
+        baudRate = SPI_BRG_VALUE(pbFreq, sckFreq);
+    }
+    
+    /* Max. baud rate value is 511 (slowest setting) */
+    if( baudRate > 511 )
+    {
+        baudRate = 511;
+    }
+    
+    return baudRate;
+}
+
+
+/*
+ *  Returns SCK frequency kept for rescaling on clock change: requested one, or
+ *  achieved one rounded up if not known (maps back to the same SPIxBRG)
+ */
+static INLINE uint32_t SpiSckFreqKeep(uint32_t sckFreq, uint32_t brgWord)
+{
+    if( sckFreq != 0 )
+    {
+        return sckFreq;
+    }
+    
+    uint32_t sckDiv = 2 * (brgWord + 1);
+    
+    return (OSC_GetPbFreq() + sckDiv - 1) / sckDiv;
+}
+
+
+/*
+ *  Waits until frame in progress is shifted out by SPI Master modules, so that
+ *  no frame is clocked during clock change (Audio and Framed mode clock
+ *  continuously)
+ */
+static void SpiClkPreHook(const OscClkState_t *const statePtr)
+{
+    (void)statePtr;
+    
+    for(uint8_t i = 0; i < (sizeof(spiCtx) / sizeof(SpiContext_t)); i++)
+    {
+        SpiSfr_t *const spiSfr = spiCtx[i].spiSfr;
+        
+        if( (spiCtx[i].sckFreq != 0) && !SpiIsClkContinuous(spiSfr) )
+        {
+            while( spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK );
+        }
+    }
+}
+
+
+/*
+ *  Recomputes SPIxBRG of SPI Master modules from new PBCLK
+ */
+static void SpiClkPostHook(const OscClkState_t *const statePtr)
+{
+    (void)statePtr;
+    
+    for(uint8_t i = 0; i < (sizeof(spiCtx) / sizeof(SpiContext_t)); i++)
+    {
+        if( spiCtx[i].sckFreq != 0 )
+        {
+            spiCtx[i].spiSfr->SPIxBRG.W = SpiBaudRateGet(spiCtx[i].sckFreq);
+        }
+    }
+}
+
+
+/*
+ *  Clears, disables and sets (sub)priority of SPI interrupt sources
+ */
+static INLINE void SpiIcConfig(SpiSfr_t *const spiSfr)
+{
+    /* Multi-vector interrupt mode */
+    icSfr->ICxINTCON.SET = IC_MVEC_MASK;
+
+    /* Interrupt sources for SPI1 */
+    if( spiSfr == &SPI1_MODULE )
+    {
+        icSfr->ICxIFS1.CLR = (IC_SPI1EIF_MASK | IC_SPI1RXIF_MASK | IC_SPI1TXIF_MASK);                   // Clear flags
+        icSfr->ICxIPC7.CLR = (IC_SPI1IP_MASK | IC_SPI1IS_MASK);                                         // Clear (sub)priority
+        icSfr->ICxIPC7.SET = ( (SPI1_ICX_IPL << IC_SPI1IP_POS) | (SPI1_ICX_ISL << IC_SPI1IS_POS) );     // Set (sub)priority
+        icSfr->ICxIEC1.CLR = (IC_SPI1EIE_MASK | IC_SPI1RXIE_MASK | IC_SPI1TXIE_MASK);                   // Disable sources
+    }
+    /* Interrupt sources for SPI2 */
+    else if ( spiSfr == &SPI2_MODULE )
+    {
+        icSfr->ICxIFS1.CLR = (IC_SPI2EIF_MASK | IC_SPI2RXIF_MASK | IC_SPI2TXIF_MASK);
+        icSfr->ICxIPC9.CLR = (IC_SPI2IP_MASK | IC_SPI2IS_MASK);
+        icSfr->ICxIPC9.SET = ( (SPI2_ICX_IPL << IC_SPI2IP_POS) | (SPI2_ICX_ISL << IC_SPI2IS_POS) );
+        icSfr->ICxIEC1.CLR = (IC_SPI2EIE_MASK | IC_SPI2RXIE_MASK | IC_SPI2TXIE_MASK);
+    }
+    else {}
+}
+
+
+/*
+ *  Checks common Master mode conditions before transfer is started
+ *  Returns false if any input restriction is triggered
+ */
+static INLINE bool SpiMasterCheck(SpiContext_t *const ctx)
+{
+    /* Number of active slaves must be positive */
+    if( (ctx->ssState.pioA == 0) && (ctx->ssState.pioB == 0) )
+    {
+        return false;
+    }
+    
+    /* Proceed only if Master mode is enabled */
+    if( !(ctx->spiSfr->SPIxCON.W & SPI_MSTEN_MASK) )
+    {
+        return false;
+    }
+    
+    /* One SPI activity at a time check */
+    if( SPI_IsSpiBusy(ctx->spiSfr) )
+    {
+        return false;
+    }
+    
+    /* Module must be configured (FIFO routines bound) */
+    if( ctx->fifoOps == NULL )
+    {
+        return false;
+    }
+    
+    return true;
+}
+
+
+/*
+ *  Sets single TX/RX data packet in module context
+ */
+static INLINE void SpiPacketSet(SpiContext_t *const ctx, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize)
+{
+    /* Dummy write/read if pointer NULL */
+    ctx->txFill = ctx->fifoOps->fill[txPtr == NULL];
+    ctx->rxDrain = ctx->fifoOps->drain[rxPtr == NULL];
+    
+    ctx->txDataPtr = txPtr;
+    ctx->txDataSize = txSize;
+    ctx->rxDataPtr = rxPtr;
+    ctx->rxDataSize = txSize;
+    
+    /* No further segments */
+    ctx->txSegCount = 0;
+    ctx->rxSegCount = 0;
+}
+
+
+/*
+ *  Sets scatter-gather TX/RX segments in module context
+ *  Returns false if there is no data to be transferred
+ */
+static INLINE bool SpiPacketSetSg(SpiContext_t *const ctx, const SpiSegment_t *segPtr, uint32_t segCount)
+{
+    /* Segment array check */
+    if( (segPtr == NULL) || (segCount == 0) )
+    {
+        return false;
+    }
+    
+    /* First segment is loaded by SpiTx/RxSegmentNext() */
+    ctx->txDataSize = 0;
+    ctx->rxDataSize = 0;
+    ctx->txSegPtr = segPtr;
+    ctx->rxSegPtr = segPtr;
+    ctx->txSegCount = segCount;
+    ctx->rxSegCount = segCount;
+    
+    /* Packet size check (all segments empty) */
+    if( !SpiTxSegmentNext(ctx) )
+    {
+        return false;
+    }
+    SpiRxSegmentNext(ctx);
+    
+    return true;
+}
+
+
+/*
+ *  Executes polling-based Master transmission of packet set in module context
+ *  Returns false if any input restriction is triggered
+ */
+static bool SpiMasterReadWritePoll(SpiContext_t *const ctx)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    /* Read RX FIFO until empty */
+    SPI_DummyRead(spiSfr);
+    
+    /* Obtain old interrupt status and disable interrupts */
+    ctx->intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Ensure atomic operation for SPIxBUF
+    
+    /* Enable appropriate Slave Select pins */
+    SpiSsAssert(ctx);
+    
+    /* Write data frame packet (routines bound to frame width) */
+    do{
+        SpiWrite(ctx);
+        
+        /* Wait until SPI bus free */
+        while( (spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) >> SPI_SPIBUSY_POS );
+        
+        SpiRead(ctx);
+        
+    } while( SpiTxSegmentNext(ctx) );
+    
+    /* Disable appropriate Slave Select pins */
+    SpiSsRelease(ctx);
+    
+    /* Restore interrupt state */
+    IC_SetInterruptState(ctx->intrStatus);
+    
+    return true;
+}
+
+
+/*
+ *  Starts interrupt-based Master transmission of packet set in module context
+ *  (shared by SPI_MasterWrite(), SPI_MasterWrite2() and SPI_MasterWriteSg(),
+ *  ISR handlers must be configured beforehand)
+ *  Returns false if any input restriction is triggered
+ */
+static bool SpiMasterWriteStart(SpiContext_t *const ctx)
+{
+    /* Enable appropriate Slave Select pins */
+    SpiSsAssert(ctx);
+    
+    /* Load first part of packet and enable TX source */
+    SpiMasterWriteLoad(ctx);
+    
+    return true;
+}
+
+
+/*
+ *  Loads TX FIFO with first part of packet and enables TX interrupt source
+ *  (packet data must be set in context and Slave device enabled beforehand)
+ */
+static INLINE void SpiMasterWriteLoad(SpiContext_t *const ctx)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    /* Read RX FIFO until empty */
+    SPI_DummyRead(spiSfr);
+    
+    /* TX and RX interrupt flag trigger setting */
+    spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK;       // TX flag set on last SPISR transfer
     
-    /* RX data is handled by private variables */
-    rxDataPtr = rxPtr;
+    /* Obtain old interrupt status and disable interrupts */
+    ctx->intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Ensure atomic operation for SPIxBUF
     
-    SpiFrameWidth_t frameWidth = (spiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
+    /* Write N-bit wide data frame packet */
+    SpiWrite(ctx);
     
-    /* Read N-bit wide data frame packet */
-    if( frameWidth == SPI_WIDTH_8BIT )
-    {
-        SpiRead8();
-    }
-    else if( frameWidth == SPI_WIDTH_16BIT)
-    {
-        SpiRead16();
-    }
-    else if( frameWidth == SPI_WIDTH_32BIT )
-    {
-        SpiRead32();
-    }
-    /* Out of range "MODE" SFR value */
-    else
+    /* Clear TX flag only if transfer is still in progress */
+    if( spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK )
     {
-        return false;
+        icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
     }
+    icSfr->ICxIEC1.SET = ctx->ic.spiTxIe;    // TX source enabled
     
-    return true;
+    /* Restore interrupt state */
+    IC_SetInterruptState(ctx->intrStatus);
 }
 
 
-/******************************************************************************/
-/*------------------------Local Function Definitions--------------------------*/
-/******************************************************************************/
-
 /*
- *  Write 8-bit data to SPI TX FIFO
+ *  Starts the oldest transaction in queue of given context
  */
-static INLINE void SpiWrite8(void)
+static void SpiJobStart(SpiContext_t *const ctx)
 {
-    uint32_t tempSize;
+    SpiJob_t *const job = &ctx->queue[ctx->queueTail];
     
-    /* Load only maximum amount of bytes to TX FIFO */
-    tempSize = (txDataSize > 16) ? 16 : txDataSize;
-    txDataSize -= tempSize;
+    /* Frame width and FIFO routines of job */
+    SpiFrameModeSet(ctx, (job->frameWidth << SPI_MODE_POS), &spiFifoOps[job->frameWidth]);
     
-    /* Dummy write */
-    if( isDummyWrite )
-    {
-        while( tempSize-- )
-        {
-            isrSpiSfr->SPIxBUF.W = dummyTxData;
-        }
-    }
-    /* Normal write */
-    else
+    /* TX/RX data and size are handled by module context */
+    SpiPacketSet(ctx, job->rxPtr, job->txPtr, job->txSize);
+    
+    /* Use queue TX handler */
+    IsrHandlerPtrConfig(ctx, ISR_SPI_MODE_2);
+    
+    /* Enable job's Slave device */
+    SpiSsAssertPin(ctx, job->ssPin);
+    
+    /* Load first part of packet and enable TX source */
+    SpiMasterWriteLoad(ctx);
+}
+
+
+/*
+ *  Sets frame width (SPIxCON.MODE bits) and binds FIFO routines of it
+ */
+static void SpiFrameModeSet(SpiContext_t *const ctx, uint32_t modeBits, const SpiFifoOps_t *fifoOps)
+{
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    /* Frame width can only be changed while module is disabled */
+    if( (spiSfr->SPIxCON.W & SPI_MODE_MASK) != modeBits )
     {
-        while( tempSize-- )
-        {
-            isrSpiSfr->SPIxBUF.W = *((uint8_t *)txDataPtr);
-            txDataPtr = (uint8_t *)txDataPtr + 1;
-        }
+        spiSfr->SPIxCON.CLR = SPI_ON_MASK;
+        asm("nop");
+        spiSfr->SPIxCON.CLR = SPI_MODE_MASK;
+        spiSfr->SPIxCON.SET = modeBits;
+        spiSfr->SPIxCON.SET = SPI_ON_MASK;
+        asm("nop");
     }
+    
+    ctx->fifoOps = fifoOps;
 }
 
 
 /*
- *  Write 16-bit data to SPI TX FIFO
+ *  ISR TX handler for SPI_MasterWrite()
  */
-static INLINE void SpiWrite16(void)
+static void ISR_SpiTxHandler_MasterWrite(SpiContext_t *const ctx)
 {
-    uint32_t tempSize;
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
     
-    /* Load only maximum amount of bytes to TX FIFO */
-    tempSize = (txDataSize > 8) ? 8 : txDataSize;
-    txDataSize -= tempSize;
+    /* Wait if RX FIFO is still being loaded */
+    while( spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK );
+    
+    /* Disable Slave devices before Master handles RX data */
+    if( !SpiTxSegmentNext(ctx) )
+    {
+        SpiSsRelease(ctx);
+    }
+
+    /* Read N-bit wide data frame packet */
+    SpiRead(ctx);
 
-    /* Dummy write */
-    if( isDummyWrite )
+    /* More data needs to be transmitted */
+    if( SpiTxSegmentNext(ctx) )
     {
-        while( tempSize-- )
+        /* Ensure atomic operation for SPIxBUF */
+        IC_DisableInterrupts();
+        
+        /* Write N-bit wide data frame packet */
+        SpiWrite(ctx);
+
+        /* Clear TX flag only if transfer still in progress */
+        if( spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK )
         {
-            isrSpiSfr->SPIxBUF.W = dummyTxData;
+            icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
         }
+        
+        /* Enable interrupts */
+        IC_EnableInterrupts();
     }
-    /* Normal write */
+    /* Transmission is complete */
     else
     {
-        while( tempSize-- )
-        {
-            isrSpiSfr->SPIxBUF.W = *((uint16_t *)txDataPtr);
-            txDataPtr = (uint16_t *)txDataPtr + 1;
-        }
+        /* Disable TX interrupt source */
+        icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
+        icSfr->ICxIEC1.CLR = ctx->ic.spiTxIe;
+        
+        /* Restore interrupt state */
+        IC_SetInterruptState(ctx->intrStatus);
     }
 }
 
 
 /*
- *  Write 32-bit data to SPI TX FIFO
+ *  ISR TX handler for SPI_MasterWrite()
  */
-static INLINE void SpiWrite32(void)
+static void ISR_SpiRxHandler_MasterWrite(SpiContext_t *const ctx)
 {
-    uint32_t tempSize;
+    /* All data handled in TX handler */
+    (void)ctx;
+}
+
+
+/*
+ *  ISR TX handler for SPI_MasterWrite2()
+ */
+static void ISR_SpiTxHandler_MasterWrite2(SpiContext_t *const ctx)
+{
+    /* Same TX handler as for the original MasterReadOnly */
+    ISR_SpiTxHandler_MasterWrite(ctx);
     
-    /* Load only maximum amount of bytes to TX FIFO */
-    tempSize = (txDataSize > 4) ? 4 : txDataSize;
-    txDataSize -= tempSize;
+    /* Additional function */
+    ctx->isrExtraHandlerPtr();
+}
 
-    /* Dummy write */
-    if( isDummyWrite )
-    {
-        while( tempSize-- )
-        {
-            isrSpiSfr->SPIxBUF.W = dummyTxData;
-        }
-    }
-    /* Normal write */
-    else
-    {
-        while( tempSize-- )
-        {
-            isrSpiSfr->SPIxBUF.W = *((uint32_t *)txDataPtr);
-            txDataPtr = (uint32_t *)txDataPtr + 1;
-        }
-    }
+
+/*
+ *  ISR RX handler for SPI_MasterWrite2()
+ */
+static void ISR_SpiRxHandler_MasterWrite2(SpiContext_t *const ctx)
+{
+    /* All data handled in TX handler */
+    (void)ctx;
 }
 
 
 /*
- *  Read 8-bit data from SPI RX FIFO
+ *  ISR TX handler for SPI_QueueJob()
  */
-static INLINE void SpiRead8(void)
+static void ISR_SpiTxHandler_Queue(SpiContext_t *const ctx)
 {
-    /* Dummy read */
-    if( isDummyRead )
+    /* Last part of packet was loaded during previous interrupt */
+    bool isJobDone = !SpiTxSegmentNext(ctx);
+    
+    /* Same TX handler as for the original MasterWrite */
+    ISR_SpiTxHandler_MasterWrite(ctx);
+    
+    if( isJobDone )
     {
-        do
+        void (*isrHandler)(void) = ctx->queue[ctx->queueTail].isrHandler;
+        
+        /* Remove finished job from queue */
+        ctx->queueTail = (ctx->queueTail + 1) % SPI_QUEUE_SIZE;
+        ctx->queueCount--;
+        
+        /* Chain next job without returning to main loop */
+        if( ctx->queueCount != 0 )
         {
-            dummyRxData = isrSpiSfr->SPIxBUF.W;
+            SpiJobStart(ctx);
         }
-        while( !(isrSpiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) );
-    }
-    /* Normal read */
-    else
-    {
-        do
+        /* Queue drained: frame width of configured mode */
+        else
+        {
+            SpiFrameModeSet(ctx, ctx->queueModeBits, ctx->queueFifoOps);
+        }
+        
+        /* Job completion function */
+        if( isrHandler != NULL )
         {
-            *((uint8_t *)rxDataPtr) = isrSpiSfr->SPIxBUF.W;
-            rxDataPtr = (uint8_t *)rxDataPtr + 1;
+            isrHandler();
         }
-        while( !(isrSpiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) );
     }
 }
 
 
 /*
- *  Read 16-bit data from SPI RX FIFO
+ *  ISR TX handler for SPI_MasterReadWriteAsync()
  */
-static INLINE void SpiRead16(void)
+static void ISR_SpiTxHandler_Async(SpiContext_t *const ctx)
 {
-    /* Dummy read */
-    if( isDummyRead )
-    {
-        do
-        {
-            dummyRxData = isrSpiSfr->SPIxBUF.W;
-        }
-        while( !(isrSpiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) );
-    }
-    /* Normal read */
-    else
+    /* Last part of packet has been loaded to TX FIFO before this interrupt */
+    bool isXferDone = !SpiTxSegmentNext(ctx);
+    
+    /* Same TX handler as for the original MasterReadOnly */
+    ISR_SpiTxHandler_MasterWrite(ctx);
+    
+    /* Complete handle (RX data already read) */
+    if( isXferDone )
     {
-        do
+        SpiXfer_t *const xferPtr = ctx->xferPtr;
+        ctx->xferPtr = NULL;
+        
+        xferPtr->isDone = true;
+        
+        /* User-defined function (optional) */
+        if( xferPtr->isrHandler != NULL )
         {
-            *((uint16_t *)rxDataPtr) = isrSpiSfr->SPIxBUF.W;
-            rxDataPtr = (uint16_t *)rxDataPtr + 1;
+            xferPtr->isrHandler();
         }
-        while( !(isrSpiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) );
     }
 }
 
 
 /*
- *  Read 32-bit data from SPI RX FIFO
+ *  ISR TX handler for SPI_StartAudioStream() (also drains RX FIFO)
  */
-static INLINE void SpiRead32(void)
+static void ISR_SpiTxHandler_Audio(SpiContext_t *const ctx)
 {
-    /* Dummy read */
-    if( isDummyRead )
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint32_t fifoFree;
+    uint32_t tempSize;
+    
+    /* Read RX data, continue with other half once current one is filled */
+    while( !(spiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) )
     {
-        do
+        tempSize = (spiSfr->SPIxSTAT.W & SPI_RXBUFELM_MASK) >> SPI_RXBUFELM_POS;
+        tempSize = (tempSize > ctx->rxDataSize) ? ctx->rxDataSize : tempSize;
+        ctx->rxDataSize -= tempSize;
+        ctx->rxDrain(ctx, tempSize);
+        
+        if( ctx->rxDataSize == 0 )
         {
-            dummyRxData = isrSpiSfr->SPIxBUF.W;
+            ctx->rxHalfCount++;
+            ctx->rxDataPtr = ctx->rxHalfPtr[ctx->rxHalfCount & 1];
+            ctx->rxDataSize = ctx->halfSize;
         }
-        while( !(isrSpiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) );
     }
-    /* Normal read */
-    else
+    
+    /* Ensure atomic operation for SPIxBUF */
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();
+    
+    /* Fill TX FIFO, continue with other half without gap */
+    fifoFree = ctx->fifoOps->fifoDepth - ((spiSfr->SPIxSTAT.W & SPI_TXBUFELM_MASK) >> SPI_TXBUFELM_POS);
+    
+    while( fifoFree != 0 )
     {
-        do
+        tempSize = (ctx->txDataSize > fifoFree) ? fifoFree : ctx->txDataSize;
+        ctx->txDataSize -= tempSize;
+        fifoFree -= tempSize;
+        ctx->txFill(ctx, tempSize);
+        
+        if( ctx->txDataSize == 0 )
         {
-            *((uint32_t *)rxDataPtr) = isrSpiSfr->SPIxBUF.W;
-            rxDataPtr = (uint32_t *)rxDataPtr + 1;
+            ctx->txHalfCount++;
+            ctx->txDataPtr = ctx->txHalfPtr[ctx->txHalfCount & 1];
+            ctx->txDataSize = ctx->halfSize;
         }
-        while( !(isrSpiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) );
     }
-}
-
-
-/*
- *  Sets interrupt IE and IF masks for accessing proper
- *  bit fields in the IC related SFRs (bit masks depend on SPI module selected)
- */
-static INLINE bool SpiInterruptMaskSet(SpiSfr_t * spiSfr)
-{
-    if( isrSpiSfr == &SPI1_MODULE )
+    
+    icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
+    
+    /* Restore interrupt state */
+    IC_SetInterruptState(intrStatus);
+    
+    /* Half is done once each streamed direction is done with it (full-duplex
+     * half is refilled and processed only after its RX data has arrived) */
+    uint32_t doneCount = ctx->rxHalfCount;
+    
+    if( ctx->rxHalfPtr[0] == NULL )
     {
-        ic.spiTxIe = IC_SPI1TXIE_MASK;
-        ic.spiRxIe = IC_SPI1RXIE_MASK;
-        ic.spiTxIf = IC_SPI1TXIF_MASK;
-        ic.spiRxIf = IC_SPI1RXIF_MASK;
+        doneCount = ctx->txHalfCount;
     }
-    else if( isrSpiSfr == &SPI2_MODULE )
+    else if( (ctx->txHalfPtr[0] != NULL) && ((int32_t)(ctx->txHalfCount - doneCount) < 0) )
     {
-        ic.spiTxIe = IC_SPI2TXIE_MASK;
-        ic.spiRxIe = IC_SPI2RXIE_MASK;
-        ic.spiTxIf = IC_SPI2TXIF_MASK;
-        ic.spiRxIf = IC_SPI2RXIF_MASK;
+        doneCount = ctx->txHalfCount;
     }
-    /* SPI base address check */
-    else
+    
+    while( ctx->doneHalfCount != doneCount )
     {
-        return false;
+        if( ctx->isrHalfHandlerPtr != NULL )
+        {
+            ctx->isrHalfHandlerPtr(ctx->doneHalfCount & 1);
+        }
+        ctx->doneHalfCount++;
     }
-    
-    return true;
 }
 
 
 /*
- *  Configures TX and RX ISR handler function pointers
+ *  ISR error handler for SPI_StartAudioStream() (counts underruns and overruns)
  */
-static INLINE void IsrHandlerPtrConfig(IsrSpiMode_t isrMode)
+static void ISR_SpiErrHandler_Audio(SpiContext_t *const ctx)
 {
-    switch( isrMode )
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint32_t status = spiSfr->SPIxSTAT.W;
+    
+    if( status & SPI_SPITUR_MASK )
     {
-        /* Standard Master mode transmission */
-        case ISR_SPI_MODE_0:
-            isrTxHandlerPtr = ISR_SpiTxHandler_MasterWrite;
-            isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite;
-            break;
-        /* Standard Master mode transmission with extra function at the end */
-        case ISR_SPI_MODE_1:
-            isrTxHandlerPtr = ISR_SpiTxHandler_MasterWrite2;
-            isrRxHandlerPtr = ISR_SpiRxHandler_MasterWrite2;
-            break;
-        /* Non-valid input */
-        default:
-            break;
+        ctx->underrunCount++;
     }
+    if( status & SPI_SPIROV_MASK )
+    {
+        ctx->overrunCount++;
+    }
+    
+    /* Clear error flags */
+    spiSfr->SPIxSTAT.CLR = SPI_SPITUR_MASK | SPI_SPIROV_MASK;
+    icSfr->ICxIFS1.CLR = ctx->ic.spiEIf;
 }
 
 
 /*
- *  ISR TX handler for SPI_MasterWrite()
+ *  ISR TX and RX handler for SPI_MasterWriteStream()
  */
-static void ISR_SpiTxHandler_MasterWrite(void)
+static void ISR_SpiHandler_Stream(SpiContext_t *const ctx)
 {
-    /* Wait if RX FIFO is still being loaded */
-    while( isrSpiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK );
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    uint32_t fifoUsed;
+    
+    /* Drain RX FIFO first to make room for frames being loaded */
+    SpiRead(ctx);
+    icSfr->ICxIFS1.CLR = ctx->ic.spiRxIf;
     
-    /* Disable Slave devices before Master handles RX data */
-    if( txDataSize == 0 )
-    {
-        pioSfrA->PIOxLAT.SET = ssState.pioA;
-        pioSfrB->PIOxLAT.SET = ssState.pioB;
-    }
-
-    SpiFrameWidth_t frameWidth = (isrSpiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
-
-    /* Read N-bit wide data frame packet */
-    if( frameWidth == SPI_WIDTH_8BIT )
-    {
-        SpiRead8();
-    }
-    else if( frameWidth == SPI_WIDTH_16BIT)
-    {
-        SpiRead16();
-    }
-    else if( frameWidth == SPI_WIDTH_32BIT )
-    {
-        SpiRead32();
-    }
-    /* Out of range "MODE" SFR value */
-    else {}
-
     /* More data needs to be transmitted */
-    if( txDataSize != 0 )
+    if( SpiTxSegmentNext(ctx) )
     {
         /* Ensure atomic operation for SPIxBUF */
         IC_DisableInterrupts();
         
-        /* Write N-bit wide data frame packet */
-        if( frameWidth == SPI_WIDTH_8BIT )
-        {
-            SpiWrite8();
-        }
-        else if( frameWidth == SPI_WIDTH_16BIT)
-        {
-            SpiWrite16();
-        }
-        else if( frameWidth == SPI_WIDTH_32BIT )
+        /* Frames in TX FIFO, shift register and RX FIFO must fit RX FIFO */
+        fifoUsed = ((spiSfr->SPIxSTAT.W & SPI_TXBUFELM_MASK) >> SPI_TXBUFELM_POS) +
+                   ((spiSfr->SPIxSTAT.W & SPI_RXBUFELM_MASK) >> SPI_RXBUFELM_POS) + 1;
+        
+        if( fifoUsed < ctx->fifoOps->fifoDepth )
         {
-            SpiWrite32();
+            SpiWriteUpTo(ctx, ctx->fifoOps->fifoDepth - fifoUsed);
         }
-        /* Out of range "MODE" SFR value */
-        else {}
-
-        /* Clear TX flag only if transfer still in progress */
-        if( isrSpiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK )
+        
+        /* Whole packet loaded, remaining frames are drained one by one */
+        if( !SpiTxSegmentNext(ctx) )
         {
-            icSfr->ICxIFS1.CLR = ic.spiTxIf;
+            spiSfr->SPIxCON.CLR = SPI_SRXISEL_MASK;
+            spiSfr->SPIxCON.SET = (SPI_SRXISEL_INTR_WHEN_BUFF_NOT_EMPTY << SPI_SRXISEL_POS);
+            icSfr->ICxIEC1.CLR = ctx->ic.spiTxIe;
         }
+        icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
         
         /* Enable interrupts */
         IC_EnableInterrupts();
     }
-    /* Transmission is complete */
-    else
+    /* Transmission is complete once all RX data is read */
+    else if( !SpiRxSegmentNext(ctx) )
     {
-        /* Disable TX interrupt source */
-        icSfr->ICxIFS1.CLR = ic.spiTxIf;
-        icSfr->ICxIEC1.CLR = ic.spiTxIe;
+        /* Disable Slave devices */
+        SpiSsRelease(ctx);
         
-        /* Restore interrupt state */
-        IC_SetInterruptState(intrStatus);
+        /* Disable TX and RX interrupt sources */
+        icSfr->ICxIEC1.CLR = ctx->ic.spiTxIe | ctx->ic.spiRxIe;
+        icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf | ctx->ic.spiRxIf;
+        
+        /* Default TX and RX interrupt flag trigger setting */
+        spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK | SPI_SRXISEL_MASK;
+        
+        ctx->isStreaming = false;
+        
+        /* User-defined function (optional) */
+        if( ctx->isrExtraHandlerPtr != NULL )
+        {
+            ctx->isrExtraHandlerPtr();
+        }
     }
+    else {}
 }
 
 
 /*
- *  ISR TX handler for SPI_MasterWrite()
+ *  ISR RX handler for SPI_StartSlaveRing()
  */
-static void ISR_SpiRxHandler_MasterWrite(void)
+static void ISR_SpiRxHandler_SlaveRing(SpiContext_t *const ctx)
 {
-    /* All data handled in TX handler */
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    const uint32_t ringSize = ctx->ringMask + 1;
+    uint32_t head = ctx->ringHead;
+    uint32_t tempSize;
+    uint32_t freeSize;
+    
+    /* Frames lost in RX FIFO before ISR was serviced */
+    if( spiSfr->SPIxSTAT.W & SPI_SPIROV_MASK )
+    {
+        ctx->ringOverrunCount++;
+        spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    }
+    
+    while( !(spiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) )
+    {
+        tempSize = (spiSfr->SPIxSTAT.W & SPI_RXBUFELM_MASK) >> SPI_RXBUFELM_POS;
+        freeSize = ringSize - (head - ctx->ringTail);
+        
+        /* Ring buffer full, frames are dropped */
+        if( freeSize == 0 )
+        {
+            ctx->ringOverrunCount += tempSize;
+            ctx->fifoOps->drain[1](ctx, tempSize);
+            continue;
+        }
+        
+        /* Only contiguous free space up to ring buffer wrap */
+        if( freeSize > (ringSize - (head & ctx->ringMask)) )
+        {
+            freeSize = ringSize - (head & ctx->ringMask);
+        }
+        tempSize = (tempSize > freeSize) ? freeSize : tempSize;
+        
+        ctx->rxDataPtr = (uint8_t *)ctx->ringPtr + (head & ctx->ringMask) * ctx->fifoOps->frameSize;
+        ctx->fifoOps->drain[0](ctx, tempSize);
+        
+        /* Publish frames to consumer only after they are stored */
+        head += tempSize;
+        ctx->ringHead = head;
+    }
+    
+    icSfr->ICxIFS1.CLR = ctx->ic.spiRxIf;
 }
 
 
 /*
- *  ISR TX handler for SPI_MasterWrite2()
+ *  ISR DMA handler for SPI_MasterWriteDma() (executed once per packet)
  */
-static void ISR_SpiTxHandler_MasterWrite2(void)
+static void ISR_SpiDmaHandler_MasterWrite(void)
 {
-    /* Same TX handler as for the original MasterReadOnly */
-    ISR_SpiTxHandler_MasterWrite();
+    SpiContext_t *const ctx = dmaCtx;
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
     
-    /* Additional function */
-    isrExtraHandlerPtr();
+    /* Release both DMA channels */
+    DmaChannelReset(dmaRxSfr);
+    DmaChannelReset(dmaTxSfr);
+    icSfr->ICxIEC1.CLR = (IC_DMA0IE_MASK | IC_DMA1IE_MASK);
+    icSfr->ICxIFS1.CLR = (IC_DMA0IF_MASK | IC_DMA1IF_MASK);
+    
+    /* TX flag set on last SPISR transfer (up to TX FIFO depth plus one frames
+     * may still be shifted out after TX channel is done) */
+    spiSfr->SPIxCON.CLR = SPI_STXISEL_MASK | SPI_SRXISEL_MASK;
+    icSfr->ICxIFS1.CLR = ctx->ic.spiTxIf;
+    
+    /* Flag is set by software if shifting already finished */
+    if( !(spiSfr->SPIxSTAT.W & SPI_SPIBUSY_MASK) )
+    {
+        icSfr->ICxIFS1.SET = ctx->ic.spiTxIf;
+    }
+    icSfr->ICxIEC1.SET = ctx->ic.spiTxIe;
 }
 
 
 /*
- *  ISR RX handler for SPI_MasterWrite2()
+ *  ISR TX handler for SPI_MasterWriteDma() (last frame shifted out)
  */
-static void ISR_SpiRxHandler_MasterWrite2(void)
+static void ISR_SpiTxHandler_Dma(SpiContext_t *const ctx)
 {
-    /* All data handled in TX handler */
+    SpiSfr_t *const spiSfr = ctx->spiSfr;
+    
+    /* Disable TX interrupt source */
+    icSfr->ICxIEC1.CLR = ctx->ic.spiTxIe;
+    
+    /* Disable Slave devices */
+    SpiSsRelease(ctx);
+    
+    /* Drop remaining RX data */
+    SPI_DummyRead(spiSfr);
+    spiSfr->SPIxSTAT.CLR = SPI_SPIROV_MASK;
+    icSfr->ICxIFS1.CLR = (ctx->ic.spiTxIf | ctx->ic.spiRxIf);
+    
+    dmaCtx = NULL;
+    
+    /* Completion function */
+    if( ctx->isrExtraHandlerPtr != NULL )
+    {
+        ctx->isrExtraHandlerPtr();
+    }
 }
 
 
@@ -1158,16 +3091,24 @@ static void ISR_SpiRxHandler_MasterWrite2(void)
  */
 void __ISR(SPI_1_VECTOR, SPI1_ISR_IPL) ISR_Spi1(void)
 {
+    SpiContext_t *const ctx = &spiCtx[0];
+    
     /* RX Interrupt */
     if( (icSfr->ICxIEC1.W & IC_SPI1RXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1RXIF_MASK) )
     {   
-        isrRxHandlerPtr();
+        ctx->isrRxHandlerPtr(ctx);
     }
 
     /* TX Interrupt */
     if( (icSfr->ICxIEC1.W & IC_SPI1TXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1TXIF_MASK) )
     {
-        isrTxHandlerPtr();
+        ctx->isrTxHandlerPtr(ctx);
+    }
+    
+    /* Error Interrupt */
+    if( (icSfr->ICxIEC1.W & IC_SPI1EIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI1EIF_MASK) )
+    {
+        ctx->isrErrHandlerPtr(ctx);
     }
 }
 
@@ -1177,15 +3118,47 @@ void __ISR(SPI_1_VECTOR, SPI1_ISR_IPL) ISR_Spi1(void)
  */
 void __ISR(SPI_2_VECTOR, SPI2_ISR_IPL) ISR_Spi2(void)
 {
+    SpiContext_t *const ctx = &spiCtx[1];
+    
     /* RX Interrupt */
     if( (icSfr->ICxIEC1.W & IC_SPI2RXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2RXIF_MASK) )
     {
-        isrRxHandlerPtr();
+        ctx->isrRxHandlerPtr(ctx);
     }
 
     /* TX Interrupt */
     if( (icSfr->ICxIEC1.W & IC_SPI2TXIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2TXIF_MASK) )
     {
-        isrTxHandlerPtr();
+        ctx->isrTxHandlerPtr(ctx);
+    }
+    
+    /* Error Interrupt */
+    if( (icSfr->ICxIEC1.W & IC_SPI2EIE_MASK) && (icSfr->ICxIFS1.W & IC_SPI2EIF_MASK) )
+    {
+        ctx->isrErrHandlerPtr(ctx);
+    }
+}
+
+
+/*
+ *  ISR for DMA channel 0 (RX channel of SPI DMA-based transfer)
+ */
+void __ISR(DMA_0_VECTOR, SPI_DMA_ISR_IPL) ISR_SpiDmaRx(void)
+{
+    if( (icSfr->ICxIEC1.W & IC_DMA0IE_MASK) && (icSfr->ICxIFS1.W & IC_DMA0IF_MASK) )
+    {
+        ISR_SpiDmaHandler_MasterWrite();
+    }
+}
+
+
+/*
+ *  ISR for DMA channel 1 (TX channel of SPI DMA-based transfer)
+ */
+void __ISR(DMA_1_VECTOR, SPI_DMA_ISR_IPL) ISR_SpiDmaTx(void)
+{
+    if( (icSfr->ICxIEC1.W & IC_DMA1IE_MASK) && (icSfr->ICxIFS1.W & IC_DMA1IF_MASK) )
+    {
+        ISR_SpiDmaHandler_MasterWrite();
     }
 }
\ No newline at end of file
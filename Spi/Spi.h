@@ -33,6 +33,67 @@
 #define SPI2_ICX_IPL    1
 #define SPI2_ICX_ISL    0
 
+/* NOTE: DMA channel 0 serves RX and channel 1 serves TX of DMA-based transfers */
+#define SPI_DMA_ISR_IPL IPL1SOFT
+#define SPI_DMA_ICX_IPL 1
+#define SPI_DMA_ICX_ISL 0
+
+/******************************************************************************/
+
+/* Number of transactions that can be queued per SPI module */
+#ifndef SPI_QUEUE_SIZE
+#define SPI_QUEUE_SIZE  8
+#endif
+
+/******************************************************************************/
+
+/*******************Compile-time SPI Standard mode settings********************/
+
+/* NOTE: Frequencies passed to following macros must be integer constants, so
+ *       SFR values are computed by the compiler (see SPI_ConfigStaticModeSfr()) */
+
+/* Max. allowed deviation of achieved SCK frequency from requested one (%) */
+#ifndef SPI_SCK_TOLERANCE_PCT
+#define SPI_SCK_TOLERANCE_PCT   5
+#endif
+
+/* SPIxBRG value of highest SCK frequency not above requested one (same
+ * rounding as runtime configuration) */
+#define SPI_BRG_VALUE(pbFreq, sckFreq)  \
+    ( ((pbFreq) <= 2 * (sckFreq)) ? 0 : ((((pbFreq) + 2 * (sckFreq) - 1) / (2 * (sckFreq))) - 1) )
+
+/* SCK frequency achieved with given SPIxBRG value */
+#define SPI_SCK_FREQ(pbFreq, brgValue)  ( (pbFreq) / (2 * ((brgValue) + 1)) )
+
+/* SCK frequency is achievable if SPIxBRG fits 9 bits and deviation is within tolerance */
+#define SPI_SCK_IS_ACHIEVABLE(pbFreq, sckFreq)                                          \
+    ( (SPI_BRG_VALUE(pbFreq, sckFreq) <= 511) &&                                        \
+      ((((sckFreq) > SPI_SCK_FREQ(pbFreq, SPI_BRG_VALUE(pbFreq, sckFreq))) ?            \
+        ((sckFreq) - SPI_SCK_FREQ(pbFreq, SPI_BRG_VALUE(pbFreq, sckFreq))) :            \
+        (SPI_SCK_FREQ(pbFreq, SPI_BRG_VALUE(pbFreq, sckFreq)) - (sckFreq))) * 100ULL    \
+        <= (uint64_t)(sckFreq) * SPI_SCK_TOLERANCE_PCT) )
+
+/* SPIxCON value of Standard mode (clock mode as "SpiClkMode_t", frame width as
+ * "SpiFrameWidth_t", enhanced buffer is always enabled) */
+#define SPI_CON_VALUE(isMaster, frameWidth, clkMode)    \
+    ( (((clkMode) & 0x01) << SPI_CKE_POS) |             \
+      ((((clkMode) >> 1) & 0x01) << SPI_CKP_POS) |      \
+      (((isMaster) ? 1 : 0) << SPI_MSTEN_POS) |         \
+      ((frameWidth) << SPI_MODE_POS) |                  \
+      SPI_ENHBUF_MASK )
+
+/* Defines constant SPI Standard mode SFR values, build fails if requested SCK
+ * frequency can't be achieved from given PBCLK frequency within tolerance */
+#define SPI_STATIC_CONFIG(name, pbFreq, sckFreq, isMaster, frameWidth, clkMode)                 \
+    _Static_assert( !(isMaster) || SPI_SCK_IS_ACHIEVABLE(pbFreq, sckFreq),                      \
+                    "SPI SCK frequency is not achievable within SPI_SCK_TOLERANCE_PCT" );       \
+    _Static_assert( (frameWidth) <= SPI_WIDTH_32BIT, "SPI frame width out of range" );          \
+    static const SpiStaticConfig_t name = {                                                     \
+        .conWord = SPI_CON_VALUE(isMaster, frameWidth, clkMode),                                \
+        .brgWord = (isMaster) ? SPI_BRG_VALUE(pbFreq, sckFreq) : 0,                             \
+        .sckFreq = (isMaster) ? (sckFreq) : 0                                                   \
+    }
+
 /******************************************************************************/
 
 /******************************************************************************/
@@ -42,7 +103,13 @@
 /** Type for ISR function pointer configuration **/
 typedef enum {
     ISR_SPI_MODE_0 = 0,
-    ISR_SPI_MODE_1 = 1
+    ISR_SPI_MODE_1 = 1,
+    ISR_SPI_MODE_2 = 2,
+    ISR_SPI_MODE_3 = 3,
+    ISR_SPI_MODE_4 = 4,
+    ISR_SPI_MODE_5 = 5,
+    ISR_SPI_MODE_6 = 6,
+    ISR_SPI_MODE_7 = 7
 } IsrSpiMode_t;
 
 
@@ -74,6 +141,15 @@ typedef enum {
     SPI_AUDMOD_PMC_DSP = 3
 } SpiAudioProtocolMode_t;
 
+typedef enum {
+    SPI_FRMCNT_1 = 0,
+    SPI_FRMCNT_2 = 1,
+    SPI_FRMCNT_4 = 2,
+    SPI_FRMCNT_8 = 3,
+    SPI_FRMCNT_16 = 4,
+    SPI_FRMCNT_32 = 5
+} SpiFrameSyncCount_t;
+
 typedef enum {
     SPI_STXISEL_INTR_WHEN_LAST_TRANSFER_DONE = 0,
     SPI_STXISEL_INTR_WHEN_BUFF_EMPTY = 1,
@@ -119,6 +195,61 @@ typedef struct {
     uint32_t              sckFreq;      // Master mode only
 } SpiStandardConfig_t;
 
+/* SPI Standard mode SFR values computed at compile time (SPI_STATIC_CONFIG()) */
+typedef struct {
+    uint32_t            conWord;        // SPIxCON value
+    uint32_t            brgWord;        // SPIxBRG value (Master mode only)
+    uint32_t            sckFreq;        // Requested SCK frequency (Master mode only)
+} SpiStaticConfig_t;
+
+/* SPI Audio Protocol Interface mode settings */
+typedef struct {
+    bool                    isMasterEnabled;
+    SpiPin_t                pinSelect;      // SS1 is frame sync (LRCK) pin
+    SpiAudioDataWidth_t     dataWidth;
+    SpiAudioProtocolMode_t  protocolMode;
+    bool                    isMonoEnabled;
+    SpiClkMode_t            clkMode;
+    uint32_t                sckFreq;        // Master mode only
+} SpiAudioConfig_t;
+
+/* SPI Framed mode settings (PCM/TDM streams) */
+typedef struct {
+    bool                    isMasterEnabled;    // SCK generated by module
+    bool                    isSyncInput;        // Frame sync pulse generated by other device
+    SpiPin_t                pinSelect;          // SS1 is frame sync pin
+    SpiFrameWidth_t         frameWidth;
+    SpiFrameSyncCount_t     syncCount;          // Frames per frame sync pulse
+    bool                    isSyncActiveHigh;
+    bool                    isSyncFrameWide;    // Pulse one frame wide (one SCK period otherwise)
+    bool                    isSyncCoincident;   // Pulse with first bit (precedes it otherwise)
+    SpiClkMode_t            clkMode;            // Clock polarity only (CKE not used)
+    uint32_t                sckFreq;            // Master mode only
+} SpiFramedConfig_t;
+
+/* SPI scatter-gather segment (Master mode) */
+typedef struct {
+    volatile void      *txPtr;          // NULL for dummy write
+    volatile void      *rxPtr;          // NULL for dummy read
+    uint32_t            size;           // Number of frames
+} SpiSegment_t;
+
+/* SPI non-blocking transfer handle (Master mode) */
+typedef struct {
+    volatile bool       isDone;         // Set from ISR when transfer completes
+    void     (*volatile isrHandler)(void);  // Executed from ISR when done (optional)
+} SpiXfer_t;
+
+/* SPI queued transaction (Master mode) */
+typedef struct {
+    uint32_t            ssPin;          // GPIO pin code of Slave Select
+    volatile void      *txPtr;          // NULL for dummy write
+    volatile void      *rxPtr;          // NULL for dummy read
+    uint32_t            txSize;         // Number of frames
+    SpiFrameWidth_t     frameWidth;
+    void              (*isrHandler)(void);  // Executed from ISR when done (optional)
+} SpiJob_t;
+
 
 /******************************************************************************/
 /*---------------------------- Function Prototypes----------------------------*/
@@ -126,10 +257,13 @@ typedef struct {
 
 /* SPI configuration functions */
 bool SPI_ConfigStandardModeSfr(SpiSfr_t *const spiSfr, SpiStandardConfig_t spiConfig);
-bool SPI_EnableSsState(const uint32_t pinCode);
-bool SPI_DisableSsState(const uint32_t pinCode);
-SpiSsState_t SPI_GetSsState(void);
-void SPI_SetSsState(const SpiSsState_t state);
+bool SPI_ConfigStaticModeSfr(SpiSfr_t *const spiSfr, SpiPin_t pinSelect, const SpiStaticConfig_t *const staticConfig);
+bool SPI_ConfigAudioModeSfr(SpiSfr_t *const spiSfr, SpiAudioConfig_t audioConfig);
+bool SPI_ConfigFramedModeSfr(SpiSfr_t *const spiSfr, SpiFramedConfig_t framedConfig);
+bool SPI_EnableSsState(SpiSfr_t *const spiSfr, const uint32_t pinCode);
+bool SPI_DisableSsState(SpiSfr_t *const spiSfr, const uint32_t pinCode);
+SpiSsState_t SPI_GetSsState(SpiSfr_t *const spiSfr);
+bool SPI_SetSsState(SpiSfr_t *const spiSfr, const SpiSsState_t state);
 
 /* SPI status check functions */
 bool SPI_IsSpiBusy(SpiSfr_t *const spiSfr);
@@ -137,12 +271,32 @@ bool SPI_IsRxDone(SpiSfr_t *const spiSfr, uint8_t rxbufSize);
 
 /* SPI Master mode operation functions */
 bool SPI_MasterReadWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize);
+bool SPI_MasterReadWriteSg(SpiSfr_t *const spiSfr, const SpiSegment_t *segPtr, uint32_t segCount);
 bool SPI_MasterWrite(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize);
+bool SPI_MasterWriteSg(SpiSfr_t *const spiSfr, const SpiSegment_t *segPtr, uint32_t segCount);
 bool SPI_MasterWrite2(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, volatile void (*isrHandler)(void));
+bool SPI_MasterReadWriteAsync(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, SpiXfer_t *const xferPtr);
+bool SPI_IsXferDone(const SpiXfer_t *const xferPtr);
+bool SPI_SetXferCallback(SpiXfer_t *const xferPtr, void (*isrHandler)(void));
+bool SPI_WaitXfer(const SpiXfer_t *const xferPtr, uint32_t timeoutUs);
+bool SPI_MasterWriteStream(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, void (*isrHandler)(void));
+bool SPI_QueueJob(SpiSfr_t *const spiSfr, SpiJob_t job);
+uint32_t SPI_GetQueueCount(SpiSfr_t *const spiSfr);
+bool SPI_MasterWriteDma(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t txSize, void (*isrHandler)(void));
+
+/* SPI audio streaming functions */
+bool SPI_StartAudioStream(SpiSfr_t *const spiSfr, volatile void *rxPtr, volatile void *txPtr, uint32_t halfSize, void (*isrHandler)(uint32_t half));
+bool SPI_StopAudioStream(SpiSfr_t *const spiSfr);
+bool SPI_GetAudioErrorCount(SpiSfr_t *const spiSfr, uint32_t *const underrunPtr, uint32_t *const overrunPtr);
 
 /* SPI Slave mode operation functions */
 bool SPI_DummyRead(SpiSfr_t *const spiSfr);
 bool SPI_SlaveWrite(SpiSfr_t *const spiSfr, volatile void *txPtr, uint32_t txSize);
 bool SPI_SlaveRead(SpiSfr_t *const spiSfr, volatile void *rxPtr);
+bool SPI_StartSlaveRing(SpiSfr_t *const spiSfr, volatile void *bufPtr, uint32_t bufSize);
+bool SPI_StopSlaveRing(SpiSfr_t *const spiSfr);
+uint32_t SPI_GetSlaveRingSpan(SpiSfr_t *const spiSfr, volatile void **dataPtr);
+bool SPI_ReleaseSlaveRingSpan(SpiSfr_t *const spiSfr, uint32_t count);
+uint32_t SPI_GetSlaveRingOverrunCount(SpiSfr_t *const spiSfr);
 
 #endif	/* SPI_H */
\ No newline at end of file
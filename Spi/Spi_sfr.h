@@ -18,6 +18,24 @@
 #define SPI1_MODULE     (*(SpiSfr_t *const)0xBF805800)
 #define SPI2_MODULE     (*(SpiSfr_t *const)0xBF805A00)
 
+/** NOTE: Definitions of DMA channels used by SPI DMA-based operation (no DMA
+ *        driver library is available yet, see also "Cfg_sfr.h") **/
+
+/** DMA (Direct Memory Access) channel base addresses **/
+#define DMA_CH0_MODULE  (*(DmaChSfr_t *const)0xBF883060)
+#define DMA_CH1_MODULE  (*(DmaChSfr_t *const)0xBF883120)
+#define DMA_CH2_MODULE  (*(DmaChSfr_t *const)0xBF8831E0)
+#define DMA_CH3_MODULE  (*(DmaChSfr_t *const)0xBF8832A0)
+
+/** Interrupt request numbers used as DMA start/abort events **/
+#define SPI1_RX_IRQ     37
+#define SPI1_TX_IRQ     38
+#define SPI2_RX_IRQ     51
+#define SPI2_TX_IRQ     52
+
+/** Virtual (KSEG) to physical address translation for DMA address SFRs **/
+#define DMA_KVA_TO_PA(addr)     ((uint32_t)(uintptr_t)(addr) & 0x1FFFFFFF)
+
 
 /******************************************************************************/
 /*---------------------------------Bit Masks----------------------------------*/
@@ -111,6 +129,40 @@
 #define SPI_SPISGNEXT_POS   (15)
 #define SPI_SPISGNEXT_MASK  (1 << 15)
 
+/* DMACON register */
+#define DMA_ON_POS          (15)
+#define DMA_ON_MASK         (1 << 15)
+
+/* DCHxCON register */
+#define DMA_CHPRI_POS       (0)
+#define DMA_CHPRI_MASK      (3 << 0)
+#define DMA_CHAEN_POS       (4)
+#define DMA_CHAEN_MASK      (1 << 4)
+#define DMA_CHEN_POS        (7)
+#define DMA_CHEN_MASK       (1 << 7)
+#define DMA_CHBUSY_POS      (15)
+#define DMA_CHBUSY_MASK     (1 << 15)
+
+/* DCHxECON register */
+#define DMA_SIRQEN_POS      (4)
+#define DMA_SIRQEN_MASK     (1 << 4)
+#define DMA_CABORT_POS      (6)
+#define DMA_CABORT_MASK     (1 << 6)
+#define DMA_CFORCE_POS      (7)
+#define DMA_CFORCE_MASK     (1 << 7)
+#define DMA_CHSIRQ_POS      (8)
+#define DMA_CHSIRQ_MASK     (0xFF << 8)
+
+/* DCHxINT register */
+#define DMA_CHERIF_POS      (0)
+#define DMA_CHERIF_MASK     (1 << 0)
+#define DMA_CHBCIF_POS      (3)
+#define DMA_CHBCIF_MASK     (1 << 3)
+#define DMA_CHERIE_POS      (16)
+#define DMA_CHERIE_MASK     (1 << 16)
+#define DMA_CHBCIE_POS      (19)
+#define DMA_CHBCIE_MASK     (1 << 19)
+
 /******************************************************************************/
 /*-----------------------------Data Structures--------------------------------*/
 /******************************************************************************/
@@ -125,6 +177,22 @@ typedef struct {
     Sfr_t       SPIxCON2;
 } volatile SpiSfr_t;
 
+/** DMA channel registers **/
+typedef struct {
+    Sfr_t       DCHxCON;
+    Sfr_t       DCHxECON;
+    Sfr_t       DCHxINT;
+    Sfr_t       DCHxSSA;
+    Sfr_t       DCHxDSA;
+    Sfr_t       DCHxSSIZ;
+    Sfr_t       DCHxDSIZ;
+    Sfr_t       DCHxSPTR;
+    Sfr_t       DCHxDPTR;
+    Sfr_t       DCHxCSIZ;
+    Sfr_t       DCHxCPTR;
+    Sfr_t       DCHxDAT;
+} volatile DmaChSfr_t;
+
 
 #endif	/* SPI_SFR_H */
 
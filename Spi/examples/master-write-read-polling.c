@@ -32,7 +32,7 @@ int main(int argc, char** argv)
 								0xA0, 0x12, 0x00, 0xF1};
 
 	/* Configure which Slave will be addressed */
-	SPI_EnableSsState(spiMasterConfig.pinSelect.ss1Pin);
+	SPI_EnableSsState(spiMasterSfr, spiMasterConfig.pinSelect.ss1Pin);
 
 	/* Polling-based SPI read and write */
 	SPI_MasterReadWrite(spiMasterSfr, masterRxData, masterTxData, 24);
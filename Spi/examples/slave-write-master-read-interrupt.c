@@ -53,7 +53,7 @@ int main(int argc, char** argv)
 	SPI_SlaveWrite(spiSlaveSfr, slaveTxData, 4);
 
 	/* Configure which Slave will be addressed */
-	SPI_EnableSsState(spiMasterConfig.pinSelect.ss1Pin);
+	SPI_EnableSsState(spiMasterSfr, spiMasterConfig.pinSelect.ss1Pin);
 
 	/* Interrupt-based SPI write */
 	SPI_MasterWrite(spiMasterSfr, masterRxData, masterTxData, 24);
@@ -2,6 +2,9 @@
 
 #define CORE_TIMER_PERIOD_MS        1
 #define CORE_TIMER_CALLBACK_COUNT   9
+#define WHEEL_MASK                  (TMR_WHEEL_SLOTS - 1)
+#define DEADLINE_MAX_COUNT          0x7FFFFFFF
+#define TMR_INSTANCE_COUNT          5
 
 /******************************************************************************/
 /*--------------------------Local Data Variables------------------------------*/
@@ -10,74 +13,196 @@
 /** Pointer for Interrupt Controller **/
 static IcSfr_t *const icSfr = &IC_MODULE;
 
+/** Gated mode pulse width capture (ring buffer written by ISR, read by user) **/
 typedef struct {
-    uint32_t            sysClk;
+    TmrPulse_t          *bufferPtr;     // NULL if capture is not running
+    uint32_t            mask;
+    volatile uint32_t   head;
+    volatile uint32_t   tail;
+    uint32_t            overrunCount;
+    uint32_t            count;
+    uint32_t            minWidth;
+    uint32_t            maxWidth;
+    uint64_t            sumWidth;
+} TmrPulseCapture_t;
+
+/** Timer-triggered sampling (ping-pong blocks, ready flags are set by ISR
+ ** and cleared by user only) **/
+typedef struct {
+    TmrSampleSource_t   source;
+    PioSfr_t            *pioSfr;
+    void              (*sampleHandler)(volatile uint32_t *const samplePtr);
+    volatile uint32_t   *blockPtr[2];
+    uint32_t            blockSize;
+    uint32_t            fillIdx;
+    uint32_t            fillBlock;
+    volatile bool       isReady[2];
+    uint32_t            overrunCount;
+    bool                isOn;
+} TmrSampling_t;
+
+/** Tick conversion factor in Q32.32 fixed-point format **/
+typedef struct {
+    uint32_t            intPart;
+    uint32_t            fracPart;
+} TmrScale_t;
+
+/** Timeout parameters **/
+/* Configured in TMR_ConfigXxxModeSfr(), used in TMR_SetTimeoutPeriod() */
+typedef struct {
+    uint32_t            clkFreq;        // Timer input clock (PBCLK)
     uint32_t            clkDiv;
-    uint32_t            timeUnit;
+    uint32_t            timeUnit;       // 0 if timer is not configured
+    TmrScale_t          prScale;        // Period (in time unit) to PRx value
+    TmrScale_t          timeScale;      // Timer count to time unit
 } TmrToutParam_t;
 
+/** General timer flags **/
+/* Configured in TMR_ConfigXxxModeSfr(), used in IsrDispatch() */
 typedef struct {
-    bool              isMode32;
-    bool              isGateCont;
+    bool                isMode32;
+    bool                isGateCont;
 } TmrStatus_t;
 
-/** Timeout parameters **/
-/* Configured in TMR_TimeoutSfrConfig(), used in TMR_SetTimerPeriod */
+/** Run-time state of timer instance **/
 typedef struct {
-    TmrToutParam_t      t1;
-    TmrToutParam_t      t2;
-    TmrToutParam_t      t3;
-    TmrToutParam_t      t4;
-    TmrToutParam_t      t5;
-} ToutParam_t ;
-
-static volatile ToutParam_t toutParam;
+    void                (*isrHandler)(void);
+    TmrStatus_t         status;
+    TmrToutParam_t      toutParam;
+    TmrPulseCapture_t   pulseCapture;
+    TmrSampling_t       sampling;
+} TmrState_t;
 
-/** General timer flags **/
-/* Configured in TMR_ConfigSfrXxxMode(), used in ISRx() */
+/** Constant description of timer instance **/
 typedef struct {
-    TmrStatus_t         t1;
-    TmrStatus_t         t2;
-    TmrStatus_t         t3;
-    TmrStatus_t         t4;
-    TmrStatus_t         t5;
-} ConfigFlag_t;
+    TmrSfr_t            *tmrSfr;
+    TmrState_t          *statePtr;
+    uint32_t            ifsMask;        // TxIF bit of ICxIFS0
+    uint32_t            iecMask;        // TxIE bit of ICxIEC0
+    volatile Sfr_t      *ipcSfr;        // ICxIPCx register of timer
+    uint32_t            ipcMask;        // TxIP and TxIS fields
+    uint32_t            ipcValue;       // User-defined (sub)priority levels
+    IcProfileSlot_t     profileSlot;
+    int8_t              upperIdx;       // Upper timer of 32-bit pair (-1 if none)
+    int8_t              lowerIdx;       // Lower timer of 32-bit pair (-1 if none)
+} TmrDesc_t;
 
 /** Static variables **/
-static volatile ConfigFlag_t isrFlag;
 static volatile uint32_t coreTimerPeriod;
-static uint32_t isrHandlerAddr[CORE_TIMER_CALLBACK_COUNT];
+static volatile uint32_t coreTimerBase;         // CP0 count of "wheelTick"
+
+/** Free-running 64-bit timebase (TMR2/TMR3 pair, TMR3 period ISR counts
+ ** upper word) **/
+static volatile uint32_t timebaseHigh;
+static volatile bool isTimebaseOn;
+
+/** Timebase conversion (ticks after "timebaseTickBase" are converted with
+ ** factors of current clock tree and added to time at that count, so that
+ ** converted time stays monotonic across clock changes) **/
+static volatile TmrScale_t timebaseNsScale;
+static volatile TmrScale_t timebaseUsScale;
+static volatile uint64_t timebaseTickBase;
+static volatile uint64_t timebaseNsBase;
+static volatile uint64_t timebaseUsBase;
+static volatile uint32_t timebaseGeneration;    // Changes on every clock change
+static uint64_t timebaseSwitchTick;             // Count before clock change
+
+/** Core timer wheel (level 0 holds one tick per slot, level 1 holds
+ ** TMR_WHEEL_SLOTS ticks per slot and is cascaded to level 0) **/
+static TmrWheelTimer_t *wheelLevel0[TMR_WHEEL_SLOTS];
+static TmrWheelTimer_t *wheelLevel1[TMR_WHEEL_SLOTS];
+static volatile uint32_t wheelTick;
+
+/** Wheel timers used by TMR_SetCoreTimerCallback() **/
+static TmrWheelTimer_t coreTimerCallback[CORE_TIMER_CALLBACK_COUNT];
 
 /** Default ISR empty handler **/
 static void IsrDefaultHandler(void);
 
-/** ISR function pointer **/
-static void (*Isr1HandlerPtr)(void) = IsrDefaultHandler;
-static void (*Isr2HandlerPtr)(void) = IsrDefaultHandler;
-static void (*Isr3HandlerPtr)(void) = IsrDefaultHandler;
-static void (*Isr4HandlerPtr)(void) = IsrDefaultHandler;
-static void (*Isr5HandlerPtr)(void) = IsrDefaultHandler;
-
-/** Special-case use function pointers (number of function pointers reflects
- ** to size of "isrHandlerAddr" **/
-static void (*IsrTimeout1HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout2HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout3HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout4HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout5HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout6HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout7HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout8HandlerPtr)(void) = IsrDefaultHandler;
-static void (*IsrTimeout9HandlerPtr)(void) = IsrDefaultHandler;
+/** Run-time state of timers (ISR function pointers, flags and parameters) **/
+static TmrState_t tmrState[TMR_INSTANCE_COUNT] = {
+    {.isrHandler = IsrDefaultHandler},
+    {.isrHandler = IsrDefaultHandler},
+    {.isrHandler = IsrDefaultHandler},
+    {.isrHandler = IsrDefaultHandler},
+    {.isrHandler = IsrDefaultHandler}
+};
+
+/** Executed while waiting for deadline (cooperative work of main loop) **/
+static void (*DelayYieldHandlerPtr)(void) = IsrDefaultHandler;
+
+/** Clock tree before clock change (saved by pre-change hook) **/
+static OscClkState_t clkStateOld;
 
 /******************************************************************************/
 /*------------------------Local Function Prototypes---------------------------*/
 /******************************************************************************/
 
-INLINE static void InterruptSfrConfig(TmrSfr_t *const tmrSfr);
-INLINE static void TimeoutParamSet(TmrSfr_t *const tmrSfr, uint32_t sysClk, uint32_t clkDiv, uint32_t timeUnit);
-INLINE static void IsrFlagSet(TmrSfr_t *const tmrSfr, bool isMode32, bool isGateCont);
-INLINE static TmrToutParam_t TimeoutParamRead(TmrSfr_t *const tmrSfr);
+INLINE static void InterruptSfrConfig(const TmrDesc_t *const descPtr);
+INLINE static void TimeoutParamSet(const TmrDesc_t *const descPtr, uint32_t timeUnit);
+static void CoreTimerConfig(void);
+INLINE static void WheelInsert(TmrWheelTimer_t *const timerPtr);
+INLINE static void WheelRemove(TmrWheelTimer_t *const timerPtr);
+static void WheelAdvance(void);
+static uint32_t WheelNextEvent(void);
+static void CoreTimerCompareSet(uint32_t compare);
+static TmrScale_t ScaleGet(uint64_t numerator, uint32_t denominator);
+INLINE static uint32_t ClkDivRead(TmrSfr_t *const tmrSfr);
+INLINE static uint32_t Tmr1ClkDivGet(TmrClkDiv_t clkDiv);
+static void DelayChunked(uint32_t delay, TmrTimeUnit_t timeUnit, uint32_t maxChunk);
+INLINE static TmrPulseCapture_t *PulseCaptureGet(TmrSfr_t *const tmrSfr);
+INLINE static void PulseCaptureStore(const TmrDesc_t *const descPtr);
+INLINE static void SampleStore(const TmrDesc_t *const descPtr);
+INLINE static uint64_t ScaleApply(uint64_t ticks, TmrScale_t scale);
+INLINE static uint64_t TimeoutCountsLimit(uint64_t counts, uint64_t maxCounts);
+static uint64_t TimebaseConvert(uint64_t ticks, const volatile uint64_t *basePtr, const volatile TmrScale_t *scalePtr);
+INLINE static const TmrDesc_t *DescGet(TmrSfr_t *const tmrSfr);
+static void IsrDispatch(const TmrDesc_t *const descPtr);
+static void ClkPreHook(const OscClkState_t *const statePtr);
+static void ClkPostHook(const OscClkState_t *const statePtr);
+
+/******************************************************************************/
+/*---------------------------Local Constant Data------------------------------*/
+/******************************************************************************/
+
+/** Timer instance descriptors (index 0 is TMR1) **/
+static const TmrDesc_t tmrDesc[TMR_INSTANCE_COUNT] = {
+    {
+        .tmrSfr = &TMR1_MODULE, .statePtr = &tmrState[0],
+        .ifsMask = IC_T1IF_MASK, .iecMask = IC_T1IE_MASK,
+        .ipcSfr = &IC_MODULE.ICxIPC1, .ipcMask = (IC_T1IS_MASK | IC_T1IP_MASK),
+        .ipcValue = ((TMR1_ICX_ISL << IC_T1IS_POS) | (TMR1_ICX_IPL << IC_T1IP_POS)),
+        .profileSlot = IC_PROFILE_TMR1, .upperIdx = -1, .lowerIdx = -1
+    },
+    {
+        .tmrSfr = &TMR2_MODULE, .statePtr = &tmrState[1],
+        .ifsMask = IC_T2IF_MASK, .iecMask = IC_T2IE_MASK,
+        .ipcSfr = &IC_MODULE.ICxIPC2, .ipcMask = (IC_T2IS_MASK | IC_T2IP_MASK),
+        .ipcValue = ((TMR2_ICX_ISL << IC_T2IS_POS) | (TMR2_ICX_IPL << IC_T2IP_POS)),
+        .profileSlot = IC_PROFILE_TMR2, .upperIdx = 2, .lowerIdx = -1
+    },
+    {
+        .tmrSfr = &TMR3_MODULE, .statePtr = &tmrState[2],
+        .ifsMask = IC_T3IF_MASK, .iecMask = IC_T3IE_MASK,
+        .ipcSfr = &IC_MODULE.ICxIPC3, .ipcMask = (IC_T3IS_MASK | IC_T3IP_MASK),
+        .ipcValue = ((TMR3_ICX_ISL << IC_T3IS_POS) | (TMR3_ICX_IPL << IC_T3IP_POS)),
+        .profileSlot = IC_PROFILE_TMR3, .upperIdx = -1, .lowerIdx = 1
+    },
+    {
+        .tmrSfr = &TMR4_MODULE, .statePtr = &tmrState[3],
+        .ifsMask = IC_T4IF_MASK, .iecMask = IC_T4IE_MASK,
+        .ipcSfr = &IC_MODULE.ICxIPC4, .ipcMask = (IC_T4IS_MASK | IC_T4IP_MASK),
+        .ipcValue = ((TMR4_ICX_ISL << IC_T4IS_POS) | (TMR4_ICX_IPL << IC_T4IP_POS)),
+        .profileSlot = IC_PROFILE_TMR4, .upperIdx = 4, .lowerIdx = -1
+    },
+    {
+        .tmrSfr = &TMR5_MODULE, .statePtr = &tmrState[4],
+        .ifsMask = IC_T5IF_MASK, .iecMask = IC_T5IE_MASK,
+        .ipcSfr = &IC_MODULE.ICxIPC5, .ipcMask = (IC_T5IS_MASK | IC_T5IP_MASK),
+        .ipcValue = ((TMR5_ICX_ISL << IC_T5IS_POS) | (TMR5_ICX_IPL << IC_T5IP_POS)),
+        .profileSlot = IC_PROFILE_TMR5, .upperIdx = -1, .lowerIdx = 3
+    }
+};
 
 /******************************************************************************/
 /*----------------------External Function Definitions-------------------------*/
@@ -89,14 +214,24 @@ INLINE static TmrToutParam_t TimeoutParamRead(TmrSfr_t *const tmrSfr);
  */
 extern bool TMR_ConfigTimeoutModeSfr(TmrSfr_t *const tmrSfr, TmrTimeoutConfig_t tmrConfig)
 {
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
     /* Timer base address check */
-    if( !(tmrSfr == &TMR1_MODULE) && !(tmrSfr == &TMR2_MODULE) && 
-        !(tmrSfr == &TMR3_MODULE) && !(tmrSfr == &TMR4_MODULE) &&
-        !(tmrSfr == &TMR5_MODULE) )
+    if( descPtr == NULL )
     {
         return false;
     }
     
+    /* Timer is no longer used as timebase */
+    if( (tmrSfr == &TMR2_MODULE) || (tmrSfr == &TMR3_MODULE) )
+    {
+        isTimebaseOn = false;
+    }
+    
+    /* Pulse width capture and sampling are stopped by reconfiguration */
+    descPtr->statePtr->pulseCapture.bufferPtr = NULL;
+    descPtr->statePtr->sampling.isOn = false;
+    
     /* SOSC only applicable for Timer1 */
     if( (tmrSfr == &TMR1_MODULE) && (tmrConfig.clkSrc == TMR_CLK_SRC_SOSC) )
     {
@@ -116,17 +251,18 @@ extern bool TMR_ConfigTimeoutModeSfr(TmrSfr_t *const tmrSfr, TmrTimeoutConfig_t
     tmrSfr->TMRxTMR.CLR = 0xFFFFFFFF;
     tmrSfr->TMRxPR.CLR = 0xFFFFFFFF;
     
-    TmrSfr_t *tmrSfr2 = NULL;
+    /* Interrupt of 32-bit pair is generated by upper timer */
+    const TmrDesc_t *intDescPtr = descPtr;
     bool isMode32 = false;
     
     /* 32-bit mode only possible when configuring Timer2 or Timer4 */
     if( tmrConfig.bitMode == TMR_BITMODE_32BIT )
     {
         /* TMRx and TMRy must be cleared during 32-bit mode*/
-        if( (tmrSfr == &TMR2_MODULE) || (tmrSfr == &TMR4_MODULE) )
+        if( descPtr->upperIdx >= 0 )
         {
-            /* Pointer for next timer access */
-            tmrSfr2 = ((TmrSfr_t *)((uint8_t *)tmrSfr + 0x200));
+            intDescPtr = &tmrDesc[descPtr->upperIdx];
+            TmrSfr_t *tmrSfr2 = intDescPtr->tmrSfr;
             
             /* Reset other Timer of 32-bit pair */
             tmrSfr2->TMRxCON.CLR = TMR_ON_MASK;
@@ -150,7 +286,7 @@ extern bool TMR_ConfigTimeoutModeSfr(TmrSfr_t *const tmrSfr, TmrTimeoutConfig_t
     if( tmrSfr == &TMR1_MODULE )
     {
         /* Only DIV_1/8/64/256 available */
-        clkDiv = (tmrConfig.clkDiv & 0x01) | (tmrConfig.clkDiv & 0x04);
+        clkDiv = Tmr1ClkDivGet(tmrConfig.clkDiv);
     }
     else
     {
@@ -162,21 +298,17 @@ extern bool TMR_ConfigTimeoutModeSfr(TmrSfr_t *const tmrSfr, TmrTimeoutConfig_t
                           (clkDiv << TMR_TCKPS_POS) |
                           (isExtClk << TMR_TCS_POS);
     
-    /* Set timeout parameters for PRx compare value calculation */
-    TimeoutParamSet(tmrSfr, OSC_GetSysFreq(), tmrConfig.clkDiv, tmrConfig.timeUnit);
+    /* Set timeout parameters for PRx compare value calculation (rescaled on
+     * clock change) */
+    TimeoutParamSet(descPtr, tmrConfig.timeUnit);
+    OSC_AddClkHook(ClkPreHook, ClkPostHook);
     
     /* Set timer status flags (for ISR) */
-    IsrFlagSet(tmrSfr, isMode32, false);
+    descPtr->statePtr->status.isMode32 = isMode32;
+    descPtr->statePtr->status.isGateCont = false;
     
     /* Configure interrupt SFRs */
-    if( tmrConfig.bitMode == TMR_BITMODE_32BIT )
-    {
-        InterruptSfrConfig(tmrSfr2);
-    }
-    else
-    {
-        InterruptSfrConfig(tmrSfr);
-    }
+    InterruptSfrConfig(intDescPtr);
     
     /* Enable interrupts */
     IC_EnableInterrupts();
@@ -191,10 +323,10 @@ extern bool TMR_ConfigTimeoutModeSfr(TmrSfr_t *const tmrSfr, TmrTimeoutConfig_t
  */
 extern bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrConfig)
 {
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
     /* Timer base address check */
-    if( !(tmrSfr == &TMR1_MODULE) && !(tmrSfr == &TMR2_MODULE) && 
-        !(tmrSfr == &TMR3_MODULE) && !(tmrSfr == &TMR4_MODULE) &&
-        !(tmrSfr == &TMR5_MODULE) )
+    if( descPtr == NULL )
     {
         return false;
     }
@@ -205,6 +337,16 @@ extern bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrC
         return false;
     }
     
+    /* Timer is no longer used as timebase */
+    if( (tmrSfr == &TMR2_MODULE) || (tmrSfr == &TMR3_MODULE) )
+    {
+        isTimebaseOn = false;
+    }
+    
+    /* Pulse width capture and sampling are stopped by reconfiguration */
+    descPtr->statePtr->pulseCapture.bufferPtr = NULL;
+    descPtr->statePtr->sampling.isOn = false;
+    
     /* Disable the module */
     tmrSfr->TMRxCON.CLR = TMR_ON_MASK;
     asm("nop");
@@ -214,17 +356,18 @@ extern bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrC
     tmrSfr->TMRxTMR.CLR = 0xFFFFFFFF;
     tmrSfr->TMRxPR.CLR = 0xFFFFFFFF;
     
-    TmrSfr_t *tmrSfr2 = NULL;
+    /* Interrupt of 32-bit pair is generated by upper timer */
+    const TmrDesc_t *intDescPtr = descPtr;
     bool isMode32 = false;
     
     /* 32-bit mode only possible when configuring Timer2 or Timer4 */
     if( tmrConfig.bitMode == TMR_BITMODE_32BIT )
     {
         /* TMRx and TMRy must be cleared during 32-bit mode*/
-        if( (tmrSfr == &TMR2_MODULE) || (tmrSfr == &TMR4_MODULE) )
+        if( descPtr->upperIdx >= 0 )
         {
-            /* Pointer for next timer access */
-            tmrSfr2 = ((TmrSfr_t *)((uint8_t *)tmrSfr + 0x200));
+            intDescPtr = &tmrDesc[descPtr->upperIdx];
+            TmrSfr_t *tmrSfr2 = intDescPtr->tmrSfr;
             
             /* Reset other Timer of 32-bit pair */
             tmrSfr2->TMRxCON.CLR = TMR_ON_MASK;
@@ -247,7 +390,7 @@ extern bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrC
     if( tmrSfr == &TMR1_MODULE )
     {
         /* Only DIV_1/8/64/256 available */
-        clkDiv = (tmrConfig.clkDiv & 0x01) | (tmrConfig.clkDiv & 0x04);
+        clkDiv = Tmr1ClkDivGet(tmrConfig.clkDiv);
     }
     else
     {
@@ -266,18 +409,16 @@ extern bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrC
     /* Compare on max. length period for gated mode */
     tmrSfr->TMRxPR.SET = 0xFFFFFFFF;
     
+    /* Measured period is read in microseconds (rescaled on clock change) */
+    TimeoutParamSet(descPtr, TMR_TIME_UNIT_US);
+    OSC_AddClkHook(ClkPreHook, ClkPostHook);
+    
     /* Set timer status flags (for ISR) */
-    IsrFlagSet(tmrSfr, isMode32, tmrConfig.isGateCont);
+    descPtr->statePtr->status.isMode32 = isMode32;
+    descPtr->statePtr->status.isGateCont = tmrConfig.isGateCont;
     
     /* Configure interrupt SFRs */
-    if( tmrConfig.bitMode == TMR_BITMODE_32BIT )
-    {
-        InterruptSfrConfig(tmrSfr2);
-    }
-    else
-    {
-        InterruptSfrConfig(tmrSfr);
-    }
+    InterruptSfrConfig(intDescPtr);
     
     /* Enable interrupts */
     IC_EnableInterrupts();
@@ -291,57 +432,23 @@ extern bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrC
  */
 extern bool TMR_SetCallback(TmrSfr_t *const tmrSfr, void (*isrHandler)(void))
 {
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
     /* Input protection */
-    if (isrHandler == NULL)
+    if( (isrHandler == NULL) || (descPtr == NULL) )
     {
         return false;
     }
     
-    /* Set function pointer to user-defined function */
-    if( tmrSfr == &TMR1_MODULE )
-    {
-        Isr1HandlerPtr = isrHandler;
-    }
-    else if( tmrSfr == &TMR2_MODULE )
-    {
-        /* 32-bit mode */
-        if( isrFlag.t2.isMode32 == true )
-        {
-            Isr3HandlerPtr = isrHandler;
-        }
-        /* 16-bit mode */
-        else
-        {
-            Isr2HandlerPtr = isrHandler;
-        }
-    }
-    else if( tmrSfr == &TMR3_MODULE )
-    {
-        Isr3HandlerPtr = isrHandler;
-    }
-    else if( tmrSfr == &TMR4_MODULE )
-    {
-        /* 32-bit mode */
-        if( isrFlag.t2.isMode32 == true )
-        {
-            Isr5HandlerPtr = isrHandler;
-        }
-        /* 16-bit mode */
-        else
-        {
-            Isr4HandlerPtr = isrHandler;
-        }
-    }
-    else if( tmrSfr == &TMR5_MODULE )
+    /* Interrupt of 32-bit pair is generated by upper timer */
+    if( (descPtr->upperIdx >= 0) && descPtr->statePtr->status.isMode32 )
     {
-        Isr5HandlerPtr = isrHandler;
-    }
-    /* TMR module base address check */
-    else
-    {
-        return false;
+        descPtr = &tmrDesc[descPtr->upperIdx];
     }
     
+    /* Set function pointer to user-defined function */
+    descPtr->statePtr->isrHandler = isrHandler;
+    
     return true;
 }
 
@@ -357,79 +464,200 @@ extern bool TMR_SetCoreTimerCallback(void (*isrHandler)(void))
         return false;
     }
     
-    static uint8_t addrIdx = 0;
+    TmrWheelTimer_t *freePtr = NULL;
     
-    /* Check if handler already set */
-    for (uint8_t idx = 0; idx < addrIdx; idx++)
+    for (uint8_t idx = 0; idx < CORE_TIMER_CALLBACK_COUNT; idx++)
     {
         /* Return true means handler is already set */
-        if (isrHandlerAddr[idx] == (uint32_t)isrHandler)
+        if (coreTimerCallback[idx].isrHandler == isrHandler)
         {
             return true;
         }
+        
+        if ( (freePtr == NULL) && (coreTimerCallback[idx].isrHandler == NULL) )
+        {
+            freePtr = &coreTimerCallback[idx];
+        }
     }
     
-    /* Use handler if unassigned to any other user-defined callback */
-    if (IsrTimeout1HandlerPtr == IsrDefaultHandler)
+    /* No empty handler */
+    if (freePtr == NULL)
     {
-        IsrTimeout1HandlerPtr = isrHandler;
+        return false;
     }
-    else if (IsrTimeout2HandlerPtr == IsrDefaultHandler)
+    
+    /* Executed on every core timer tick */
+    return TMR_StartWheelTimer(freePtr, 1, true, isrHandler);
+}
+
+
+/*
+ *  Arms a core timer wheel timer, expiring after "period" core timer ticks
+ *  (1 ms), and re-arms it if already armed. Insertion takes constant time
+ *  Returns false if any input restriction is triggered
+ */
+extern bool TMR_StartWheelTimer(TmrWheelTimer_t *const timerPtr, uint32_t period, bool isPeriodic, void (*isrHandler)(void))
+{
+    /* Input protection */
+    if( (timerPtr == NULL) || (period == 0) || (isrHandler == NULL) )
     {
-        IsrTimeout2HandlerPtr = isrHandler;
+        return false;
     }
-    else if (IsrTimeout3HandlerPtr == IsrDefaultHandler)
+    
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Wheel is also modified by ISR
+    
+    if( timerPtr->prevNextPtr != NULL )
     {
-        IsrTimeout3HandlerPtr = isrHandler;
+        WheelRemove(timerPtr);
     }
-    else if (IsrTimeout4HandlerPtr == IsrDefaultHandler)
+    
+    CoreTimerConfig();
+    
+    /* Wheel is only advanced when an event is due, count elapsed ticks */
+    uint32_t elapsed = (_CP0_GET_COUNT() - coreTimerBase) / coreTimerPeriod;
+    
+    timerPtr->period = period;
+    timerPtr->isPeriodic = isPeriodic;
+    timerPtr->isrHandler = isrHandler;
+    timerPtr->expiry = wheelTick + elapsed + period;
+    WheelInsert(timerPtr);
+    
+    /* Bring compare forward if new timer expires before programmed event */
+    uint32_t compare = coreTimerBase + (elapsed + period) * coreTimerPeriod;
+    if( (compare - _CP0_GET_COUNT()) < (_CP0_GET_COMPARE() - _CP0_GET_COUNT()) )
     {
-        IsrTimeout4HandlerPtr = isrHandler;
+        CoreTimerCompareSet(compare);
     }
-    else if (IsrTimeout5HandlerPtr == IsrDefaultHandler)
+    
+    IC_SetInterruptState(intrStatus);
+    
+    return true;
+}
+
+
+/*
+ *  Disarms a core timer wheel timer. Removal takes constant time
+ *  Returns false if timer is not armed
+ */
+extern bool TMR_StopWheelTimer(TmrWheelTimer_t *const timerPtr)
+{
+    /* Input protection */
+    if( timerPtr == NULL )
     {
-        IsrTimeout5HandlerPtr = isrHandler;
+        return false;
     }
-    else if (IsrTimeout6HandlerPtr == IsrDefaultHandler)
+    
+    bool isArmed = false;
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Wheel is also modified by ISR
+    
+    if( timerPtr->prevNextPtr != NULL )
     {
-        IsrTimeout6HandlerPtr = isrHandler;
+        WheelRemove(timerPtr);
+        isArmed = true;
     }
-    else if (IsrTimeout7HandlerPtr == IsrDefaultHandler)
+    
+    IC_SetInterruptState(intrStatus);
+    
+    return isArmed;
+}
+
+
+/*
+ *  Searches pre-scalers (and 32-bit pairing for TMR2/TMR4) for configuration
+ *  with the lowest period error within tolerance (period and tolerance are in
+ *  time unit, clkFreq is timer input clock). On equal error 16-bit mode and
+ *  smaller pre-scaler are preferred. No SFR is accessed
+ *  Returns false if no configuration is within tolerance
+ */
+extern bool TMR_SolveTimeoutPeriod(TmrSfr_t *const tmrSfr, uint32_t clkFreq, uint32_t period, uint32_t tolerance, TmrTimeUnit_t timeUnit, TmrTimeoutSolution_t *const solutionPtr)
+{
+    /* Input protection */
+    if( (clkFreq == 0) || (period == 0) || (solutionPtr == NULL) )
     {
-        IsrTimeout7HandlerPtr = isrHandler;
+        return false;
     }
-    else if (IsrTimeout8HandlerPtr == IsrDefaultHandler)
+    
+    /* Pre-scalers of Timer1 are restricted */
+    static const TmrClkDiv_t tmr1ClkDiv[] = {TMR_CLK_DIV_1, TMR_CLK_DIV_8, TMR_CLK_DIV_64, TMR_CLK_DIV_256};
+    static const TmrClkDiv_t tmrClkDiv[] = {TMR_CLK_DIV_1, TMR_CLK_DIV_2, TMR_CLK_DIV_4, TMR_CLK_DIV_8,
+                                            TMR_CLK_DIV_16, TMR_CLK_DIV_32, TMR_CLK_DIV_64, TMR_CLK_DIV_256};
+    
+    const TmrClkDiv_t *clkDivPtr = (tmrSfr == &TMR1_MODULE) ? tmr1ClkDiv : tmrClkDiv;
+    uint32_t clkDivCount = (tmrSfr == &TMR1_MODULE) ? 4 : 8;
+    uint32_t bitModeCount = ((tmrSfr == &TMR2_MODULE) || (tmrSfr == &TMR4_MODULE)) ? 2 : 1;
+    
+    /* Errors are compared in units of (clkFreq * timeUnit)^-1 seconds */
+    uint64_t target = (uint64_t)period * clkFreq;
+    uint64_t maxError = (uint64_t)tolerance * clkFreq;
+    uint64_t bestError = 0;
+    bool isFound = false;
+    
+    for( uint32_t mode = 0; mode < bitModeCount; mode++ )
     {
-        IsrTimeout8HandlerPtr = isrHandler;
+        uint64_t maxCounts = (mode == TMR_BITMODE_16BIT) ? 0x10000 : 0x100000000;
+        
+        for( uint32_t idx = 0; idx < clkDivCount; idx++ )
+        {
+            uint32_t div = (clkDivPtr[idx] <= 6) ? (1 << clkDivPtr[idx]) : (256);
+            uint64_t unit = (uint64_t)div * timeUnit;
+            
+            /* Period is PRx + 1 counts (nearest count within PRx range) */
+            uint64_t counts = (target + unit / 2) / unit;
+            counts = TimeoutCountsLimit(counts, maxCounts);
+            
+            uint64_t error = (counts * unit > target) ? (counts * unit - target) : (target - counts * unit);
+            if( (error > maxError) || (isFound && (error >= bestError)) )
+            {
+                continue;
+            }
+            
+            isFound = true;
+            bestError = error;
+            solutionPtr->bitMode = mode;
+            solutionPtr->clkDiv = clkDivPtr[idx];
+            solutionPtr->prValue = (uint32_t)(counts - 1);
+            solutionPtr->period = (uint32_t)((counts * unit + clkFreq / 2) / clkFreq);
+        }
     }
-    else if (IsrTimeout9HandlerPtr == IsrDefaultHandler)
+    
+    return isFound;
+}
+
+
+/*
+ *  Configures a specific timer for timeout mode with pre-scaler and bit mode
+ *  chosen by TMR_SolveTimeoutPeriod() and sets its period (achieved period is
+ *  written to periodPtr, if not NULL)
+ *  Returns false if any input restriction is triggered
+ */
+extern bool TMR_ConfigTimeoutModeAuto(TmrSfr_t *const tmrSfr, uint32_t period, uint32_t tolerance, TmrTimeUnit_t timeUnit, uint32_t *const periodPtr)
+{
+    TmrTimeoutSolution_t solution;
+    
+    if( !TMR_SolveTimeoutPeriod(tmrSfr, OSC_GetPbFreq(), period, tolerance, timeUnit, &solution) )
     {
-        IsrTimeout9HandlerPtr = isrHandler;
+        return false;
     }
-    /* No empty handler */
-    else
+    
+    TmrTimeoutConfig_t tmrConfig = {
+        .bitMode = solution.bitMode,
+        .clkDiv = solution.clkDiv,
+        .clkSrc = TMR_CLK_SRC_PBCLK,
+        .timeUnit = timeUnit
+    };
+    
+    if( !TMR_ConfigTimeoutModeSfr(tmrSfr, tmrConfig) )
     {
         return false;
     }
     
-    /* Store address of given handler */
-    isrHandlerAddr[addrIdx] = (uint32_t)isrHandler;
-    addrIdx++;
+    tmrSfr->TMRxPR.SET = solution.prValue;
     
-    /* Configure and enable CT the first time a callback is set */
-    static bool isCoreTimerConfigured = false;
-    if( isCoreTimerConfigured == false )
+    if( periodPtr != NULL )
     {
-        icSfr->ICxINTCON.SET = IC_MVEC_MASK;
-        icSfr->ICxIEC0.CLR = IC_CTIE_MASK;
-        icSfr->ICxIPC0.CLR = (IC_CTIS_MASK | IC_CTIP_MASK);
-        icSfr->ICxIPC0.SET = ((CT_ICX_IPL << IC_CTIS_POS) | (CT_ICX_ISL << IC_CTIP_POS));
-        icSfr->ICxIFS0.CLR = IC_CTIF_MASK;
-        icSfr->ICxIEC0.SET = IC_CTIE_MASK;
-        
-        isCoreTimerConfigured = true;
-        coreTimerPeriod = CORE_TIMER_PERIOD_MS * (OSC_GetSysFreq() / 1000 / 2);
-        _CP0_SET_COMPARE(_CP0_GET_COUNT() + coreTimerPeriod);
+        *periodPtr = solution.period;
     }
     
     return true;
@@ -437,310 +665,1240 @@ extern bool TMR_SetCoreTimerCallback(void (*isrHandler)(void))
 
 
 /*
- *  Set timeout period for specific timer
+ *  Starts deadline expiring after delay (in time unit), converted with the
+ *  current SYSCLK (core timer counts every other SYSCLK)
+ *  Returns false if any input restriction is triggered
  */
-extern bool TMR_SetTimeoutPeriod(TmrSfr_t *const tmrSfr, uint32_t period)
+extern bool TMR_StartDeadline(TmrDeadline_t *const deadlinePtr, uint32_t delay, TmrTimeUnit_t timeUnit)
 {
-    /* Timer base address check */
-    if( !(tmrSfr == &TMR1_MODULE) && !(tmrSfr == &TMR2_MODULE) && 
-        !(tmrSfr == &TMR3_MODULE) && !(tmrSfr == &TMR4_MODULE) &&
-        !(tmrSfr == &TMR5_MODULE) )
+    /* Input protection */
+    if( deadlinePtr == NULL )
     {
         return false;
     }
     
-    /* PRx = 0 does not generate interrupt flag */
-    if( period == 0 )
-    {
-        return false;
-    }
+    uint64_t length = ((uint64_t)delay * (OSC_GetSysFreq() / 2)) / timeUnit;
     
-    /* No period setting in gated mode */
-    if( tmrSfr->TMRxCON.W & TMR_TGATE_MASK )
+    /* Expiry check is wrap-safe only within half of counter range */
+    if( length > DEADLINE_MAX_COUNT )
     {
         return false;
     }
     
-    /* Reset counter */
-    tmrSfr->TMRxTMR.CLR = 0xFFFFFFFF;
-    tmrSfr->TMRxPR.CLR = 0xFFFFFFFF;
-    
-    /* Get timeout info for specific timer (set during configuration) */
-    TmrToutParam_t toutParam = TimeoutParamRead(tmrSfr);
-    
-    /* Calculate compare value */
-    tmrSfr->TMRxPR.SET = ((uint64_t)period * toutParam.sysClk) / (toutParam.clkDiv * toutParam.timeUnit);
+    deadlinePtr->start = _CP0_GET_COUNT();
+    deadlinePtr->length = (uint32_t)length;
     
     return true;
 }
 
-/******************************************************************************/
-/*------------------------Local Function Definitions--------------------------*/
-/******************************************************************************/
 
 /*
- *  Configures interrupt SFRs for timer modules
+ *  Returns time left until deadline expires (in time unit, 0 if expired or
+ *  deadline is NULL)
  */
-INLINE static void InterruptSfrConfig(TmrSfr_t *tmrSfr)
+extern uint32_t TMR_GetDeadlineRemaining(TmrDeadline_t *const deadlinePtr, TmrTimeUnit_t timeUnit)
 {
-    icSfr->ICxINTCON.SET = IC_MVEC_MASK;    // Multi-vector interrupt mode
-    
-    /* (Sub)priority for Timer1 */
-    if( tmrSfr == &TMR1_MODULE )
+    /* Input protection */
+    if( deadlinePtr == NULL )
     {
-        icSfr->ICxIFS0.CLR = IC_T1IF_MASK;
-        icSfr->ICxIEC0.CLR = IC_T1IE_MASK;
-        icSfr->ICxIPC1.CLR = (IC_T1IS_MASK | IC_T1IP_MASK);
-        icSfr->ICxIPC1.SET = ((TMR1_ICX_ISL << IC_T1IS_POS) | (TMR1_ICX_IPL << IC_T1IP_POS));
-        icSfr->ICxIEC0.SET = IC_T1IE_MASK;
+        return 0;
     }
-    /* (Sub)priority for Timer2 */
-    else if( tmrSfr == &TMR2_MODULE )
+    
+    uint32_t elapsed = _CP0_GET_COUNT() - deadlinePtr->start;
+    
+    if( elapsed >= deadlinePtr->length )
     {
-        icSfr->ICxIFS0.CLR = IC_T2IF_MASK;
-        icSfr->ICxIEC0.CLR = IC_T2IE_MASK;
-        icSfr->ICxIPC2.CLR = (IC_T2IS_MASK | IC_T2IP_MASK);
-        icSfr->ICxIPC2.SET = ((TMR2_ICX_ISL << IC_T2IS_POS) | (TMR2_ICX_IPL << IC_T2IP_POS));
-        icSfr->ICxIEC0.SET = IC_T2IE_MASK;
+        return 0;
     }
-    /* (Sub)priority for Timer3 */
-    else if( tmrSfr == &TMR3_MODULE )
+    
+    return (uint32_t)(((uint64_t)(deadlinePtr->length - elapsed) * timeUnit) / (OSC_GetSysFreq() / 2));
+}
+
+
+/*
+ *  Waits until deadline expires, executing yield hook meanwhile
+ */
+extern void TMR_WaitDeadline(TmrDeadline_t *const deadlinePtr)
+{
+    while( !TMR_IsDeadlineExpired(deadlinePtr) )
     {
-        icSfr->ICxIFS0.CLR = IC_T3IF_MASK;
-        icSfr->ICxIEC0.CLR = IC_T3IE_MASK;
-        icSfr->ICxIPC3.CLR = (IC_T3IS_MASK | IC_T3IP_MASK);
-        icSfr->ICxIPC3.SET = ((TMR3_ICX_ISL << IC_T3IS_POS) | (TMR3_ICX_IPL << IC_T3IP_POS));
-        icSfr->ICxIEC0.SET = IC_T3IE_MASK;
+        DelayYieldHandlerPtr();
     }
-    /* (Sub)priority for Timer4 */
-    else if( tmrSfr == &TMR4_MODULE )
+}
+
+
+/*
+ *  Sets function executed while waiting in TMR_WaitDeadline() and delay
+ *  functions (NULL restores empty handler)
+ */
+extern void TMR_SetDelayYieldHook(void (*yieldHandler)(void))
+{
+    DelayYieldHandlerPtr = (yieldHandler != NULL) ? yieldHandler : IsrDefaultHandler;
+}
+
+
+/*
+ *  Generates microsecond delay using Core Timer
+ */
+extern void TMR_DelayUs(uint32_t delay)
+{
+    DelayChunked(delay, TMR_TIME_UNIT_US, 1000000);
+}
+
+
+/*
+ *  Generates millisecond delay using Core Timer
+ */
+extern void TMR_DelayMs(uint32_t delay)
+{
+    DelayChunked(delay, TMR_TIME_UNIT_MS, 1000);
+}
+
+
+/*
+ *  Starts continuous pulse width capture on timer configured in gated mode
+ *  (lower timer of 32-bit pair). Each gate pulse is stored with its core timer
+ *  timestamp into user buffer (size must be power of two)
+ *  Returns false if any input restriction is triggered
+ */
+extern bool TMR_StartPulseCapture(TmrSfr_t *const tmrSfr, TmrPulse_t *const bufferPtr, uint32_t bufferSize)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    /* Input protection */
+    if( (descPtr == NULL) || (bufferPtr == NULL) || (bufferSize == 0) ||
+        ((bufferSize & (bufferSize - 1)) != 0) )
     {
-        icSfr->ICxIFS0.CLR = IC_T4IF_MASK;
-        icSfr->ICxIEC0.CLR = IC_T4IE_MASK;
-        icSfr->ICxIPC4.CLR = (IC_T4IS_MASK | IC_T4IP_MASK);
-        icSfr->ICxIPC4.SET = ((TMR4_ICX_ISL << IC_T4IS_POS) | (TMR4_ICX_IPL << IC_T4IP_POS));
-        icSfr->ICxIEC0.SET = IC_T4IE_MASK;
+        return false;
     }
-    /* (Sub)priority for Timer5 */
-    else
+    
+    TmrPulseCapture_t *capturePtr = &descPtr->statePtr->pulseCapture;
+    
+    /* Gated mode check */
+    if( !(tmrSfr->TMRxCON.W & TMR_TGATE_MASK) )
     {
-        icSfr->ICxIFS0.CLR = IC_T5IF_MASK;
-        icSfr->ICxIEC0.CLR = IC_T5IE_MASK;
-        icSfr->ICxIPC5.CLR = (IC_T5IS_MASK | IC_T5IP_MASK);
-        icSfr->ICxIPC5.SET = ((TMR5_ICX_ISL << IC_T5IS_POS) | (TMR5_ICX_IPL << IC_T5IP_POS));
-        icSfr->ICxIEC0.SET = IC_T5IE_MASK;
+        return false;
     }
+    
+    tmrSfr->TMRxCON.CLR = TMR_ON_MASK;
+    
+    capturePtr->mask = bufferSize - 1;
+    capturePtr->head = 0;
+    capturePtr->tail = 0;
+    capturePtr->overrunCount = 0;
+    capturePtr->count = 0;
+    capturePtr->minWidth = 0xFFFFFFFF;
+    capturePtr->maxWidth = 0;
+    capturePtr->sumWidth = 0;
+    capturePtr->bufferPtr = bufferPtr;
+    
+    /* Timer must not be stopped after a pulse */
+    descPtr->statePtr->status.isGateCont = true;
+    
+    TMR_StartTimer(tmrSfr);
+    
+    return true;
 }
 
 
 /*
- *  Stores parameters needed for calculation of PRx value into local structure
+ *  Stops pulse width capture (stored pulses and statistics remain readable)
+ *  Returns false if any input restriction is triggered
  */
-INLINE static void TimeoutParamSet(TmrSfr_t *const tmrSfr, uint32_t sysClk, uint32_t clkDiv, uint32_t timeUnit)
+extern bool TMR_StopPulseCapture(TmrSfr_t *const tmrSfr)
 {
-    /* Offset index = (&TMRx - &TMR1) / (TMR(x+1) - TMRx) */
-    uint32_t regOffset = ( (uint32_t)&tmrSfr->TMRxCON.W - (uint32_t)&TMR1_MODULE.TMRxCON.W ) / 0x200;
+    TmrPulseCapture_t *capturePtr = PulseCaptureGet(tmrSfr);
     
-    uint32_t structRegOffset = regOffset * sizeof(TmrToutParam_t);
-    uint32_t structRegBase = (uint32_t)&toutParam.t1.sysClk;
+    /* Input protection */
+    if( capturePtr == NULL )
+    {
+        return false;
+    }
     
-    /* Pointer to x-th member of structure (for TMRx timeout parameters) */
-    volatile uint32_t *toutParamPtr = (uint32_t *)(structRegBase + structRegOffset);
+    TMR_StopTimer(tmrSfr);
+    capturePtr->bufferPtr = NULL;
     
-    /* Modify members through pointer */
-    *(toutParamPtr + 0) = OSC_GetSysFreq();
-    *(toutParamPtr + 1) = (clkDiv <= 6) ? (1 << clkDiv) : (256);
-    *(toutParamPtr + 2) = timeUnit;
+    return true;
 }
 
 
 /*
- *  Reads parameters needed for calculation of PRx value from local structure
+ *  Copies up to maxCount oldest captured pulses and releases them
+ *  Returns number of copied pulses
  */
-INLINE static TmrToutParam_t TimeoutParamRead(TmrSfr_t *const tmrSfr)
+extern uint32_t TMR_ReadPulses(TmrSfr_t *const tmrSfr, TmrPulse_t *const destPtr, uint32_t maxCount)
 {
-    /* Offset index = (&TMRx - &TMR1) / (TMR(x+1) - TMRx) */
-    uint32_t regOffset = ( (uint32_t)&tmrSfr->TMRxCON.W - (uint32_t)&TMR1_MODULE.TMRxCON.W ) / 0x200;
+    TmrPulseCapture_t *capturePtr = PulseCaptureGet(tmrSfr);
     
-    uint32_t structRegOffset = regOffset * sizeof(TmrToutParam_t);
-    uint32_t structRegBase = (uint32_t)&toutParam.t1.sysClk;
+    /* Input protection */
+    if( (capturePtr == NULL) || (capturePtr->bufferPtr == NULL) || (destPtr == NULL) )
+    {
+        return 0;
+    }
     
-    /* Pointer to x-th member of structure (for TMRx timeout parameters) */
-    volatile uint32_t *toutParamPtr = (uint32_t *)(structRegBase + structRegOffset);
+    /* Head is only written by ISR, tail only here */
+    uint32_t tail = capturePtr->tail;
+    uint32_t available = capturePtr->head - tail;
+    uint32_t count = (available < maxCount) ? available : maxCount;
     
-    TmrToutParam_t toutParam;
+    for( uint32_t idx = 0; idx < count; idx++ )
+    {
+        destPtr[idx] = capturePtr->bufferPtr[(tail + idx) & capturePtr->mask];
+    }
     
-    /* Read members through pointer */
-    toutParam.sysClk = *(toutParamPtr + 0);
-    toutParam.clkDiv = *(toutParamPtr + 1);
-    toutParam.timeUnit = *(toutParamPtr + 2);
+    capturePtr->tail = tail + count;
     
-    return toutParam;
+    return count;
 }
 
 
 /*
- *  Sets flags read in ISR for checking if 32-bit or continuous gate mode is set
+ *  Reads running pulse width statistics (mean is divided only here)
+ *  Returns false if any input restriction is triggered
  */
-INLINE static void IsrFlagSet(TmrSfr_t *const tmrSfr, bool isMode32, bool isGateCont)
+extern bool TMR_GetPulseStats(TmrSfr_t *const tmrSfr, TmrPulseStats_t *const statsPtr)
 {
-    /* Offset index = (&TMRx - &TMR1) / (TMR(x+1) - TMRx) */
-    uint32_t regOffset = ( (uint32_t)&tmrSfr->TMRxCON.W - (uint32_t)&TMR1_MODULE.TMRxCON.W ) / 0x200;
+    TmrPulseCapture_t *capturePtr = PulseCaptureGet(tmrSfr);
+    
+    /* Input protection */
+    if( (capturePtr == NULL) || (statsPtr == NULL) )
+    {
+        return false;
+    }
+    
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Consistent snapshot of statistics
     
-    uint32_t structRegOffset = regOffset * sizeof(TmrStatus_t);
-    uint32_t structRegBase = (uint32_t)&isrFlag.t1.isMode32;
+    statsPtr->count = capturePtr->count;
+    statsPtr->overrunCount = capturePtr->overrunCount;
+    statsPtr->minWidth = capturePtr->minWidth;
+    statsPtr->maxWidth = capturePtr->maxWidth;
+    uint64_t sumWidth = capturePtr->sumWidth;
     
-    /* Pointer to x-th member of structure (for TMRx configuration flags) */
-    volatile uint8_t *configFlagPtr = (uint8_t *)(structRegBase + structRegOffset);
+    IC_SetInterruptState(intrStatus);
     
-    /* Modify members through pointer */
-    *(configFlagPtr + 0) = isMode32;
-    *(configFlagPtr + 1) = isGateCont;
+    statsPtr->meanWidth = (statsPtr->count > 0) ? (uint32_t)(sumWidth / statsPtr->count) : 0;
+    
+    return true;
 }
 
 
 /*
- *  Empty default ISR handler
+ *  Starts sampling of configured source on every timeout of timer configured
+ *  in timeout mode (lower timer of 32-bit pair). Samples are written into two
+ *  alternating blocks, a full block is handed to user at the next timeout
+ *  Returns false if any input restriction is triggered
  */
-static void IsrDefaultHandler(void)
+extern bool TMR_StartSampling(TmrSfr_t *const tmrSfr, TmrSampleConfig_t sampleConfig)
 {
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
     
-}
-
-/******************************************************************************/
-/*-----------------------------ISR  Definitions-------------------------------*/
-/******************************************************************************/
-
-void __ISR(TIMER_1_VECTOR, TMR1_ISR_IPL) ISR_Tmr1(void)
-{
-    if( (icSfr->ICxIEC0.W & IC_T1IE_MASK) && (icSfr->ICxIFS0.W & IC_T1IF_MASK) )
-    {   
-        icSfr->ICxIFS0.CLR = IC_T1IF_MASK;
+    /* Input protection */
+    if( (descPtr == NULL) || (sampleConfig.blockSize == 0) ||
+        (sampleConfig.blockPtr[0] == NULL) || (sampleConfig.blockPtr[1] == NULL) )
+    {
+        return false;
+    }
+    
+    /* Source check */
+    if( ((sampleConfig.source == TMR_SAMPLE_SRC_PORT) && (sampleConfig.pioSfr == NULL)) ||
+        ((sampleConfig.source == TMR_SAMPLE_SRC_HANDLER) && (sampleConfig.sampleHandler == NULL)) ||
+        (sampleConfig.source > TMR_SAMPLE_SRC_HANDLER) )
+    {
+        return false;
+    }
+    
+    /* Timeout mode check */
+    if( tmrSfr->TMRxCON.W & TMR_TGATE_MASK )
+    {
+        return false;
+    }
+    
+    TmrSampling_t *samplingPtr = &descPtr->statePtr->sampling;
+    
+    tmrSfr->TMRxCON.CLR = TMR_ON_MASK;
+    
+    samplingPtr->source = sampleConfig.source;
+    samplingPtr->pioSfr = sampleConfig.pioSfr;
+    samplingPtr->sampleHandler = sampleConfig.sampleHandler;
+    samplingPtr->blockPtr[0] = sampleConfig.blockPtr[0];
+    samplingPtr->blockPtr[1] = sampleConfig.blockPtr[1];
+    samplingPtr->blockSize = sampleConfig.blockSize;
+    samplingPtr->fillIdx = 0;
+    samplingPtr->fillBlock = 0;
+    samplingPtr->isReady[0] = false;
+    samplingPtr->isReady[1] = false;
+    samplingPtr->overrunCount = 0;
+    samplingPtr->isOn = true;
+    
+    /* Timer must not be stopped after timeout */
+    descPtr->statePtr->status.isGateCont = true;
+    
+    TMR_StartTimer(tmrSfr);
+    
+    return true;
+}
+
+
+/*
+ *  Stops timer-triggered sampling
+ *  Returns false if any input restriction is triggered
+ */
+extern bool TMR_StopSampling(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    /* Input protection */
+    if( descPtr == NULL )
+    {
+        return false;
+    }
+    
+    TMR_StopTimer(tmrSfr);
+    descPtr->statePtr->sampling.isOn = false;
+    
+    return true;
+}
+
+
+/*
+ *  Returns full block of samples handed over by ISR (NULL if none is ready).
+ *  Block remains owned by user until TMR_ReleaseSampleBlock() is called
+ */
+extern volatile uint32_t *TMR_GetSampleBlock(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    /* Input protection */
+    if( descPtr == NULL )
+    {
+        return NULL;
+    }
+    
+    TmrSampling_t *samplingPtr = &descPtr->statePtr->sampling;
+    
+    /* At most one block is ready at a time */
+    for( uint32_t idx = 0; idx < 2; idx++ )
+    {
+        if( samplingPtr->isReady[idx] )
+        {
+            return samplingPtr->blockPtr[idx];
+        }
+    }
+    
+    return NULL;
+}
+
+
+/*
+ *  Returns block obtained by TMR_GetSampleBlock() to ISR
+ *  Returns false if no block was ready
+ */
+extern bool TMR_ReleaseSampleBlock(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    /* Input protection */
+    if( descPtr == NULL )
+    {
+        return false;
+    }
+    
+    TmrSampling_t *samplingPtr = &descPtr->statePtr->sampling;
+    
+    for( uint32_t idx = 0; idx < 2; idx++ )
+    {
+        if( samplingPtr->isReady[idx] )
+        {
+            samplingPtr->isReady[idx] = false;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+/*
+ *  Returns number of blocks overwritten because user had not released the
+ *  previous one in time
+ */
+extern uint32_t TMR_GetSampleOverrunCount(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    return (descPtr != NULL) ? descPtr->statePtr->sampling.overrunCount : 0;
+}
+
+
+/*
+ *  Configures TMR2/TMR3 pair as free-running 64-bit timebase (TMR3 period
+ *  interrupt extends 32-bit count) and starts it
+ *  Returns false if any input restriction is triggered
+ */
+extern bool TMR_ConfigTimebaseSfr(TmrClkDiv_t clkDiv)
+{
+    /* Input protection */
+    if( clkDiv > TMR_CLK_DIV_256 )
+    {
+        return false;
+    }
+    
+    /* Disable and clear both timers of 32-bit pair */
+    TMR2_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+    TMR3_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+    asm("nop");
+    TMR2_MODULE.TMRxCON.CLR = 0xFFFFFFFF;
+    TMR3_MODULE.TMRxCON.CLR = 0xFFFFFFFF;
+    TMR2_MODULE.TMRxTMR.CLR = 0xFFFFFFFF;
+    TMR3_MODULE.TMRxTMR.CLR = 0xFFFFFFFF;
+    TMR3_MODULE.TMRxPR.CLR = 0xFFFFFFFF;
+    
+    /* Full 32-bit period, TMR3 interrupt is triggered on every wrap */
+    TMR2_MODULE.TMRxCON.SET = (TMR_BITMODE_32BIT << TMR_T32_POS) | (clkDiv << TMR_TCKPS_POS);
+    TMR2_MODULE.TMRxPR.SET = 0xFFFFFFFF;
+    
+    /* Precompute tick conversion factors (no division on conversion) */
+    uint32_t div = (clkDiv <= 6) ? (1 << clkDiv) : (256);
+    timebaseNsScale = ScaleGet((uint64_t)1000000000 * div, OSC_GetPbFreq());
+    timebaseUsScale = ScaleGet((uint64_t)1000000 * div, OSC_GetPbFreq());
+    timebaseTickBase = 0;
+    timebaseNsBase = 0;
+    timebaseUsBase = 0;
+    timebaseGeneration++;
+    OSC_AddClkHook(ClkPreHook, ClkPostHook);
+    
+    timebaseHigh = 0;
+    isTimebaseOn = true;
+    
+    /* Timer is never stopped in ISR */
+    tmrState[1].status.isMode32 = true;
+    tmrState[1].status.isGateCont = true;
+    InterruptSfrConfig(&tmrDesc[2]);
+    IC_EnableInterrupts();
+    
+    TMR2_MODULE.TMRxCON.SET = TMR_ON_MASK;
+    
+    return true;
+}
+
+
+/*
+ *  Reads 64-bit timebase count without locking (upper word is re-read until
+ *  stable, pending wrap is accounted for if ISR has not executed yet)
+ */
+extern uint64_t TMR_ReadTimebase(void)
+{
+    uint32_t high;
+    uint32_t low;
+    bool isWrapPending;
+    
+    do
+    {
+        high = timebaseHigh;
+        low = TMR2_MODULE.TMRxTMR.W;
+        isWrapPending = (icSfr->ICxIFS0.W & IC_T3IF_MASK) != 0;
+    } while( high != timebaseHigh );
+    
+    /* Low word was read after the (not yet counted) wrap */
+    if( isWrapPending && (low < 0x80000000) )
+    {
+        high++;
+    }
+    
+    return ((uint64_t)high << 32) | low;
+}
+
+
+/*
+ *  Converts timebase count to nanoseconds (fixed-point, integer only)
+ */
+extern uint64_t TMR_TimebaseToNs(uint64_t ticks)
+{
+    return TimebaseConvert(ticks, &timebaseNsBase, &timebaseNsScale);
+}
+
+
+/*
+ *  Converts timebase count to microseconds (fixed-point, integer only)
+ */
+extern uint64_t TMR_TimebaseToUs(uint64_t ticks)
+{
+    return TimebaseConvert(ticks, &timebaseUsBase, &timebaseUsScale);
+}
+
+
+/*
+ *  Set timeout period for specific timer
+ */
+extern bool TMR_SetTimeoutPeriod(TmrSfr_t *const tmrSfr, uint32_t period)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    /* Timer base address check */
+    if( descPtr == NULL )
+    {
+        return false;
+    }
+    
+    /* PRx = 0 does not generate interrupt flag */
+    if( period == 0 )
+    {
+        return false;
+    }
+    
+    /* No period setting in gated mode */
+    if( tmrSfr->TMRxCON.W & TMR_TGATE_MASK )
+    {
+        return false;
+    }
+    
+    /* Reset counter */
+    tmrSfr->TMRxTMR.CLR = 0xFFFFFFFF;
+    tmrSfr->TMRxPR.CLR = 0xFFFFFFFF;
+    
+    /* Calculate compare value (multiplication by factor cached during
+     * configuration), period is PRx + 1 counts as in TMR_SolveTimeoutPeriod() */
+    const TmrToutParam_t *toutParamPtr = &descPtr->statePtr->toutParam;
+    uint64_t unit = (uint64_t)toutParamPtr->clkDiv * toutParamPtr->timeUnit;
+    
+    /* Timer not configured */
+    if( unit == 0 )
+    {
+        return false;
+    }
+    
+    uint64_t limit = (uint64_t)period * toutParamPtr->clkFreq + unit / 2;
+    uint64_t counts = ScaleApply(period, toutParamPtr->prScale);
+    
+    /* Cached factor is truncated, count is corrected to nearest one (no
+     * division) */
+    while( (counts > 0) && (counts * unit > limit) )
+    {
+        counts--;
+    }
+    while( (counts + 1) * unit <= limit )
+    {
+        counts++;
+    }
+    
+    counts = TimeoutCountsLimit(counts, descPtr->statePtr->status.isMode32 ? 0x100000000 : 0x10000);
+    tmrSfr->TMRxPR.SET = (uint32_t)(counts - 1);
+    
+    return true;
+}
+
+
+/*
+ *  Calculates time period of timer count in time unit of timeout mode
+ *  (microseconds in gated mode)
+ */
+extern uint32_t TMR_ReadTimerPeriod(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    /* Timer base address check */
+    if( descPtr == NULL )
+    {
+        return 0;
+    }
+    
+    const TmrToutParam_t *toutParamPtr = &descPtr->statePtr->toutParam;
+    
+    /* Timer not configured */
+    if( toutParamPtr->timeUnit == 0 )
+    {
+        return 0;
+    }
+    
+    uint32_t count = tmrSfr->TMRxTMR.W;
+    uint64_t limit = (uint64_t)count * toutParamPtr->clkDiv * toutParamPtr->timeUnit;
+    uint64_t time = ScaleApply(count, toutParamPtr->timeScale);
+    
+    /* Cached factor is truncated, time is corrected to the exact quotient (no
+     * division) */
+    while( (time + 1) * toutParamPtr->clkFreq <= limit )
+    {
+        time++;
+    }
+    
+    return (time > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)time;
+}
+
+/******************************************************************************/
+/*------------------------Local Function Definitions--------------------------*/
+/******************************************************************************/
+
+/*
+ *  Configures interrupt SFRs for timer modules
+ */
+INLINE static void InterruptSfrConfig(const TmrDesc_t *const descPtr)
+{
+    icSfr->ICxINTCON.SET = IC_MVEC_MASK;    // Multi-vector interrupt mode
+    
+    /* (Sub)priority for Timer */
+    icSfr->ICxIFS0.CLR = descPtr->ifsMask;
+    icSfr->ICxIEC0.CLR = descPtr->iecMask;
+    descPtr->ipcSfr->CLR = descPtr->ipcMask;
+    descPtr->ipcSfr->SET = descPtr->ipcValue;
+    icSfr->ICxIEC0.SET = descPtr->iecMask;
+}
+
+
+/*
+ *  Stores parameters needed for calculation of PRx value into timer state
+ *  (fixed-point factors are cached, so no division is needed afterwards)
+ */
+INLINE static void TimeoutParamSet(const TmrDesc_t *const descPtr, uint32_t timeUnit)
+{
+    TmrToutParam_t *toutParamPtr = &descPtr->statePtr->toutParam;
+    uint32_t div = ClkDivRead(descPtr->tmrSfr);
+    uint32_t pbClk = OSC_GetPbFreq();
+    
+    /* Timer counts at PBCLK / prescaler */
+    toutParamPtr->clkFreq = pbClk;
+    toutParamPtr->clkDiv = div;
+    toutParamPtr->timeUnit = timeUnit;
+    toutParamPtr->prScale = ScaleGet(pbClk, div * timeUnit);
+    toutParamPtr->timeScale = ScaleGet((uint64_t)timeUnit * div, pbClk);
+}
+
+
+/*
+ *  Takes one sample of configured source (called in ISR). Full block is handed
+ *  over one timeout later, so that reads queued by sample handler complete
+ */
+INLINE static void SampleStore(const TmrDesc_t *const descPtr)
+{
+    TmrSampling_t *samplingPtr = &descPtr->statePtr->sampling;
+    
+    if( !samplingPtr->isOn )
+    {
+        return;
+    }
+    
+    if( samplingPtr->fillIdx == samplingPtr->blockSize )
+    {
+        uint32_t nextBlock = samplingPtr->fillBlock ^ 1;
+        
+        /* Refill the same block if user still owns the other one */
+        if( samplingPtr->isReady[nextBlock] )
+        {
+            samplingPtr->overrunCount++;
+        }
+        else
+        {
+            samplingPtr->isReady[samplingPtr->fillBlock] = true;
+            samplingPtr->fillBlock = nextBlock;
+        }
+        
+        samplingPtr->fillIdx = 0;
+    }
+    
+    volatile uint32_t *samplePtr = &samplingPtr->blockPtr[samplingPtr->fillBlock][samplingPtr->fillIdx];
+    samplingPtr->fillIdx++;
+    
+    if( samplingPtr->source == TMR_SAMPLE_SRC_PORT )
+    {
+        *samplePtr = samplingPtr->pioSfr->PIOxPORT.W;
+    }
+    else
+    {
+        samplingPtr->sampleHandler(samplePtr);
+    }
+}
+
+
+/*
+ *  Returns descriptor of timer (NULL if not a timer base address)
+ */
+INLINE static const TmrDesc_t *DescGet(TmrSfr_t *const tmrSfr)
+{
+    for( uint32_t idx = 0; idx < TMR_INSTANCE_COUNT; idx++ )
+    {
+        if( tmrDesc[idx].tmrSfr == tmrSfr )
+        {
+            return &tmrDesc[idx];
+        }
+    }
+    
+    return NULL;
+}
+
+
+/*
+ *  Common ISR body of timers (not inlined, all vectors share one copy). Gate,
+ *  timebase and pulse capture handling applies to counting timer (lower timer
+ *  of 32-bit pair), user-defined function is the one of interrupting timer
+ */
+static void IsrDispatch(const TmrDesc_t *const descPtr)
+{
+    if( !(icSfr->ICxIEC0.W & descPtr->iecMask) || !(icSfr->ICxIFS0.W & descPtr->ifsMask) )
+    {
+        return;
+    }
+    
+    const TmrDesc_t *cntDescPtr = descPtr;
+    
+    /* 32-bit mode */
+    if( (descPtr->lowerIdx >= 0) && (tmrDesc[descPtr->lowerIdx].tmrSfr->TMRxCON.W & TMR_T32_MASK) )
+    {
+        cntDescPtr = &tmrDesc[descPtr->lowerIdx];
+    }
+    
+    /* Upper word of 64-bit timebase is incremented together with flag clear,
+     * so that no (higher priority) reader sees one without the other */
+    if( (cntDescPtr != descPtr) && isTimebaseOn && (cntDescPtr->tmrSfr == &TMR2_MODULE) )
+    {
+        uint32_t intrStatus = IC_GetInterruptState();
+        IC_DisableInterrupts();
+        
+        timebaseHigh++;
+        icSfr->ICxIFS0.CLR = descPtr->ifsMask;
+        
+        IC_SetInterruptState(intrStatus);
+    }
+    else
+    {
+        icSfr->ICxIFS0.CLR = descPtr->ifsMask;
+    }
+    
+    /* Leave timer ON only in continuous gating mode */
+    if( cntDescPtr->statePtr->status.isGateCont == false )
+    {
+        cntDescPtr->tmrSfr->TMRxCON.CLR = TMR_ON_MASK;  // Timer OFF
+    }
+    
+    /* Pulse width capture */
+    PulseCaptureStore(cntDescPtr);
+    
+    /* Timer-triggered sampling */
+    SampleStore(cntDescPtr);
+    
+    /* User-defined function */
+    IC_PROFILE_CALL(descPtr->profileSlot, descPtr->statePtr->isrHandler());
+}
+
+
+/*
+ *  Empty default ISR handler
+ */
+static void IsrDefaultHandler(void)
+{
+    
+}
+
+/*
+ *  Computes Q32.32 factor (numerator / denominator), used to replace division
+ *  with multiplication in conversions
+ */
+static TmrScale_t ScaleGet(uint64_t numerator, uint32_t denominator)
+{
+    uint64_t remainder = numerator % denominator;
+    
+    TmrScale_t scale;
+    scale.intPart = (uint32_t)(numerator / denominator);
+    scale.fracPart = (uint32_t)((remainder << 32) / denominator);
+    
+    return scale;
+}
+
+
+/*
+ *  Reads actual pre-scaler value of timer (only DIV_1/8/64/256 for TMR1)
+ */
+INLINE static uint32_t ClkDivRead(TmrSfr_t *const tmrSfr)
+{
+    uint32_t clkDiv = (tmrSfr->TMRxCON.W & TMR_TCKPS_MASK) >> TMR_TCKPS_POS;
+    uint32_t div = 0;
+    
+    if( tmrSfr == &TMR1_MODULE )
+    {
+        switch( clkDiv & 0x03 )
+        {
+            case 0: div = 1; break;
+            case 1: div = 8; break;
+            case 2: div = 64; break;
+            case 3: div = 256; break;
+        }
+    }
+    else
+    {
+        div = (clkDiv <= 6) ? (1 << clkDiv) : (256);
+    }
+    
+    return div;
+}
+
+
+/*
+ *  Translates pre-scaler to TMR1 TCKPS value (rounded down to DIV_1/8/64/256)
+ */
+INLINE static uint32_t Tmr1ClkDivGet(TmrClkDiv_t clkDiv)
+{
+    if( clkDiv >= TMR_CLK_DIV_256 )
+    {
+        return 3;
+    }
+    else if( clkDiv >= TMR_CLK_DIV_64 )
+    {
+        return 2;
+    }
+    else if( clkDiv >= TMR_CLK_DIV_8 )
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+
+/*
+ *  Waits for delay split into deadlines of at most maxChunk (in time unit),
+ *  so that delay length is not limited by core timer range
+ */
+static void DelayChunked(uint32_t delay, TmrTimeUnit_t timeUnit, uint32_t maxChunk)
+{
+    TmrDeadline_t deadline;
+    
+    while( delay > 0 )
+    {
+        uint32_t chunk = (delay < maxChunk) ? delay : maxChunk;
         
-        /* Leave timer ON only in continuous gating mode */
-        if( isrFlag.t1.isGateCont == false )
+        /* Chunk exceeds wrap-safe range only at unsupported SYSCLK */
+        if( !TMR_StartDeadline(&deadline, chunk, timeUnit) )
         {
-            TMR1_MODULE.TMRxCON.CLR = TMR_ON_MASK;      // Timer OFF
+            return;
         }
         
-        /* User-defined function */
-        Isr1HandlerPtr();
+        TMR_WaitDeadline(&deadline);
+        delay -= chunk;
     }
 }
 
 
-void __ISR(TIMER_2_VECTOR, TMR2_ISR_IPL) ISR_Tmr2(void)
+/*
+ *  Returns pulse capture state of timer (NULL if not a timer)
+ */
+INLINE static TmrPulseCapture_t *PulseCaptureGet(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+    
+    return (descPtr != NULL) ? &descPtr->statePtr->pulseCapture : NULL;
+}
+
+
+/*
+ *  Stores width of ended gate pulse and updates statistics (called in ISR,
+ *  counter is cleared for the next pulse while gate is low)
+ */
+INLINE static void PulseCaptureStore(const TmrDesc_t *const descPtr)
+{
+    TmrPulseCapture_t *capturePtr = &descPtr->statePtr->pulseCapture;
+    TmrSfr_t *tmrSfr = descPtr->tmrSfr;
+    
+    if( capturePtr->bufferPtr == NULL )
+    {
+        return;
+    }
+    
+    uint32_t width = tmrSfr->TMRxTMR.W;
+    tmrSfr->TMRxTMR.CLR = 0xFFFFFFFF;
+    
+    if( width < capturePtr->minWidth )
+    {
+        capturePtr->minWidth = width;
+    }
+    if( width > capturePtr->maxWidth )
+    {
+        capturePtr->maxWidth = width;
+    }
+    capturePtr->sumWidth += width;
+    capturePtr->count++;
+    
+    /* Newest pulse is dropped if buffer is full */
+    uint32_t head = capturePtr->head;
+    if( (head - capturePtr->tail) > capturePtr->mask )
+    {
+        capturePtr->overrunCount++;
+        return;
+    }
+    
+    capturePtr->bufferPtr[head & capturePtr->mask].width = width;
+    capturePtr->bufferPtr[head & capturePtr->mask].timestamp = _CP0_GET_COUNT();
+    capturePtr->head = head + 1;
+}
+
+
+/*
+ *  Multiplies ticks with Q32.32 factor (split into 32x32-bit products to avoid
+ *  96-bit intermediate result)
+ */
+INLINE static uint64_t ScaleApply(uint64_t ticks, TmrScale_t scale)
+{
+    uint32_t high = (uint32_t)(ticks >> 32);
+    uint32_t low = (uint32_t)ticks;
+    
+    return ticks * scale.intPart +
+           (uint64_t)high * scale.fracPart +
+           (((uint64_t)low * scale.fracPart) >> 32);
+}
+
+
+/*
+ *  Limits timeout period counts to PRx range (PRx = 0 does not generate
+ *  interrupt flag, so at least 2 counts)
+ */
+INLINE static uint64_t TimeoutCountsLimit(uint64_t counts, uint64_t maxCounts)
 {
-    if( (icSfr->ICxIEC0.W & IC_T2IE_MASK) && (icSfr->ICxIFS0.W & IC_T2IF_MASK) )
-    {   
-        icSfr->ICxIFS0.CLR = IC_T2IF_MASK;
-                
-        /* Leave timer ON only in continuous gating mode */
-        if( isrFlag.t2.isGateCont == false )
+    if( counts < 2 )
+    {
+        return 2;
+    }
+    else if( counts > maxCounts )
+    {
+        return maxCounts;
+    }
+    
+    return counts;
+}
+
+
+/*
+ *  Converts timebase count relative to count of last clock change (counts
+ *  before it are converted backwards with current factor, clamped at 0)
+ */
+static uint64_t TimebaseConvert(uint64_t ticks, const volatile uint64_t *basePtr, const volatile TmrScale_t *scalePtr)
+{
+    uint32_t generation;
+    uint64_t time;
+    
+    /* Convert again if clock changed in the meantime (from ISR) */
+    do
+    {
+        generation = timebaseGeneration;
+        
+        uint64_t tickBase = timebaseTickBase;
+        uint64_t base = *basePtr;
+        TmrScale_t scale = *scalePtr;
+        
+        if( ticks >= tickBase )
+        {
+            time = base + ScaleApply(ticks - tickBase, scale);
+        }
+        else
         {
-            TMR2_MODULE.TMRxCON.CLR = TMR_ON_MASK;      // Timer OFF
+            uint64_t back = ScaleApply(tickBase - ticks, scale);
+            time = (back < base) ? (base - back) : 0;
         }
+    }
+    while( generation != timebaseGeneration );
+    
+    return time;
+}
+
+
+/*
+ *  Configures and enables CT interrupt the first time it is used
+ */
+static void CoreTimerConfig(void)
+{
+    static bool isCoreTimerConfigured = false;
+    if( isCoreTimerConfigured == false )
+    {
+        icSfr->ICxINTCON.SET = IC_MVEC_MASK;
+        icSfr->ICxIEC0.CLR = IC_CTIE_MASK;
+        icSfr->ICxIPC0.CLR = (IC_CTIS_MASK | IC_CTIP_MASK);
+        icSfr->ICxIPC0.SET = ((CT_ICX_IPL << IC_CTIS_POS) | (CT_ICX_ISL << IC_CTIP_POS));
+        icSfr->ICxIFS0.CLR = IC_CTIF_MASK;
+        icSfr->ICxIEC0.SET = IC_CTIE_MASK;
         
-        /* User-defined function */
-        Isr2HandlerPtr();
+        isCoreTimerConfigured = true;
+        coreTimerPeriod = CORE_TIMER_PERIOD_MS * (OSC_GetSysFreq() / 1000 / 2);
+        coreTimerBase = _CP0_GET_COUNT();
+        _CP0_SET_COMPARE(coreTimerBase + TMR_WHEEL_SLOTS * TMR_WHEEL_SLOTS * coreTimerPeriod);
+        OSC_AddClkHook(ClkPreHook, ClkPostHook);
     }
 }
 
-void __ISR(TIMER_3_VECTOR, TMR3_ISR_IPL) ISR_Tmr3(void)
+
+/*
+ *  Saves clock tree and timebase count before clock change (used by
+ *  ClkPostHook())
+ */
+static void ClkPreHook(const OscClkState_t *const statePtr)
+{
+    clkStateOld = *statePtr;
+    
+    /* Timebase counts up to here are converted with old factors */
+    if( isTimebaseOn )
+    {
+        timebaseSwitchTick = TMR_ReadTimebase();
+    }
+}
+
+
+/*
+ *  Rescales timer periods, core timer tick and timebase factors to new clock
+ *  tree, so that timers keep their periods without reconfiguration
+ */
+static void ClkPostHook(const OscClkState_t *const statePtr)
 {
-    if( (icSfr->ICxIEC0.W & IC_T3IE_MASK) && (icSfr->ICxIFS0.W & IC_T3IF_MASK) )
-    {   
-        icSfr->ICxIFS0.CLR = IC_T3IF_MASK;
-                
-        /* 32-bit mode */
-        if( TMR2_MODULE.TMRxCON.W & TMR_T32_MASK )
+    uint32_t intrStatus = IC_GetInterruptState();
+    IC_DisableInterrupts();             // Parameters are also used by ISRs
+    
+    for( uint32_t idx = 0; idx < TMR_INSTANCE_COUNT; idx++ )
+    {
+        const TmrDesc_t *descPtr = &tmrDesc[idx];
+        TmrSfr_t *tmrSfr = descPtr->tmrSfr;
+        
+        /* Timer not configured or upper timer of 32-bit pair */
+        if( (descPtr->statePtr->toutParam.timeUnit == 0) ||
+            ((descPtr->lowerIdx >= 0) && tmrState[descPtr->lowerIdx].status.isMode32) )
         {
-            /* Leave timer ON only in continuous gating mode */
-            if( isrFlag.t2.isGateCont == false )
-            {
-                TMR2_MODULE.TMRxCON.CLR = TMR_ON_MASK;  // Timer OFF
-            }
+            continue;
         }
-        /* 16-bit mode */
-        else
+        
+        /* Timebase keeps full period (only conversion factors change) */
+        if( isTimebaseOn && (tmrSfr == &TMR2_MODULE) )
+        {
+            continue;
+        }
+        
+        TimeoutParamSet(descPtr, descPtr->statePtr->toutParam.timeUnit);
+        
+        /* PRx is scaled by PBCLK ratio in timeout mode (max. period in gated mode) */
+        if( !(tmrSfr->TMRxCON.W & TMR_TGATE_MASK) && (clkStateOld.pbFreq != 0) )
         {
-            /* Leave timer ON only in continuous gating mode */
-            if( isrFlag.t3.isGateCont == false )
+            uint64_t prValue = ((uint64_t)tmrSfr->TMRxPR.W * statePtr->pbFreq) / clkStateOld.pbFreq;
+            uint32_t prMax = descPtr->statePtr->status.isMode32 ? 0xFFFFFFFF : 0xFFFF;
+            
+            if( prValue > prMax )
+            {
+                prValue = prMax;
+            }
+            else if( prValue == 0 )
             {
-                TMR3_MODULE.TMRxCON.CLR = TMR_ON_MASK;  // Timer OFF
+                prValue = 1;
             }
+            
+            tmrSfr->TMRxPR.W = (uint32_t)prValue;
         }
-        
-        /* User-defined function */
-        Isr3HandlerPtr();
     }
+    
+    /* Core timer tick restarts at new rate (partial tick is lost) */
+    if( coreTimerPeriod != 0 )
+    {
+        coreTimerPeriod = CORE_TIMER_PERIOD_MS * (statePtr->sysFreq / 1000 / 2);
+        coreTimerBase = _CP0_GET_COUNT();
+        CoreTimerCompareSet(coreTimerBase + WheelNextEvent() * coreTimerPeriod);
+    }
+    
+    /* Time at clock change is kept, later counts are converted at new rate */
+    if( isTimebaseOn )
+    {
+        uint32_t div = ClkDivRead(&TMR2_MODULE);
+        timebaseNsBase = TMR_TimebaseToNs(timebaseSwitchTick);
+        timebaseUsBase = TMR_TimebaseToUs(timebaseSwitchTick);
+        timebaseTickBase = timebaseSwitchTick;
+        timebaseNsScale = ScaleGet((uint64_t)1000000000 * div, statePtr->pbFreq);
+        timebaseUsScale = ScaleGet((uint64_t)1000000 * div, statePtr->pbFreq);
+        timebaseGeneration++;
+    }
+    
+    IC_SetInterruptState(intrStatus);
 }
 
-void __ISR(TIMER_4_VECTOR, TMR4_ISR_IPL) ISR_Tmr4(void)
+
+/*
+ *  Programs core timer compare register. Compare match is only generated on
+ *  equality, hence interrupt is requested if the count has already passed it
+ */
+static void CoreTimerCompareSet(uint32_t compare)
+{
+    _CP0_SET_COMPARE(compare);
+    
+    if( (int32_t)(_CP0_GET_COUNT() - compare) >= 0 )
+    {
+        icSfr->ICxIFS0.SET = IC_CTIF_MASK;
+    }
+}
+
+
+/*
+ *  Links timer to the slot of its expiry (level 0 if expiring within
+ *  TMR_WHEEL_SLOTS ticks, level 1 otherwise). Interrupts must be disabled
+ */
+INLINE static void WheelInsert(TmrWheelTimer_t *const timerPtr)
+{
+    TmrWheelTimer_t **slotPtr;
+    
+    if( (timerPtr->expiry - wheelTick) < TMR_WHEEL_SLOTS )
+    {
+        slotPtr = &wheelLevel0[timerPtr->expiry & WHEEL_MASK];
+    }
+    else
+    {
+        slotPtr = &wheelLevel1[(timerPtr->expiry / TMR_WHEEL_SLOTS) & WHEEL_MASK];
+    }
+    
+    timerPtr->next = *slotPtr;
+    if( timerPtr->next != NULL )
+    {
+        timerPtr->next->prevNextPtr = &timerPtr->next;
+    }
+    timerPtr->prevNextPtr = slotPtr;
+    *slotPtr = timerPtr;
+}
+
+
+/*
+ *  Unlinks timer from its slot. Interrupts must be disabled
+ */
+INLINE static void WheelRemove(TmrWheelTimer_t *const timerPtr)
+{
+    *timerPtr->prevNextPtr = timerPtr->next;
+    if( timerPtr->next != NULL )
+    {
+        timerPtr->next->prevNextPtr = timerPtr->prevNextPtr;
+    }
+    timerPtr->prevNextPtr = NULL;
+}
+
+
+/*
+ *  Advances wheel by one tick: cascades level 1 block and executes timers of
+ *  the expired level 0 slot only
+ */
+static void WheelAdvance(void)
 {
-    if( (icSfr->ICxIEC0.W & IC_T4IE_MASK) && (icSfr->ICxIFS0.W & IC_T4IF_MASK) )
-    {   
-        icSfr->ICxIFS0.CLR = IC_T4IF_MASK;
-                
-        /* Leave timer ON only in continuous gating mode */
-        if( isrFlag.t4.isGateCont == false )
+    uint32_t now = ++wheelTick;
+    
+    /* Move timers of the starting level 1 block to level 0 */
+    if( (now & WHEEL_MASK) == 0 )
+    {
+        TmrWheelTimer_t **slotPtr = &wheelLevel1[(now / TMR_WHEEL_SLOTS) & WHEEL_MASK];
+        TmrWheelTimer_t *timerPtr = *slotPtr;
+        *slotPtr = NULL;
+        
+        while( timerPtr != NULL )
+        {
+            TmrWheelTimer_t *nextPtr = timerPtr->next;
+            WheelInsert(timerPtr);
+            timerPtr = nextPtr;
+        }
+    }
+    
+    /* Only timers of the expired slot are touched (re-armed before the call
+     * so that handler may stop or restart its own timer) */
+    TmrWheelTimer_t **slotPtr = &wheelLevel0[now & WHEEL_MASK];
+    while( *slotPtr != NULL )
+    {
+        TmrWheelTimer_t *timerPtr = *slotPtr;
+        WheelRemove(timerPtr);
+        
+        if( timerPtr->isPeriodic )
         {
-            TMR4_MODULE.TMRxCON.CLR = TMR_ON_MASK;      // Timer OFF
+            timerPtr->expiry += timerPtr->period;
+            WheelInsert(timerPtr);
         }
         
         /* User-defined function */
-        Isr4HandlerPtr();
+        IC_PROFILE_CALL(IC_PROFILE_CORE_TMR, timerPtr->isrHandler());
     }
 }
 
-void __ISR(TIMER_5_VECTOR, TMR5_ISR_IPL) ISR_Tmr5(void)
+
+/*
+ *  Returns number of ticks until the wheel has to be advanced next (level 0
+ *  expiry or non-empty level 1 cascade), bounded by the wheel span
+ */
+static uint32_t WheelNextEvent(void)
 {
-    if( (icSfr->ICxIEC0.W & IC_T5IE_MASK) && (icSfr->ICxIFS0.W & IC_T5IF_MASK) )
-    {  
-        icSfr->ICxIFS0.CLR = IC_T5IF_MASK;
-                
-        /* 32-bit mode */
-        if( TMR4_MODULE.TMRxCON.W & TMR_T32_MASK )
+    uint32_t now = wheelTick;
+    
+    /* Level 0 holds expiries up to TMR_WHEEL_SLOTS - 1 ticks ahead */
+    for( uint32_t delta = 1; delta <= TMR_WHEEL_SLOTS; delta++ )
+    {
+        uint32_t tick = now + delta;
+        
+        if( wheelLevel0[tick & WHEEL_MASK] != NULL )
         {
-            /* Leave timer ON only in continuous gating mode */
-            if( isrFlag.t4.isGateCont == false )
-            {
-                TMR4_MODULE.TMRxCON.CLR = TMR_ON_MASK;  // Timer OFF
-            }
+            return delta;
         }
-        /* 16-bit mode */
-        else
+        
+        if( ((tick & WHEEL_MASK) == 0) && (wheelLevel1[(tick / TMR_WHEEL_SLOTS) & WHEEL_MASK] != NULL) )
         {
-            /* Leave timer ON only in continuous gating mode */
-            if( isrFlag.t5.isGateCont == false )
-            {
-                TMR5_MODULE.TMRxCON.CLR = TMR_ON_MASK;  // Timer OFF
-            }
+            return delta;
+        }
+    }
+    
+    /* Remaining level 1 blocks (first block boundary checked above) */
+    uint32_t block = now / TMR_WHEEL_SLOTS + 1;
+    for( uint32_t idx = 1; idx < TMR_WHEEL_SLOTS; idx++ )
+    {
+        if( wheelLevel1[(block + idx) & WHEEL_MASK] != NULL )
+        {
+            return (block + idx) * TMR_WHEEL_SLOTS - now;
         }
-        
-        /* User-defined function */
-        Isr5HandlerPtr();
     }
+    
+    return TMR_WHEEL_SLOTS * TMR_WHEEL_SLOTS;
+}
+
+
+/******************************************************************************/
+/*-----------------------------ISR  Definitions-------------------------------*/
+/******************************************************************************/
+
+void __ISR(TIMER_1_VECTOR, TMR1_ISR_IPL) ISR_Tmr1(void)
+{
+    IsrDispatch(&tmrDesc[0]);
+}
+
+
+void __ISR(TIMER_2_VECTOR, TMR2_ISR_IPL) ISR_Tmr2(void)
+{
+    IsrDispatch(&tmrDesc[1]);
+}
+
+
+void __ISR(TIMER_3_VECTOR, TMR3_ISR_IPL) ISR_Tmr3(void)
+{
+    IsrDispatch(&tmrDesc[2]);
 }
 
 
-/* Used as periodical 1ms triggered handler */
+void __ISR(TIMER_4_VECTOR, TMR4_ISR_IPL) ISR_Tmr4(void)
+{
+    IsrDispatch(&tmrDesc[3]);
+}
+
+
+void __ISR(TIMER_5_VECTOR, TMR5_ISR_IPL) ISR_Tmr5(void)
+{
+    IsrDispatch(&tmrDesc[4]);
+}
+
+
+/* Used as tickless handler of core timer wheel (compare is only programmed
+ * for the nearest due tick) */
 void __ISR(CORE_TIMER_VECTOR, CT_ISR_IPL) ISR_CoreTmr(void)
 {
-    /* Set next compare count */
     icSfr->ICxIFS0.CLR = IC_CTIF_MASK;
-    uint32_t tick = ((_CP0_GET_COUNT() - _CP0_GET_COMPARE() + coreTimerPeriod / 2) \
-                    / coreTimerPeriod + 1) * coreTimerPeriod;
-    _CP0_SET_COMPARE(_CP0_GET_COUNT() + tick);
-    
-    /* User-defined functions */
-    IsrTimeout1HandlerPtr();
-    IsrTimeout2HandlerPtr();
-    IsrTimeout3HandlerPtr();
-    IsrTimeout4HandlerPtr();
-    IsrTimeout5HandlerPtr();
-    IsrTimeout6HandlerPtr();
-    IsrTimeout7HandlerPtr();
-    IsrTimeout8HandlerPtr();
-    IsrTimeout9HandlerPtr();
+    
+    /* Tick base is accumulated in whole periods, so the 32-bit count wrap
+     * and interrupt latency do not introduce drift */
+    uint32_t elapsed = (_CP0_GET_COUNT() - coreTimerBase) / coreTimerPeriod;
+    while( elapsed > 0 )
+    {
+        coreTimerBase += coreTimerPeriod;
+        WheelAdvance();
+        elapsed--;
+    }
+    
+    /* Set next compare count */
+    CoreTimerCompareSet(coreTimerBase + WheelNextEvent() * coreTimerPeriod);
 }
\ No newline at end of file
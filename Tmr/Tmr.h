@@ -19,9 +19,10 @@
 /*---------------------------------Macros-------------------------------------*/
 /******************************************************************************/
 
-/* Must set if delay is used */
-#ifndef TMR_DELAY_SYSCLK
-#define TMR_DELAY_SYSCLK    40000000
+/* Slots per core timer wheel level (must be power of two). Two levels cover
+ * TMR_WHEEL_SLOTS^2 core timer ticks, longer periods are cascaded again */
+#ifndef TMR_WHEEL_SLOTS
+#define TMR_WHEEL_SLOTS     64
 #endif
 
 
@@ -93,6 +94,11 @@ typedef enum {
     TMR_TIME_UNIT_US = 1000000    
 } TmrTimeUnit_t;
 
+typedef enum {
+    TMR_SAMPLE_SRC_PORT = 0,        // PORTx register snapshot
+    TMR_SAMPLE_SRC_HANDLER = 1      // User-defined (e.g. queued SPI read)
+} TmrSampleSource_t;
+
 /******************************************************************************/
 /*-----------------------------Data Structures--------------------------------*/
 /******************************************************************************/
@@ -113,6 +119,55 @@ typedef struct {
     bool            isGateCont;
 } const TmrGatedConfig_t;
 
+/* Core timer deadline (wrap-safe for up to 2^31 core timer counts) */
+typedef struct {
+    uint32_t        start;      // Core timer count at start
+    uint32_t        length;     // Length in core timer counts
+} TmrDeadline_t;
+
+/* Timer-triggered sampling settings (two blocks of blockSize samples) */
+typedef struct {
+    TmrSampleSource_t   source;
+    PioSfr_t            *pioSfr;        // Used by TMR_SAMPLE_SRC_PORT
+    void              (*sampleHandler)(volatile uint32_t *const samplePtr);   // Used by TMR_SAMPLE_SRC_HANDLER
+    volatile uint32_t   *blockPtr[2];
+    uint32_t            blockSize;
+} const TmrSampleConfig_t;
+
+/* Gated mode pulse captured by TMR_StartPulseCapture() */
+typedef struct {
+    uint32_t        width;      // Gate pulse width in timer counts
+    uint32_t        timestamp;  // Core timer count at end of pulse
+} TmrPulse_t;
+
+/* Running statistics of captured pulse widths (in timer counts) */
+typedef struct {
+    uint32_t        count;
+    uint32_t        overrunCount;
+    uint32_t        minWidth;
+    uint32_t        maxWidth;
+    uint32_t        meanWidth;
+} TmrPulseStats_t;
+
+/* Timeout mode configuration found by TMR_SolveTimeoutPeriod() */
+typedef struct {
+    TmrBitMode_t    bitMode;
+    TmrClkDiv_t     clkDiv;
+    uint32_t        prValue;
+    uint32_t        period;     // Achieved period in requested time unit
+} TmrTimeoutSolution_t;
+
+/* Core timer wheel software timer (owned by user, must stay valid while armed
+ * and be zero-initialized before first use) */
+typedef struct TmrWheelTimer {
+    struct TmrWheelTimer    *next;          // Next timer in the same slot
+    struct TmrWheelTimer    **prevNextPtr;  // Link pointing to this timer (NULL if not armed)
+    uint32_t                expiry;         // Core timer tick of expiry
+    uint32_t                period;         // Period in core timer ticks (1 ms)
+    bool                    isPeriodic;
+    void                    (*isrHandler)(void);
+} TmrWheelTimer_t;
+
 /******************************************************************************/
 /*-----------------------------Function Prototypes----------------------------*/
 /******************************************************************************/
@@ -122,19 +177,47 @@ bool TMR_ConfigTimeoutModeSfr(TmrSfr_t *const tmrSfr, TmrTimeoutConfig_t tmrConf
 bool TMR_ConfigGatedModeSfr(TmrSfr_t *const tmrSfr, TmrGatedConfig_t tmrConfig);
 bool TMR_SetCallback(TmrSfr_t *const tmrSfr, void (*isrHandler)(void));
 bool TMR_SetCoreTimerCallback(void (*isrHandler)(void));
+bool TMR_StartWheelTimer(TmrWheelTimer_t *const timerPtr, uint32_t period, bool isPeriodic, void (*isrHandler)(void));
+bool TMR_StopWheelTimer(TmrWheelTimer_t *const timerPtr);
 bool TMR_SetTimeoutPeriod(TmrSfr_t *const tmrSfr, uint32_t period);
 
+/* Timer-triggered sampling functions */
+bool TMR_StartSampling(TmrSfr_t *const tmrSfr, TmrSampleConfig_t sampleConfig);
+bool TMR_StopSampling(TmrSfr_t *const tmrSfr);
+volatile uint32_t *TMR_GetSampleBlock(TmrSfr_t *const tmrSfr);
+bool TMR_ReleaseSampleBlock(TmrSfr_t *const tmrSfr);
+uint32_t TMR_GetSampleOverrunCount(TmrSfr_t *const tmrSfr);
+
+/* Gated mode pulse width capture functions */
+bool TMR_StartPulseCapture(TmrSfr_t *const tmrSfr, TmrPulse_t *const bufferPtr, uint32_t bufferSize);
+bool TMR_StopPulseCapture(TmrSfr_t *const tmrSfr);
+uint32_t TMR_ReadPulses(TmrSfr_t *const tmrSfr, TmrPulse_t *const destPtr, uint32_t maxCount);
+bool TMR_GetPulseStats(TmrSfr_t *const tmrSfr, TmrPulseStats_t *const statsPtr);
+bool TMR_SolveTimeoutPeriod(TmrSfr_t *const tmrSfr, uint32_t clkFreq, uint32_t period, uint32_t tolerance, TmrTimeUnit_t timeUnit, TmrTimeoutSolution_t *const solutionPtr);
+bool TMR_ConfigTimeoutModeAuto(TmrSfr_t *const tmrSfr, uint32_t period, uint32_t tolerance, TmrTimeUnit_t timeUnit, uint32_t *const periodPtr);
+
+/* Free-running 64-bit timebase functions (TMR2/TMR3 pair) */
+bool TMR_ConfigTimebaseSfr(TmrClkDiv_t clkDiv);
+uint64_t TMR_ReadTimebase(void);
+uint64_t TMR_TimebaseToNs(uint64_t ticks);
+uint64_t TMR_TimebaseToUs(uint64_t ticks);
+
 /* Timer operation functions */
 INLINE void TMR_StartTimer(TmrSfr_t *const tmrSfr);
 INLINE void TMR_StopTimer(TmrSfr_t *const tmrSfr);
 
-/* Time delay functions */
-INLINE void TMR_DelayUs(uint32_t delay);
-INLINE void TMR_DelayMs(uint32_t delay);
+/* Deadline and time delay functions */
+bool TMR_StartDeadline(TmrDeadline_t *const deadlinePtr, uint32_t delay, TmrTimeUnit_t timeUnit);
+INLINE bool TMR_IsDeadlineExpired(TmrDeadline_t *const deadlinePtr);
+uint32_t TMR_GetDeadlineRemaining(TmrDeadline_t *const deadlinePtr, TmrTimeUnit_t timeUnit);
+void TMR_WaitDeadline(TmrDeadline_t *const deadlinePtr);
+void TMR_SetDelayYieldHook(void (*yieldHandler)(void));
+void TMR_DelayUs(uint32_t delay);
+void TMR_DelayMs(uint32_t delay);
 
 /* Timer read count value function */
 INLINE uint32_t TMR_ReadTimer(TmrSfr_t *const tmrSfr);
-INLINE double TMR_ReadTimerPeriod(TmrSfr_t *const tmrSfr);
+uint32_t TMR_ReadTimerPeriod(TmrSfr_t *const tmrSfr);
 
 
 /******************************************************************************/
@@ -163,35 +246,14 @@ INLINE void TMR_StopTimer(TmrSfr_t *const tmrSfr)
 
 
 /*
- *  Generates simple microsecond delay using Core Timer
+ *  Checks if deadline has expired (wrap-safe, no busy-wait)
  */
-INLINE void TMR_DelayUs(uint32_t delay)
+INLINE bool TMR_IsDeadlineExpired(TmrDeadline_t *const deadlinePtr)
 {
-    /* Translate delay value to microseconds (timer updates every other SYSCLK) */
-    delay = delay * (TMR_DELAY_SYSCLK / 1000000 / 2);
-    uint32_t timeout = _CP0_GET_COUNT() + delay;
-    
-    /* Timer compare */
-    while (timeout > _CP0_GET_COUNT());
+    return (_CP0_GET_COUNT() - deadlinePtr->start) >= deadlinePtr->length;
 }
 
 
- 
-/*
- *  Generates simple millisecond delay using Core Timer
- */
-INLINE void TMR_DelayMs(uint32_t delay)
-{
-    /* Translate delay value to milliseconds (timer updates every other SYSCLK) */
-    delay = delay * (TMR_DELAY_SYSCLK / 1000 / 2);
-    uint32_t timeout = _CP0_GET_COUNT() + delay;
-    
-    /* Timer compare */
-    while (timeout > _CP0_GET_COUNT());
-}
-
-
-
 /*
  *  Read TMRx value
  */
@@ -201,32 +263,4 @@ INLINE uint32_t TMR_ReadTimer(TmrSfr_t *const tmrSfr)
 }
 
 
-/*
- *  Calculates time period (in seconds) based on TMRx count value
- */
-INLINE double TMR_ReadTimerPeriod(TmrSfr_t *const tmrSfr)
-{
-    uint32_t clkDiv = (tmrSfr->TMRxCON.W & TMR_TCKPS_MASK) >> TMR_TCKPS_POS;
-    uint32_t div = 0;
-    
-    /* Only DIV_1/8/64/256 available for TMR1 */
-    if( tmrSfr == &TMR1_MODULE )
-    {
-        switch( clkDiv & 0x03 )
-        {
-            case 0: div = 1; break;
-            case 1: div = 8; break;
-            case 2: div = 64; break;
-            case 3: div = 256; break;
-        }
-    }
-    else
-    {
-        div = (clkDiv <= 6) ? (1 << clkDiv) : (256);
-    }
-    
-    return ( (double)( tmrSfr->TMRxTMR.W * div) / (double)OSC_GetPbFreq() );
-}
-
-
 #endif	/* TMR_H */
\ No newline at end of file
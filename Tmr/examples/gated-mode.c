@@ -54,7 +54,7 @@ int main(int argc, char** argv)
 	PIO_ClearPin(GPIO_RPA2);
 
 	/* Read result of measurement */
-	double tmrPeriod = TMR_ReadTimerPeriod(&TMR2_MODULE);
+	uint32_t tmrPeriod = TMR_ReadTimerPeriod(&TMR2_MODULE);	// In microseconds
 
 	return 0;
 }
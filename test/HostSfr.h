@@ -0,0 +1,302 @@
+/*
+ *  Host test support: maps SFR address ranges of PIC32MX to zeroed host memory
+ *  so that drivers can be compiled unchanged (SET, CLR and INV registers are
+ *  plain memory, hardware behaviour is emulated by the test itself)
+ *
+ *  Register models: accesses to a modelled SFR range are trapped (page
+ *  protection and single-step, x86-64 Linux), SET/CLR/INV writes are applied
+ *  to the W register and model hooks emulate hardware on every access
+ *
+ *  Instruction count: host instructions executed between HostCountBegin() and
+ *  HostCountEnd() are counted by single-stepping (deterministic cost measure)
+ */
+#ifndef HOST_SFR_H
+#define HOST_SFR_H
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+/** Peripheral SFRs (0xBF800000) and configuration words (0xBFC00000) **/
+#define HOST_SFR_BASE       0xBF800000UL
+#define HOST_SFR_SIZE       0x00090000UL
+#define HOST_CFG_BASE       0xBFC00000UL
+#define HOST_CFG_SIZE       0x00001000UL
+
+/** Host RAM seen by DMA (physical address equals host address, see -no-pie) **/
+#define HOST_RAM_BASE       0x10000000UL
+#define HOST_RAM_SIZE       0x00100000UL
+
+#define HOST_PAGE_SIZE      0x1000UL
+#define HOST_MODEL_MAX      8
+#define HOST_TRAP_FLAG      0x100
+
+uint32_t hostCoreCount;
+uint32_t hostCoreCompare;
+uint32_t hostIsrState = 1;
+
+/** Register model of SFR range (hooks run with all modelled ranges writable) **/
+typedef struct {
+    unsigned long   base;               // Page aligned
+    unsigned long   size;
+    uint32_t (*read)(unsigned long address);                    // Value to be read (NULL: memory)
+    void (*write)(unsigned long address, uint32_t value);       // Written value, after SET/CLR/INV took effect
+} HostModel_t;
+
+static const HostModel_t *hostModel[HOST_MODEL_MAX];
+static uint32_t hostModelCount;
+
+/** Executed after every trapped access (e.g. to advance simulated time) **/
+static void (*hostAccessHook)(void);
+
+/** Trapped access in progress (between fault and single-step trap) **/
+static struct {
+    const HostModel_t  *modelPtr;
+    unsigned long       address;
+    bool                isWrite;
+    uint32_t            oldValue;       // W register before write
+} hostTrap;
+
+static volatile bool hostIsCounting;
+static volatile uint64_t hostStepCount;
+
+static void HostMap(unsigned long base, unsigned long size)
+{
+    void *ptr = mmap((void *)base, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if( ptr != (void *)base )
+    {
+        fprintf(stderr, "cannot map SFR range at 0x%08lX\n", base);
+        exit(2);
+    }
+}
+
+static void HostTrapFault(int sig, siginfo_t *info, void *context);
+static void HostTrapStep(int sig, siginfo_t *info, void *context);
+
+/*
+ *  Maps SFR ranges and installs trap handlers (called first in main())
+ */
+static void HostSfrInit(void)
+{
+    struct sigaction action = {0};
+
+    HostMap(HOST_SFR_BASE, HOST_SFR_SIZE);
+    HostMap(HOST_CFG_BASE, HOST_CFG_SIZE);
+
+    action.sa_flags = SA_SIGINFO;
+    action.sa_sigaction = HostTrapFault;
+    sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = HostTrapStep;
+    sigaction(SIGTRAP, &action, NULL);
+}
+
+/*
+ *  Returns writable view of SFR word at given physical-segment address
+ */
+static inline volatile uint32_t *HostSfrWord(unsigned long address)
+{
+    return (volatile uint32_t *)address;
+}
+
+/*
+ *  Maps host RAM for DMA buffers (KVA to PA translation keeps its addresses)
+ */
+static void *HostRamInit(void)
+{
+    HostMap(HOST_RAM_BASE, HOST_RAM_SIZE);
+
+    return (void *)HOST_RAM_BASE;
+}
+
+/*
+ *  Makes all modelled ranges accessible (model code) or trapped (driver code)
+ */
+static void HostModelLock(bool isLocked)
+{
+    for( uint32_t idx = 0; idx < hostModelCount; idx++ )
+    {
+        mprotect((void *)hostModel[idx]->base, hostModel[idx]->size, isLocked ? PROT_NONE : (PROT_READ | PROT_WRITE));
+    }
+}
+
+static const HostModel_t *HostModelFind(unsigned long address)
+{
+    for( uint32_t idx = 0; idx < hostModelCount; idx++ )
+    {
+        if( (address - hostModel[idx]->base) < hostModel[idx]->size )
+        {
+            return hostModel[idx];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ *  Access to modelled range: read value is supplied by model, then faulting
+ *  instruction is executed once with range accessible
+ */
+static void HostTrapFault(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *ucPtr = (ucontext_t *)context;
+    unsigned long address = (unsigned long)info->si_addr & ~3UL;
+    const HostModel_t *modelPtr = HostModelFind(address);
+
+    (void)sig;
+
+    /* Not an SFR access, fault again with default action */
+    if( (modelPtr == NULL) || (hostTrap.modelPtr != NULL) )
+    {
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    HostModelLock(false);
+
+    hostTrap.modelPtr = modelPtr;
+    hostTrap.address = address;
+    hostTrap.isWrite = (ucPtr->uc_mcontext.gregs[REG_ERR] & 2) != 0;
+    hostTrap.oldValue = *(volatile uint32_t *)(address & ~0xFUL);
+
+    if( !hostTrap.isWrite && (modelPtr->read != NULL) )
+    {
+        *(volatile uint32_t *)address = modelPtr->read(address);
+    }
+
+    ucPtr->uc_mcontext.gregs[REG_EFL] |= HOST_TRAP_FLAG;
+}
+
+/*
+ *  Single-step trap: completes trapped access and counts instructions
+ */
+static void HostTrapStep(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *ucPtr = (ucontext_t *)context;
+    const HostModel_t *modelPtr = hostTrap.modelPtr;
+
+    (void)sig;
+    (void)info;
+
+    if( modelPtr != NULL )
+    {
+        unsigned long address = hostTrap.address;
+
+        if( hostTrap.isWrite )
+        {
+            volatile uint32_t *regPtr = (volatile uint32_t *)(address & ~0xFUL);
+            uint32_t value = *(volatile uint32_t *)address;
+
+            /* Atomic SET/CLR/INV registers follow W register */
+            switch( address & 0xC )
+            {
+                case 0x4: *regPtr = hostTrap.oldValue & ~value; break;
+                case 0x8: *regPtr = hostTrap.oldValue | value; break;
+                case 0xC: *regPtr = hostTrap.oldValue ^ value; break;
+                default: break;
+            }
+
+            if( modelPtr->write != NULL )
+            {
+                modelPtr->write(address, value);
+            }
+        }
+
+        if( hostAccessHook != NULL )
+        {
+            hostAccessHook();
+        }
+
+        hostTrap.modelPtr = NULL;
+        HostModelLock(true);
+    }
+
+    if( hostIsCounting )
+    {
+        hostStepCount++;
+    }
+    else
+    {
+        ucPtr->uc_mcontext.gregs[REG_EFL] &= ~HOST_TRAP_FLAG;
+    }
+}
+
+/*
+ *  Adds register model of SFR range (range gets trapped)
+ */
+static void HostModelAdd(const HostModel_t *modelPtr)
+{
+    if( hostModelCount == HOST_MODEL_MAX )
+    {
+        fprintf(stderr, "too many register models\n");
+        exit(2);
+    }
+
+    hostModel[hostModelCount++] = modelPtr;
+    HostModelLock(true);
+}
+
+/*
+ *  Executes access hook given number of times without driver activity (idle
+ *  CPU, e.g. main loop waiting for interrupt)
+ */
+static void HostIdle(uint32_t count)
+{
+    HostModelLock(false);
+
+    while( count-- && (hostAccessHook != NULL) )
+    {
+        hostAccessHook();
+    }
+
+    HostModelLock(true);
+}
+
+/*
+ *  Reads or writes modelled register without triggering model (test code)
+ */
+static uint32_t HostPeek(unsigned long address)
+{
+    HostModelLock(false);
+    uint32_t value = *(volatile uint32_t *)address;
+    HostModelLock(true);
+
+    return value;
+}
+
+static void HostPoke(unsigned long address, uint32_t value)
+{
+    HostModelLock(false);
+    *(volatile uint32_t *)address = value;
+    HostModelLock(true);
+}
+
+/*
+ *  Starts and stops counting of executed host instructions
+ */
+static inline __attribute__((always_inline)) void HostCountBegin(void)
+{
+    hostStepCount = 0;
+    hostIsCounting = true;
+    __asm__ volatile("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+}
+
+static inline __attribute__((always_inline)) uint64_t HostCountEnd(void)
+{
+    hostIsCounting = false;
+    __asm__ volatile("pushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+
+    return hostStepCount;
+}
+
+#endif
@@ -0,0 +1,665 @@
+/*
+ *  Host register model of SPI1/SPI2 (enhanced buffer, Standard, Audio and
+ *  Framed mode), DMA channels, interrupt flags and PIO latches used by SPI
+ *  tests
+ *
+ *  Time advances by one tick on every trapped SFR access (and on HostIdle()),
+ *  a Master module shifts one frame in "frameTicks" ticks. Interrupt flags are
+ *  persistent: IFS bit is set again while its condition holds
+ *
+ *  Include after "../Spi/Spi.c" (ISRs are dispatched by HostSpiService())
+ */
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <string.h>
+
+#define HOST_SPI_COUNT      2
+#define HOST_DMA_COUNT      4
+#define HOST_FIFO_MAX       16
+
+/** Register addresses **/
+#define HOST_SPI_ADDR(module)   (0xBF805800UL + (module) * 0x200UL)
+#define HOST_SPI_CON            0x00
+#define HOST_SPI_STAT           0x10
+#define HOST_SPI_BUF            0x20
+#define HOST_SPI_BRG            0x30
+#define HOST_SPI_CON2           0x40
+#define HOST_DMA_CON_ADDR       0xBF883000UL
+#define HOST_DMA_ADDR(ch)       (0xBF883060UL + (ch) * 0xC0UL)
+#define HOST_IFS1_ADDR          ((unsigned long)&IC_MODULE.ICxIFS1.W)
+#define HOST_IEC1_ADDR          ((unsigned long)&IC_MODULE.ICxIEC1.W)
+#define HOST_LATA_ADDR          ((unsigned long)&PIOA_MODULE.PIOxLAT.W)
+#define HOST_LATB_ADDR          ((unsigned long)&PIOB_MODULE.PIOxLAT.W)
+
+#define HOST_REG(address)       (*(volatile uint32_t *)(address))
+#define HOST_SPI_REG(module, offset)    HOST_REG(HOST_SPI_ADDR(module) + (offset))
+
+typedef struct {
+    uint32_t    txFifo[HOST_FIFO_MAX];
+    uint32_t    txHead;
+    uint32_t    txCount;
+    uint32_t    rxFifo[HOST_FIFO_MAX];
+    uint32_t    rxHead;
+    uint32_t    rxCount;
+    bool        isShifting;
+    uint32_t    shiftData;
+    uint32_t    shiftTicks;
+    uint32_t    frameTicks;             // SCK time of one frame (Master mode)
+    uint32_t    status;                 // Sticky SPIROV, SPITUR bits
+    /* Slave device of Master module: receives MOSI frame, returns MISO frame
+     * (loopback if NULL) */
+    uint32_t  (*device)(uint32_t module, uint32_t data);
+    /* Statistics */
+    uint64_t    frameCount;
+    uint64_t    busyTicks;              // Ticks with frame being shifted
+    uint64_t    idleTicks;              // Ticks of enabled Master module without frame
+} HostSpi_t;
+
+static HostSpi_t hostSpi[HOST_SPI_COUNT];
+static uint64_t hostTick;
+
+static void HostSpiIrqUpdate(void);
+
+
+/*
+ *  Frame width in bits and FIFO depth of configured mode
+ */
+static uint32_t HostSpiBits(uint32_t module)
+{
+    uint32_t mode = (HOST_SPI_REG(module, HOST_SPI_CON) & SPI_MODE_MASK) >> SPI_MODE_POS;
+
+    if( HOST_SPI_REG(module, HOST_SPI_CON2) & SPI_AUDEN_MASK )
+    {
+        static const uint32_t audioBits[4] = {16, 16, 32, 24};
+        return audioBits[mode];
+    }
+
+    return (mode == 0) ? 8 : ((mode == 1) ? 16 : 32);
+}
+
+static uint32_t HostSpiDepth(uint32_t module)
+{
+    uint32_t bits = HostSpiBits(module);
+
+    return (bits <= 8) ? 16 : ((bits <= 16) ? 8 : 4);
+}
+
+static uint32_t HostSpiMask(uint32_t module)
+{
+    uint32_t bits = HostSpiBits(module);
+
+    return (bits == 32) ? 0xFFFFFFFF : ((1u << bits) - 1);
+}
+
+static void HostSpiReset(uint32_t module)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+
+    spiPtr->txCount = 0;
+    spiPtr->rxCount = 0;
+    spiPtr->isShifting = false;
+    spiPtr->status = 0;
+}
+
+/*
+ *  Frame received by module (overflow sets SPIROV, frame is lost)
+ */
+static void HostSpiRxPush(uint32_t module, uint32_t data)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+
+    if( spiPtr->rxCount == HostSpiDepth(module) )
+    {
+        spiPtr->status |= SPI_SPIROV_MASK;
+        return;
+    }
+
+    spiPtr->rxFifo[(spiPtr->rxHead + spiPtr->rxCount) % HOST_FIFO_MAX] = data & HostSpiMask(module);
+    spiPtr->rxCount++;
+}
+
+/*
+ *  SPIxBUF accesses (CPU or DMA)
+ */
+static uint32_t HostSpiBufRead(uint32_t module)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+    uint32_t data = 0;
+
+    if( spiPtr->rxCount != 0 )
+    {
+        data = spiPtr->rxFifo[spiPtr->rxHead];
+        spiPtr->rxHead = (spiPtr->rxHead + 1) % HOST_FIFO_MAX;
+        spiPtr->rxCount--;
+    }
+
+    return data;
+}
+
+static void HostSpiBufWrite(uint32_t module, uint32_t data)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+
+    /* Write to full TX FIFO is lost */
+    if( !(HOST_SPI_REG(module, HOST_SPI_CON) & SPI_ON_MASK) || (spiPtr->txCount == HostSpiDepth(module)) )
+    {
+        return;
+    }
+
+    spiPtr->txFifo[(spiPtr->txHead + spiPtr->txCount) % HOST_FIFO_MAX] = data & HostSpiMask(module);
+    spiPtr->txCount++;
+}
+
+/*
+ *  Slave module shifts one frame clocked by its Master (returns MISO frame,
+ *  empty TX FIFO underruns)
+ */
+static uint32_t HostSpiSlaveShift(uint32_t module, uint32_t data)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+    uint32_t misoData = 0;
+
+    if( !(HOST_SPI_REG(module, HOST_SPI_CON) & SPI_ON_MASK) )
+    {
+        return 0;
+    }
+
+    if( spiPtr->txCount != 0 )
+    {
+        misoData = spiPtr->txFifo[spiPtr->txHead];
+        spiPtr->txHead = (spiPtr->txHead + 1) % HOST_FIFO_MAX;
+        spiPtr->txCount--;
+    }
+    else
+    {
+        spiPtr->status |= SPI_SPITUR_MASK;
+    }
+
+    HostSpiRxPush(module, data);
+    spiPtr->frameCount++;
+
+    return misoData;
+}
+
+/*
+ *  SPIxSTAT value
+ */
+static uint32_t HostSpiStatus(uint32_t module)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+    uint32_t depth = HostSpiDepth(module);
+    uint32_t status = spiPtr->status;
+
+    status |= (spiPtr->txCount << SPI_TXBUFELM_POS) | (spiPtr->rxCount << SPI_RXBUFELM_POS);
+    status |= (spiPtr->rxCount == depth) ? SPI_SPIRBF_MASK : 0;
+    status |= (spiPtr->txCount == depth) ? SPI_SPITBF_MASK : 0;
+    status |= (spiPtr->txCount == 0) ? SPI_SPITBE_MASK : 0;
+    status |= (spiPtr->rxCount == 0) ? SPI_SPIRBE_MASK : 0;
+    status |= (!spiPtr->isShifting && (spiPtr->txCount == 0)) ? SPI_SRMT_MASK : 0;
+    status |= (spiPtr->isShifting || (spiPtr->txCount != 0)) ? SPI_SPIBUSY_MASK : 0;
+
+    return status;
+}
+
+/*
+ *  Interrupt conditions of module (TX, RX and error)
+ */
+static bool HostSpiTxCondition(uint32_t module)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+    uint32_t con = HOST_SPI_REG(module, HOST_SPI_CON);
+    uint32_t depth = HostSpiDepth(module);
+
+    if( !(con & SPI_ON_MASK) )
+    {
+        return false;
+    }
+
+    switch( (con & SPI_STXISEL_MASK) >> SPI_STXISEL_POS )
+    {
+        case 0: return !spiPtr->isShifting && (spiPtr->txCount == 0);
+        case 1: return (spiPtr->txCount == 0);
+        case 2: return (spiPtr->txCount <= depth / 2);
+        default: return (spiPtr->txCount < depth);
+    }
+}
+
+static bool HostSpiRxCondition(uint32_t module)
+{
+    HostSpi_t *spiPtr = &hostSpi[module];
+    uint32_t con = HOST_SPI_REG(module, HOST_SPI_CON);
+    uint32_t depth = HostSpiDepth(module);
+
+    if( !(con & SPI_ON_MASK) )
+    {
+        return false;
+    }
+
+    switch( (con & SPI_SRXISEL_MASK) >> SPI_SRXISEL_POS )
+    {
+        case 0: return (spiPtr->rxCount == 0);
+        case 1: return (spiPtr->rxCount != 0);
+        case 2: return (spiPtr->rxCount >= depth / 2);
+        default: return (spiPtr->rxCount == depth);
+    }
+}
+
+static bool HostSpiErrCondition(uint32_t module)
+{
+    uint32_t con2 = HOST_SPI_REG(module, HOST_SPI_CON2);
+    uint32_t status = hostSpi[module].status;
+
+    return ((con2 & SPI_SPIROVEN_MASK) && (status & SPI_SPIROV_MASK)) ||
+           ((con2 & SPI_SPITUREN_MASK) && (status & SPI_SPITUR_MASK));
+}
+
+/*
+ *  Live state of interrupt request (DMA start event)
+ */
+static bool HostIrqCondition(uint32_t irq)
+{
+    switch( irq )
+    {
+        case SPI1_RX_IRQ: return HostSpiRxCondition(0);
+        case SPI1_TX_IRQ: return HostSpiTxCondition(0);
+        case SPI2_RX_IRQ: return HostSpiRxCondition(1);
+        case SPI2_TX_IRQ: return HostSpiTxCondition(1);
+        default: return false;
+    }
+}
+
+/*
+ *  DMA channel: transfers one cell per start event (or CFORCE)
+ */
+static volatile uint32_t *HostDmaReg(uint32_t ch, uint32_t offset)
+{
+    return &HOST_REG(HOST_DMA_ADDR(ch) + offset);
+}
+
+static bool HostDmaIsSpiBuf(uint32_t pa, uint32_t *modulePtr)
+{
+    for( uint32_t module = 0; module < HOST_SPI_COUNT; module++ )
+    {
+        if( pa == DMA_KVA_TO_PA(HOST_SPI_ADDR(module) + HOST_SPI_BUF) )
+        {
+            *modulePtr = module;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void HostDmaCell(uint32_t ch)
+{
+    volatile uint32_t *conPtr = HostDmaReg(ch, 0x00);
+    volatile uint32_t *intPtr = HostDmaReg(ch, 0x20);
+    uint32_t ssa = *HostDmaReg(ch, 0x30);
+    uint32_t dsa = *HostDmaReg(ch, 0x40);
+    uint32_t ssiz = *HostDmaReg(ch, 0x50);
+    uint32_t dsiz = *HostDmaReg(ch, 0x60);
+    volatile uint32_t *sptrPtr = HostDmaReg(ch, 0x70);
+    volatile uint32_t *dptrPtr = HostDmaReg(ch, 0x80);
+    uint32_t csiz = *HostDmaReg(ch, 0x90);
+    volatile uint32_t *cptrPtr = HostDmaReg(ch, 0xA0);
+    uint8_t cell[4] = {0};
+    uint32_t module;
+    uint32_t word;
+
+    csiz = (csiz > 4) ? 4 : csiz;
+
+    /* Source: SPIxBUF (one frame per cell) or host RAM */
+    if( HostDmaIsSpiBuf(ssa, &module) )
+    {
+        word = HostSpiBufRead(module);
+        memcpy(cell, &word, sizeof(cell));
+    }
+    else
+    {
+        memcpy(cell, (uint8_t *)(uintptr_t)ssa + *sptrPtr, csiz);
+    }
+
+    if( HostDmaIsSpiBuf(dsa, &module) )
+    {
+        word = 0;
+        memcpy(&word, cell, csiz);
+        HostSpiBufWrite(module, word);
+    }
+    else
+    {
+        memcpy((uint8_t *)(uintptr_t)dsa + *dptrPtr, cell, csiz);
+    }
+
+    *sptrPtr = (*sptrPtr + csiz >= ssiz) ? 0 : (*sptrPtr + csiz);
+    *dptrPtr = (*dptrPtr + csiz >= dsiz) ? 0 : (*dptrPtr + csiz);
+    *cptrPtr += csiz;
+
+    /* Block done once larger of source and destination is transferred */
+    if( *cptrPtr >= ((ssiz > dsiz) ? ssiz : dsiz) )
+    {
+        *cptrPtr = 0;
+        *sptrPtr = 0;
+        *dptrPtr = 0;
+        *intPtr |= DMA_CHBCIF_MASK;
+
+        if( !(*conPtr & DMA_CHAEN_MASK) )
+        {
+            *conPtr &= ~DMA_CHEN_MASK;
+        }
+    }
+}
+
+static void HostDmaStep(void)
+{
+    if( !(HOST_REG(HOST_DMA_CON_ADDR) & DMA_ON_MASK) )
+    {
+        return;
+    }
+
+    /* Highest channel priority first */
+    for( int32_t pri = 3; pri >= 0; pri-- )
+    {
+        for( uint32_t ch = 0; ch < HOST_DMA_COUNT; ch++ )
+        {
+            uint32_t con = *HostDmaReg(ch, 0x00);
+            volatile uint32_t *econPtr = HostDmaReg(ch, 0x10);
+
+            if( ((con & DMA_CHPRI_MASK) >> DMA_CHPRI_POS) != (uint32_t)pri || !(con & DMA_CHEN_MASK) )
+            {
+                continue;
+            }
+
+            bool isForced = (*econPtr & DMA_CFORCE_MASK) != 0;
+            bool isEvent = (*econPtr & DMA_SIRQEN_MASK) &&
+                           HostIrqCondition((*econPtr & DMA_CHSIRQ_MASK) >> DMA_CHSIRQ_POS);
+
+            if( isForced || isEvent )
+            {
+                *econPtr &= ~DMA_CFORCE_MASK;
+                HostDmaCell(ch);
+            }
+        }
+    }
+}
+
+/*
+ *  Sets persistent interrupt flags of SPI and DMA sources
+ */
+static void HostSpiIrqUpdate(void)
+{
+    static const uint32_t txIf[] = {IC_SPI1TXIF_MASK, IC_SPI2TXIF_MASK};
+    static const uint32_t rxIf[] = {IC_SPI1RXIF_MASK, IC_SPI2RXIF_MASK};
+    static const uint32_t eIf[] = {IC_SPI1EIF_MASK, IC_SPI2EIF_MASK};
+    static const uint32_t dmaIf[] = {IC_DMA0IF_MASK, IC_DMA1IF_MASK, IC_DMA2IF_MASK, IC_DMA3IF_MASK};
+    uint32_t flags = 0;
+
+    for( uint32_t module = 0; module < HOST_SPI_COUNT; module++ )
+    {
+        flags |= HostSpiTxCondition(module) ? txIf[module] : 0;
+        flags |= HostSpiRxCondition(module) ? rxIf[module] : 0;
+        flags |= HostSpiErrCondition(module) ? eIf[module] : 0;
+    }
+
+    for( uint32_t ch = 0; ch < HOST_DMA_COUNT; ch++ )
+    {
+        uint32_t chInt = *HostDmaReg(ch, 0x20);
+
+        flags |= (chInt & (chInt >> 16) & 0xFF) ? dmaIf[ch] : 0;
+    }
+
+    HOST_REG(HOST_IFS1_ADDR) |= flags;
+}
+
+/*
+ *  One tick of simulated time: Master modules shift frames, DMA moves cells
+ */
+static void HostSpiTick(void)
+{
+    hostTick++;
+
+    for( uint32_t module = 0; module < HOST_SPI_COUNT; module++ )
+    {
+        HostSpi_t *spiPtr = &hostSpi[module];
+        uint32_t con = HOST_SPI_REG(module, HOST_SPI_CON);
+        bool isAudio = ((HOST_SPI_REG(module, HOST_SPI_CON2) & SPI_AUDEN_MASK) != 0) || ((con & SPI_FRMEN_MASK) != 0);
+
+        if( !(con & SPI_ON_MASK) || !(con & SPI_MSTEN_MASK) )
+        {
+            continue;
+        }
+
+        if( spiPtr->isShifting )
+        {
+            spiPtr->busyTicks++;
+
+            if( --spiPtr->shiftTicks != 0 )
+            {
+                continue;
+            }
+
+            uint32_t misoData = (spiPtr->device != NULL) ? spiPtr->device(module, spiPtr->shiftData) : spiPtr->shiftData;
+
+            HostSpiRxPush(module, misoData);
+            spiPtr->isShifting = false;
+            spiPtr->frameCount++;
+        }
+
+        /* Next frame starts without gap, Audio and Framed mode clock continuously */
+        if( spiPtr->txCount != 0 )
+        {
+            spiPtr->shiftData = spiPtr->txFifo[spiPtr->txHead];
+            spiPtr->txHead = (spiPtr->txHead + 1) % HOST_FIFO_MAX;
+            spiPtr->txCount--;
+            spiPtr->isShifting = true;
+            spiPtr->shiftTicks = spiPtr->frameTicks;
+        }
+        else if( isAudio )
+        {
+            spiPtr->status |= SPI_SPITUR_MASK;
+            spiPtr->shiftData = 0;
+            spiPtr->isShifting = true;
+            spiPtr->shiftTicks = spiPtr->frameTicks;
+        }
+        else
+        {
+            spiPtr->idleTicks++;
+        }
+    }
+
+    HostDmaStep();
+    HostSpiIrqUpdate();
+}
+
+/*
+ *  Register model hooks
+ */
+static uint32_t HostSpiRead(unsigned long address)
+{
+    uint32_t module = (address - HOST_SPI_ADDR(0)) / 0x200;
+    uint32_t offset = (address - HOST_SPI_ADDR(0)) % 0x200;
+
+    if( module < HOST_SPI_COUNT )
+    {
+        if( offset == HOST_SPI_STAT )
+        {
+            return HostSpiStatus(module);
+        }
+        if( offset == HOST_SPI_BUF )
+        {
+            uint32_t data = HostSpiBufRead(module);
+            HostSpiIrqUpdate();
+            return data;
+        }
+    }
+
+    return HOST_REG(address);
+}
+
+static void HostSpiWrite(unsigned long address, uint32_t value)
+{
+    uint32_t module = (address - HOST_SPI_ADDR(0)) / 0x200;
+    uint32_t offset = (address - HOST_SPI_ADDR(0)) % 0x200;
+
+    if( module >= HOST_SPI_COUNT )
+    {
+        return;
+    }
+
+    /* Module disabled: FIFOs, shift register and status are reset */
+    if( (offset & ~0xF) == HOST_SPI_CON )
+    {
+        if( !(HOST_SPI_REG(module, HOST_SPI_CON) & SPI_ON_MASK) )
+        {
+            HostSpiReset(module);
+        }
+    }
+    else if( (offset & ~0xF) == HOST_SPI_STAT )
+    {
+        /* Only SPIROV and SPITUR are writable (cleared by software) */
+        hostSpi[module].status &= HOST_SPI_REG(module, HOST_SPI_STAT) | ~(SPI_SPIROV_MASK | SPI_SPITUR_MASK);
+    }
+    else if( offset == HOST_SPI_BUF )
+    {
+        HostSpiBufWrite(module, value);
+    }
+    else {}
+
+    HostSpiIrqUpdate();
+}
+
+static void HostIcWrite(unsigned long address, uint32_t value)
+{
+    (void)address;
+    (void)value;
+
+    /* Cleared flags are set again while condition holds */
+    HostSpiIrqUpdate();
+}
+
+static void HostDmaWrite(unsigned long address, uint32_t value)
+{
+    (void)value;
+
+    for( uint32_t ch = 0; ch < HOST_DMA_COUNT; ch++ )
+    {
+        /* Abort: channel disabled, pointers cleared */
+        if( (address & ~0xFUL) == (HOST_DMA_ADDR(ch) + 0x10) && (*HostDmaReg(ch, 0x10) & DMA_CABORT_MASK) )
+        {
+            *HostDmaReg(ch, 0x00) &= ~DMA_CHEN_MASK;
+            *HostDmaReg(ch, 0x10) &= ~(DMA_CABORT_MASK | DMA_CFORCE_MASK);
+            *HostDmaReg(ch, 0x70) = 0;
+            *HostDmaReg(ch, 0x80) = 0;
+            *HostDmaReg(ch, 0xA0) = 0;
+        }
+    }
+
+    HostSpiIrqUpdate();
+}
+
+static const HostModel_t hostSpiModel = {0xBF805000UL, HOST_PAGE_SIZE, HostSpiRead, HostSpiWrite};
+static const HostModel_t hostIcModel = {0xBF881000UL, HOST_PAGE_SIZE, NULL, HostIcWrite};
+static const HostModel_t hostDmaModel = {0xBF883000UL, HOST_PAGE_SIZE, NULL, HostDmaWrite};
+static const HostModel_t hostPioModel = {0xBF886000UL, HOST_PAGE_SIZE, NULL, NULL};
+
+/*
+ *  Installs SPI, IC, DMA and PIO register models (after HostSfrInit())
+ */
+static void HostSpiInit(void)
+{
+    memset(hostSpi, 0, sizeof(hostSpi));
+
+    for( uint32_t module = 0; module < HOST_SPI_COUNT; module++ )
+    {
+        hostSpi[module].frameTicks = 8;
+    }
+
+    hostAccessHook = HostSpiTick;
+    HostModelAdd(&hostSpiModel);
+    HostModelAdd(&hostIcModel);
+    HostModelAdd(&hostDmaModel);
+    HostModelAdd(&hostPioModel);
+}
+
+/*
+ *  Executes ISRs of pending and enabled SPI and DMA interrupt sources (if
+ *  interrupts are enabled), interrupt state is restored on return from ISR as
+ *  by the CP0 Status restore of the ISR epilogue
+ */
+static void HostSpiService(void)
+{
+    uint32_t isrState = hostIsrState;
+
+    if( !isrState )
+    {
+        return;
+    }
+
+    uint32_t pending = HostPeek(HOST_IFS1_ADDR) & HostPeek(HOST_IEC1_ADDR);
+
+    if( pending & (IC_SPI1TXIF_MASK | IC_SPI1RXIF_MASK | IC_SPI1EIF_MASK) )
+    {
+        ISR_Spi1();
+    }
+    if( pending & (IC_SPI2TXIF_MASK | IC_SPI2RXIF_MASK | IC_SPI2EIF_MASK) )
+    {
+        ISR_Spi2();
+    }
+    if( pending & IC_DMA0IF_MASK )
+    {
+        ISR_SpiDmaRx();
+    }
+    if( pending & IC_DMA1IF_MASK )
+    {
+        ISR_SpiDmaTx();
+    }
+
+    hostIsrState = isrState;
+}
+
+/*
+ *  Runs main loop (idle CPU and ISRs) until predicate is true
+ *  Returns false on timeout
+ */
+static bool HostSpiRun(bool (*isDone)(void), uint64_t maxTicks)
+{
+    uint64_t endTick = hostTick + maxTicks;
+
+    while( !isDone() )
+    {
+        if( hostTick >= endTick )
+        {
+            return false;
+        }
+
+        HostIdle(1);
+        HostSpiService();
+    }
+
+    return true;
+}
+
+/*
+ *  Slave Select pin is driven low (active)
+ */
+static bool HostSsIsActive(uint32_t pinCode)
+{
+    unsigned long latAddr = (PIO_PIN_MOD(pinCode) == 0) ? HOST_LATA_ADDR : HOST_LATB_ADDR;
+
+    return !(HOST_REG(latAddr) & (1u << PIO_PIN_POS(pinCode)));
+}
+
+/** External dependencies of SPI driver **/
+static uint32_t hostPbFreq = 40000000;
+
+uint32_t OSC_GetPbFreq(void) { return hostPbFreq; }
+uint32_t OSC_GetSysFreq(void) { return hostPbFreq; }
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    (void)preHook;
+    (void)postHook;
+    return true;
+}
+bool PIO_ConfigPpsSfr(const uint32_t pinCode) { (void)pinCode; return true; }
+
+#endif
@@ -0,0 +1,323 @@
+/*
+ *  Host simulation of the OSC DFS governor: replays a synthetic load trace
+ *  (work released every millisecond, due by the end of that millisecond)
+ *  through OSC_GovIdleBegin()/OSC_GovIdleEnd()/OSC_GovUpdate() with a stubbed
+ *  core timer and reports an energy proxy and deadline misses per policy
+ *
+ *  Energy proxy: SYSCLK (MHz) integrated over busy time plus a quarter of it
+ *  over idle time (CPU halted, peripheral bus still clocked)
+ */
+#include "HostSfr.h"
+#include "../Osc/Osc.c"
+
+#include <string.h>
+
+/** Simulation settings **/
+#define SIM_TICK_US         1000
+#define SIM_TICK_COUNT      10000
+#define SIM_IDLE_WEIGHT     0.25
+
+/** Operating points (FRCPLL, FPLLIDIV = 2), PLLMULT changes only at the top
+ ** point which therefore needs full clock switch **/
+static const OscOpp_t simOpp[] = {
+    {{OSC_COSC_FRCPLL,  5000000,  5000000},   20},
+    {{OSC_COSC_FRCPLL, 10000000, 10000000},   20},
+    {{OSC_COSC_FRCPLL, 20000000, 20000000},   20},
+    {{OSC_COSC_FRCPLL, 40000000, 40000000},   20},
+    {{OSC_COSC_FRCPLL, 48000000, 48000000}, 2000},
+};
+#define SIM_OPP_COUNT   (sizeof(simOpp) / sizeof(simOpp[0]))
+
+typedef struct {
+    const char      *name;
+    bool            isGov;
+    uint32_t        fixedIdx;           // Point used if governor is off
+    OscGovConfig_t  govConfig;
+} SimPolicy_t;
+
+static const SimPolicy_t simPolicy[] = {
+    {"fixed max",       false, SIM_OPP_COUNT - 1, {0}},
+    {"fixed min",       false, 0,                 {0}},
+    {"gov fast",        true,  0, {simOpp, SIM_OPP_COUNT, 10000, 80, 30, 0, 5000}},
+    {"gov hold",        true,  0, {simOpp, SIM_OPP_COUNT, 10000, 80, 30, 3, 5000}},
+    {"gov slow",        true,  0, {simOpp, SIM_OPP_COUNT, 50000, 70, 20, 1, 5000}},
+    {"gov budget 500u", true,  0, {simOpp, SIM_OPP_COUNT, 10000, 80, 30, 0,  500}},
+};
+#define SIM_POLICY_COUNT    (sizeof(simPolicy) / sizeof(simPolicy[0]))
+
+typedef struct {
+    double      energy;
+    uint32_t    missCount;
+    uint32_t    stepCount;
+    uint32_t    visitedMask;        // Points selected during trace
+    uint32_t    excludedMask;
+} SimResult_t;
+
+/** Work released at start of each tick in SYSCLK cycles **/
+static uint32_t simDemand[SIM_TICK_COUNT];
+
+/** Simulated SYSCLK cycles (core timer counts at half of it) **/
+static double simCycles;
+
+
+/*
+ *  Fills load trace: light, burst, medium, near-max burst and light load with
+ *  periodic spikes (deterministic jitter of +-10 %)
+ */
+static void SimTraceInit(void)
+{
+    uint32_t seed = 12345;
+
+    for( uint32_t tick = 0; tick < SIM_TICK_COUNT; tick++ )
+    {
+        uint32_t rate;      // Mcycles/s
+
+        if( tick < 2000 )
+        {
+            rate = 2;
+        }
+        else if( tick < 3000 )
+        {
+            rate = 35;
+        }
+        else if( tick < 6000 )
+        {
+            rate = 12;
+        }
+        else if( tick < 6500 )
+        {
+            rate = 42;
+        }
+        else
+        {
+            rate = ((tick % 100) < 5) ? 30 : 1;
+        }
+
+        seed = seed * 1103515245 + 12345;
+        int32_t jitter = (int32_t)((seed >> 16) % 201) - 100;     // +-100 permille
+
+        simDemand[tick] = (uint32_t)(((int64_t)rate * 1000 * (1000 + jitter)) / 1000);
+    }
+}
+
+
+/*
+ *  Advances simulated time at current SYSCLK
+ */
+static void SimAdvance(double timeUs, uint32_t sysFreq)
+{
+    simCycles += timeUs * sysFreq / 1000000.0;
+    hostCoreCount = (uint32_t)(uint64_t)(simCycles / 2);
+}
+
+
+/*
+ *  Emulates oscillator completing switch to given point (OSCCON of host memory
+ *  is not changed by SET/CLR/INV writes of OSC_ConfigOsc())
+ */
+static void SimSettle(const OscConfig_t oscConfig)
+{
+    uint32_t pllCode = GetPllMultDiv(OSC_FRC_FREQ, GetPllInDiv(), oscConfig.sysFreq);
+
+    oscSfr->OSCxCON.W = ((uint32_t)oscConfig.oscSource << OSC_COSC_POS) |
+                        (((pllCode >> 8) & 0x07) << OSC_PLLMULT_POS) |
+                        (((pllCode >> 0) & 0x07) << OSC_PLLODIV_POS) |
+                        OSC_PBDIVRDY_MASK | OSC_SOSCRDY_MASK;
+
+    ClkStateUpdate();
+}
+
+
+/*
+ *  Replays load trace with given policy
+ */
+static void SimRun(const SimPolicy_t *const policyPtr, SimResult_t *const resultPtr)
+{
+    memset(resultPtr, 0, sizeof(*resultPtr));
+    simCycles = 0;
+    hostCoreCount = 0;
+
+    uint32_t oppIdx = policyPtr->fixedIdx;
+
+    SimSettle(simOpp[oppIdx].oscConfig);
+
+    if( policyPtr->isGov )
+    {
+        if( !OSC_StartGovernor(&policyPtr->govConfig, oppIdx) )
+        {
+            fprintf(stderr, "%s: governor not started\n", policyPtr->name);
+            exit(1);
+        }
+
+        SimSettle(simOpp[oppIdx].oscConfig);
+        GovWindowStart(&policyPtr->govConfig);
+    }
+
+    double backlog = 0;
+    double stallUs = 0;
+
+    for( uint32_t tick = 0; tick < SIM_TICK_COUNT; tick++ )
+    {
+        uint32_t sysFreq = OSC_GetSysFreq();
+        double freqMhz = sysFreq / 1000000.0;
+        double availUs = SIM_TICK_US - stallUs;
+
+        backlog += simDemand[tick];
+
+        double busyUs = backlog / freqMhz;
+
+        if( busyUs > availUs )
+        {
+            busyUs = (availUs > 0) ? availUs : 0;
+        }
+
+        backlog -= busyUs * freqMhz;
+        SimAdvance(busyUs, sysFreq);
+        resultPtr->energy += busyUs * freqMhz;
+
+        /* Work of this tick not done by end of tick */
+        if( backlog > 0.5 )
+        {
+            resultPtr->missCount++;
+        }
+        else
+        {
+            backlog = 0;
+        }
+
+        double idleUs = availUs - busyUs;
+
+        if( idleUs > 0 )
+        {
+            OSC_GovIdleBegin();
+            SimAdvance(idleUs, sysFreq);
+            OSC_GovIdleEnd();
+            resultPtr->energy += idleUs * freqMhz * SIM_IDLE_WEIGHT;
+        }
+
+        stallUs = (availUs < 0) ? -availUs : 0;
+
+        if( policyPtr->isGov && OSC_GovUpdate() )
+        {
+            OscGovStatus_t status;
+            OSC_GetGovStatus(&status);
+
+            /* CPU stalls for expected switch time, then runs at new point */
+            double switchUs = simOpp[status.oppIdx].switchTimeUs;
+            SimAdvance(switchUs, sysFreq);
+            resultPtr->energy += switchUs * freqMhz;
+            stallUs += switchUs;
+
+            SimSettle(simOpp[status.oppIdx].oscConfig);
+            GovWindowStart(&policyPtr->govConfig);
+        }
+
+        if( policyPtr->isGov )
+        {
+            OscGovStatus_t status;
+            OSC_GetGovStatus(&status);
+
+            resultPtr->visitedMask |= (1u << status.oppIdx);
+        }
+        else
+        {
+            resultPtr->visitedMask |= (1u << oppIdx);
+        }
+    }
+
+    if( policyPtr->isGov )
+    {
+        OscGovStatus_t status;
+        OSC_GetGovStatus(&status);
+
+        resultPtr->stepCount = status.stepCount;
+        resultPtr->excludedMask = status.excludedMask;
+
+        OSC_StopGovernor();
+    }
+
+    /* Energy proxy in MHz * s */
+    resultPtr->energy /= 1000000.0;
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+
+    /* FPLLIDIV = 2, clock switching enabled */
+    *(uint32_t *)&cfgSfr->DEVxCFG2.W = CFG_FPLLIDIV_2 << CFG_FPLLIDIV_POS;
+
+    SimTraceInit();
+
+    SimResult_t result[SIM_POLICY_COUNT];
+    int failCount = 0;
+
+    printf("%-16s %12s %8s %6s %8s\n", "policy", "energy", "misses", "steps", "visited");
+
+    for( uint32_t idx = 0; idx < SIM_POLICY_COUNT; idx++ )
+    {
+        SimRun(&simPolicy[idx], &result[idx]);
+
+        printf("%-16s %12.2f %8u %6u %#8x\n", simPolicy[idx].name, result[idx].energy,
+               result[idx].missCount, result[idx].stepCount, result[idx].visitedMask);
+    }
+
+    /* Fixed max. point meets every deadline of the trace */
+    if( result[0].missCount != 0 )
+    {
+        fprintf(stderr, "FAIL: fixed max. point misses deadlines\n");
+        failCount++;
+    }
+
+    for( uint32_t idx = 0; idx < SIM_POLICY_COUNT; idx++ )
+    {
+        const SimPolicy_t *policyPtr = &simPolicy[idx];
+
+        if( !policyPtr->isGov )
+        {
+            continue;
+        }
+
+        /* Governor saves energy against fixed max. point */
+        if( result[idx].energy >= result[0].energy )
+        {
+            fprintf(stderr, "FAIL: %s uses no less energy than fixed max.\n", policyPtr->name);
+            failCount++;
+        }
+
+        /* Governor misses fewer deadlines than fixed min. point */
+        if( result[idx].missCount >= result[1].missCount )
+        {
+            fprintf(stderr, "FAIL: %s misses no fewer deadlines than fixed min.\n", policyPtr->name);
+            failCount++;
+        }
+
+        /* Exclusion is decided by expected switch time of table only */
+        uint32_t excludedMask = 0;
+
+        for( uint32_t oppIdx = 0; oppIdx < SIM_OPP_COUNT; oppIdx++ )
+        {
+            if( simOpp[oppIdx].switchTimeUs > policyPtr->govConfig.latencyBudgetUs )
+            {
+                excludedMask |= (1u << oppIdx);
+            }
+        }
+
+        if( result[idx].excludedMask != excludedMask )
+        {
+            fprintf(stderr, "FAIL: %s excluded mask 0x%X, expected 0x%X\n", policyPtr->name,
+                    result[idx].excludedMask, excludedMask);
+            failCount++;
+        }
+
+        if( result[idx].visitedMask & excludedMask )
+        {
+            fprintf(stderr, "FAIL: %s selected excluded point (mask 0x%X)\n", policyPtr->name,
+                    result[idx].visitedMask & excludedMask);
+            failCount++;
+        }
+    }
+
+    return (failCount == 0) ? 0 : 1;
+}
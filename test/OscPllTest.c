@@ -0,0 +1,244 @@
+/*
+ *  Host test of OSC divider solvers: GetPllMultDiv() and GetNearestDiv() are
+ *  compared with exhaustive search over all settings (exact integer error
+ *  comparison, lower output frequency on a tie)
+ */
+#include "HostSfr.h"
+#include "../Osc/Osc.c"
+
+/** PLL input frequencies (FRC and common crystals) and FPLLIDIV factors **/
+static const uint32_t testInFreq[] = {8000000, 4000000, 3579545, 7372800, 10000000, 12000000, 20000000};
+static const uint32_t testInDiv[] = {1, 2, 3, 4, 5, 6, 10, 12};
+
+#define TEST_COUNT(array)   (sizeof(array) / sizeof(array[0]))
+
+/** Output frequencies swept with prime stride in addition to critical points **/
+#define TEST_SWEEP_MAX      100000000
+#define TEST_SWEEP_STEP     7919
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+/*
+ *  Returns true if output num1/den1 is closer to target than num2/den2 (lower
+ *  output on a tie), all values exact
+ */
+static bool IsCloser(uint64_t num1, uint64_t den1, uint64_t num2, uint64_t den2, uint64_t target)
+{
+    /* |num/den - target| = |num - target * den| / den */
+    __int128 err1 = (__int128)num1 - (__int128)target * den1;
+    __int128 err2 = (__int128)num2 - (__int128)target * den2;
+    err1 = (err1 < 0) ? -err1 : err1;
+    err2 = (err2 < 0) ? -err2 : err2;
+
+    __int128 lhs = err1 * den2;
+    __int128 rhs = err2 * den1;
+
+    if( lhs != rhs )
+    {
+        return lhs < rhs;
+    }
+
+    /* Tie: lower output frequency */
+    return ((__int128)num1 * den2) < ((__int128)num2 * den1);
+}
+
+
+/*
+ *  Returns PLLMULT/PLLODIV codes of closest PLL output by exhaustive search
+ */
+static uint32_t BrutePllMultDiv(uint32_t inFreq, uint32_t inDiv, uint32_t outFreq)
+{
+    static const uint32_t multFactor[8] = {15, 16, 17, 18, 19, 20, 21, 24};
+    static const uint32_t divFactor[8] = {1, 2, 4, 8, 16, 32, 64, 256};
+
+    uint32_t bestMult = 0;
+    uint32_t bestDiv = 0;
+
+    for( uint32_t multCode = 0; multCode < 8; multCode++ )
+    {
+        for( uint32_t divCode = 0; divCode < 8; divCode++ )
+        {
+            uint64_t num = (uint64_t)inFreq * multFactor[multCode];
+            uint64_t den = (uint64_t)inDiv * divFactor[divCode];
+
+            if( ((multCode | divCode) == 0) ||
+                IsCloser(num, den, (uint64_t)inFreq * multFactor[bestMult],
+                         (uint64_t)inDiv * divFactor[bestDiv], outFreq) )
+            {
+                bestMult = multCode;
+                bestDiv = divCode;
+            }
+        }
+    }
+
+    return (bestMult << 8) | bestDiv;
+}
+
+
+/*
+ *  Returns index of closest division factor by exhaustive search
+ */
+static uint32_t BruteNearestDiv(uint32_t inFreq, uint32_t outFreq, const uint16_t *divPtr, uint32_t divCount)
+{
+    uint32_t bestIdx = 0;
+
+    for( uint32_t idx = 1; idx < divCount; idx++ )
+    {
+        if( IsCloser(inFreq, divPtr[idx], inFreq, divPtr[bestIdx], outFreq) )
+        {
+            bestIdx = idx;
+        }
+    }
+
+    return bestIdx;
+}
+
+
+static void CheckPll(uint32_t inFreq, uint32_t inDiv, uint32_t outFreq)
+{
+    uint32_t code = GetPllMultDiv(inFreq, inDiv, outFreq);
+    uint32_t expected = BrutePllMultDiv(inFreq, inDiv, outFreq);
+
+    checkCount++;
+
+    if( code != expected )
+    {
+        if( failCount < 10 )
+        {
+            fprintf(stderr, "FAIL: PLL in %u/%u out %u: 0x%03X, expected 0x%03X\n",
+                    inFreq, inDiv, outFreq, code, expected);
+        }
+
+        failCount++;
+    }
+}
+
+
+static void CheckDiv(uint32_t inFreq, uint32_t outFreq, const uint16_t *divPtr, uint32_t divCount)
+{
+    uint32_t idx = GetNearestDiv(inFreq, outFreq, divPtr, divCount);
+    uint32_t expected = BruteNearestDiv(inFreq, outFreq, divPtr, divCount);
+
+    checkCount++;
+
+    if( idx != expected )
+    {
+        if( failCount < 10 )
+        {
+            fprintf(stderr, "FAIL: DIV in %u out %u (%u factors): %u, expected %u\n",
+                    inFreq, outFreq, divCount, idx, expected);
+        }
+
+        failCount++;
+    }
+}
+
+
+/*
+ *  Checks target frequencies around given output and its neighbours
+ */
+static void CheckAround(void (*checkFunc)(uint32_t, uint32_t, uint32_t), uint32_t arg0, uint32_t arg1, uint64_t num, uint64_t den)
+{
+    uint64_t out = num / den;
+
+    for( uint64_t freq = (out > 1) ? (out - 1) : 0; freq <= out + 1; freq++ )
+    {
+        checkFunc(arg0, arg1, (uint32_t)freq);
+    }
+}
+
+
+/*
+ *  Adapters of FRCDIV and PBDIV tables to CheckAround()
+ */
+static void CheckFrcDiv(uint32_t inFreq, uint32_t unused, uint32_t outFreq)
+{
+    (void)unused;
+    CheckDiv(inFreq, outFreq, frcDivFactor, 8);
+}
+
+
+static void CheckPbDiv(uint32_t inFreq, uint32_t unused, uint32_t outFreq)
+{
+    (void)unused;
+    CheckDiv(inFreq, outFreq, pbDivFactor, 4);
+}
+
+
+int main(void)
+{
+    /* PLL: every achievable output, midpoints of neighbours and sweep */
+    for( uint32_t inIdx = 0; inIdx < TEST_COUNT(testInFreq); inIdx++ )
+    {
+        uint32_t inFreq = testInFreq[inIdx];
+
+        for( uint32_t divIdx = 0; divIdx < TEST_COUNT(testInDiv); divIdx++ )
+        {
+            uint32_t inDiv = testInDiv[divIdx];
+
+            for( uint32_t idx = 0; idx < 64; idx++ )
+            {
+                uint64_t num = (uint64_t)inFreq * pllRatio[idx].mult;
+                uint64_t den = (uint64_t)inDiv * pllRatio[idx].div;
+
+                CheckAround(CheckPll, inFreq, inDiv, num, den);
+
+                if( idx < 63 )
+                {
+                    /* Midpoint of two neighbouring outputs (tie case) */
+                    uint64_t nextNum = (uint64_t)inFreq * pllRatio[idx + 1].mult;
+                    uint64_t nextDen = (uint64_t)inDiv * pllRatio[idx + 1].div;
+
+                    CheckAround(CheckPll, inFreq, inDiv, num * nextDen + nextNum * den, 2 * den * nextDen);
+                }
+            }
+
+            for( uint32_t outFreq = 0; outFreq <= TEST_SWEEP_MAX; outFreq += TEST_SWEEP_STEP )
+            {
+                CheckPll(inFreq, inDiv, outFreq);
+            }
+        }
+    }
+
+    /* FRCDIV and PBDIV: every output, midpoints of neighbours and sweep */
+    static const uint32_t pbInFreq[] = {OSC_FRC_FREQ, 40000000, 48000000, 50000000, 31250, 32768};
+
+    for( uint32_t inIdx = 0; inIdx < TEST_COUNT(pbInFreq); inIdx++ )
+    {
+        uint32_t inFreq = pbInFreq[inIdx];
+
+        for( uint32_t idx = 0; idx < 8; idx++ )
+        {
+            CheckAround(CheckFrcDiv, inFreq, 0, inFreq, frcDivFactor[idx]);
+
+            if( idx < 7 )
+            {
+                CheckAround(CheckFrcDiv, inFreq, 0, (uint64_t)inFreq * (frcDivFactor[idx] + frcDivFactor[idx + 1]),
+                            2 * (uint64_t)frcDivFactor[idx] * frcDivFactor[idx + 1]);
+            }
+        }
+
+        for( uint32_t idx = 0; idx < 4; idx++ )
+        {
+            CheckAround(CheckPbDiv, inFreq, 0, inFreq, pbDivFactor[idx]);
+
+            if( idx < 3 )
+            {
+                CheckAround(CheckPbDiv, inFreq, 0, (uint64_t)inFreq * (pbDivFactor[idx] + pbDivFactor[idx + 1]),
+                            2 * (uint64_t)pbDivFactor[idx] * pbDivFactor[idx + 1]);
+            }
+        }
+
+        for( uint32_t outFreq = 0; outFreq <= inFreq + TEST_SWEEP_STEP; outFreq += (inFreq / 10000) + 1 )
+        {
+            CheckDiv(inFreq, outFreq, frcDivFactor, 8);
+            CheckDiv(inFreq, outFreq, pbDivFactor, 4);
+        }
+    }
+
+    printf("%u checks, %u failed\n", checkCount, failCount);
+
+    return (failCount == 0) ? 0 : 1;
+}
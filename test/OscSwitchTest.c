@@ -0,0 +1,375 @@
+/*
+ *  Host test of OSC_ConfigOsc() switch sequences on the OSC register model:
+ *  clock switch, PBDIV and SOSC become ready after programmable delays, a
+ *  retune within the current source must be a single OSCCON write without
+ *  clock switch or intermediate SYSCLK, PLLMULT or source changes go through
+ *  FRC, PBDIV is written only when ready and changed, measured switch time
+ *  follows the modelled delays
+ */
+#include "HostSfr.h"
+#include "../Osc/Osc.c"
+
+/** OSCCON and DEVCFG2 addresses **/
+#define HOST_OSC_BASE       0xBF80F000UL
+#define HOST_OSCCON_ADDR    0xBF80F000UL
+#define HOST_SYSKEY_ADDR    0xBF80F230UL
+#define HOST_DEVCFG2_ADDR   0xBFC00BF4UL
+
+/** Ready delays in microseconds (every trapped access takes 1 us) **/
+#define TEST_SWITCH_US      200         // OSWEN set to switch complete
+#define TEST_PBDIV_US       50          // PBDIV write to PBDIVRDY
+#define TEST_SOSC_US        1000        // SOSCEN set to SOSCRDY
+#define TEST_PLL_IN_DIV     2           // FPLLIDIV (PLL input 4 MHz)
+#define TEST_TOLERANCE_US   4           // Accesses around phase reads (plus two
+                                        // core timer counts at slower SYSCLK)
+
+/** Bits written by hardware only **/
+#define TEST_READONLY_MASK  (OSC_COSC_MASK | OSC_PBDIVRDY_MASK | OSC_SOSCRDY_MASK)
+
+/** OSC register model state and observations of one OSC_ConfigOsc() call **/
+static struct {
+    uint32_t    oscCon;                 // OSCCON after last access
+    uint32_t    switchLeft;             // Remaining delays (0: ready)
+    uint32_t    pbDivLeft;
+    uint32_t    soscLeft;
+    uint64_t    coreFrac;               // Core timer counts * 1000000 not yet added
+
+    uint64_t    timeUs;
+    uint64_t    unlockUs;               // System unlock and lock (switch window)
+    uint64_t    lockUs;
+    uint32_t    writeCount;             // OSCCON writes
+    uint32_t    invCount;
+    uint32_t    switchCount;            // Clock switches requested
+    uint32_t    frcSwitchCount;         // ... to FRC
+    uint32_t    pbDivWriteCount;
+    uint32_t    pbDivEarlyCount;        // PBDIV written while PBDIVRDY clear
+    uint32_t    pllMultLiveCount;       // PLLMULT written while running from PLL
+    uint32_t    freqChangeCount;        // SYSCLK changes
+    uint32_t    freqMax;
+} testOsc;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what, const char *step)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s (%s)\n", what, step);
+        failCount++;
+    }
+}
+
+
+/*
+ *  SYSCLK of given OSCCON setting (COSC and dividers)
+ */
+static uint32_t TestSysFreq(uint32_t oscCon)
+{
+    static const uint32_t multFactor[8] = {15, 16, 17, 18, 19, 20, 21, 24};
+    static const uint32_t divFactor[8] = {1, 2, 4, 8, 16, 32, 64, 256};
+
+    uint32_t mult = multFactor[(oscCon & OSC_PLLMULT_MASK) >> OSC_PLLMULT_POS];
+    uint32_t pllDiv = divFactor[(oscCon & OSC_PLLODIV_MASK) >> OSC_PLLODIV_POS];
+    uint32_t frcDiv = divFactor[(oscCon & OSC_FRCDIV_MASK) >> OSC_FRCDIV_POS];
+
+    switch( (oscCon & OSC_COSC_MASK) >> OSC_COSC_POS )
+    {
+        case OSC_COSC_FRCPLL: return OSC_FRC_FREQ / TEST_PLL_IN_DIV * mult / pllDiv;
+        case OSC_COSC_POSC: return OSC_XTAL_FREQ;
+        case OSC_COSC_POSCPLL: return OSC_XTAL_FREQ / TEST_PLL_IN_DIV * mult / pllDiv;
+        case OSC_COSC_SOSC: return OSC_SOSC_FREQ;
+        case OSC_COSC_LPRC: return OSC_LPRC_FREQ;
+        case OSC_COSC_FRCDIV16: return OSC_FRC_FREQ / 16;
+        case OSC_COSC_FRCDIV: return OSC_FRC_FREQ / frcDiv;
+        default: return OSC_FRC_FREQ;
+    }
+}
+
+
+/*
+ *  Keeps track of SYSCLK changes after model or driver changed OSCCON
+ */
+static void TestOscSet(uint32_t oscCon)
+{
+    uint32_t oldFreq = TestSysFreq(testOsc.oscCon);
+    uint32_t freq = TestSysFreq(oscCon);
+
+    if( freq != oldFreq )
+    {
+        testOsc.freqChangeCount++;
+    }
+    testOsc.freqMax = (freq > testOsc.freqMax) ? freq : testOsc.freqMax;
+
+    testOsc.oscCon = oscCon;
+    *HostSfrWord(HOST_OSCCON_ADDR) = oscCon;
+}
+
+
+/*
+ *  OSCCON write: OSWEN starts clock switch to NOSC, PBDIV and SOSCEN writes
+ *  clear their ready flags, read-only bits keep hardware state
+ */
+static void TestOscWriteCon(unsigned long address)
+{
+    uint32_t oldCon = testOsc.oscCon;
+    uint32_t oscCon = (*HostSfrWord(HOST_OSCCON_ADDR) & ~TEST_READONLY_MASK) | (oldCon & TEST_READONLY_MASK);
+    uint32_t oldSource = (oldCon & OSC_COSC_MASK) >> OSC_COSC_POS;
+
+    testOsc.writeCount++;
+    if( (address & 0xC) == 0xC )
+    {
+        testOsc.invCount++;
+    }
+
+    if( (oscCon & OSC_OSWEN_MASK) && !(oldCon & OSC_OSWEN_MASK) )
+    {
+        testOsc.switchCount++;
+        testOsc.switchLeft = TEST_SWITCH_US;
+
+        if( (oscCon & OSC_NOSC_MASK) == (OSC_COSC_FRC << OSC_NOSC_POS) )
+        {
+            testOsc.frcSwitchCount++;
+        }
+    }
+
+    if( ((oscCon ^ oldCon) & OSC_PLLMULT_MASK) && ((oldSource == OSC_COSC_FRCPLL) || (oldSource == OSC_COSC_POSCPLL)) )
+    {
+        testOsc.pllMultLiveCount++;
+    }
+
+    if( (oscCon ^ oldCon) & OSC_PBDIV_MASK )
+    {
+        testOsc.pbDivWriteCount++;
+        if( !(oldCon & OSC_PBDIVRDY_MASK) )
+        {
+            testOsc.pbDivEarlyCount++;
+        }
+
+        oscCon &= ~OSC_PBDIVRDY_MASK;
+        testOsc.pbDivLeft = TEST_PBDIV_US;
+    }
+
+    if( (oscCon ^ oldCon) & OSC_SOSCEN_MASK )
+    {
+        oscCon &= ~OSC_SOSCRDY_MASK;
+        testOsc.soscLeft = (oscCon & OSC_SOSCEN_MASK) ? TEST_SOSC_US : 0;
+    }
+
+    TestOscSet(oscCon);
+}
+
+
+/*
+ *  Every access takes 1 us at current SYSCLK (core timer counts at half of
+ *  it), pending operations complete after their delay
+ */
+static void TestOscTick(void)
+{
+    uint32_t oscCon = testOsc.oscCon;
+
+    testOsc.timeUs++;
+    testOsc.coreFrac += TestSysFreq(oscCon) / 2;
+    hostCoreCount += (uint32_t)(testOsc.coreFrac / 1000000);
+    testOsc.coreFrac %= 1000000;
+
+    if( (testOsc.switchLeft != 0) && (--testOsc.switchLeft == 0) )
+    {
+        oscCon &= ~(OSC_COSC_MASK | OSC_OSWEN_MASK);
+        oscCon |= ((oscCon & OSC_NOSC_MASK) >> OSC_NOSC_POS) << OSC_COSC_POS;
+    }
+
+    if( (testOsc.pbDivLeft != 0) && (--testOsc.pbDivLeft == 0) )
+    {
+        oscCon |= OSC_PBDIVRDY_MASK;
+    }
+
+    if( (testOsc.soscLeft != 0) && (--testOsc.soscLeft == 0) )
+    {
+        oscCon |= OSC_SOSCRDY_MASK;
+    }
+
+    TestOscSet(oscCon);
+}
+
+
+/*
+ *  Read returns state at end of its access (polling loop exits on the access
+ *  that completes an operation)
+ */
+static uint32_t TestOscRead(unsigned long address)
+{
+    TestOscTick();
+
+    return *HostSfrWord(address);
+}
+
+
+/*
+ *  Write takes 1 us after its effect (SYSKEY writes mark the switch window)
+ */
+static void TestOscWrite(unsigned long address, uint32_t value)
+{
+    if( address == HOST_SYSKEY_ADDR )
+    {
+        if( value == 0x556699AA )
+        {
+            testOsc.unlockUs = testOsc.timeUs + 1;
+        }
+        else if( value == 0x33333333 )
+        {
+            testOsc.lockUs = testOsc.timeUs;
+        }
+    }
+
+    if( (address & ~0xFUL) == HOST_OSCCON_ADDR )
+    {
+        TestOscWriteCon(address);
+    }
+
+    TestOscTick();
+}
+
+static const HostModel_t testOscModel = {HOST_OSC_BASE, HOST_PAGE_SIZE, TestOscRead, TestOscWrite};
+
+
+/*
+ *  Result of one OSC_ConfigOsc() call
+ */
+typedef struct {
+    uint32_t    timeUs;                 // Modelled duration of switch window
+    uint32_t    reportedUs;             // OSC_GetSwitchTimeUs()
+    uint32_t    startPbDivLeft;
+} TestStep_t;
+
+
+/*
+ *  Configures oscillator and checks common results: SYSCLK of model and of
+ *  driver cache, no PBDIV write before ready, PLLMULT not changed while PLL
+ *  is running, measured switch time
+ */
+static TestStep_t TestConfig(const char *step, OscClkSource_t oscSource, uint32_t sysFreq, uint32_t pbFreq)
+{
+    TestStep_t result = {0};
+    OscConfig_t oscConfig = {oscSource, sysFreq, pbFreq};
+
+    result.startPbDivLeft = testOsc.pbDivLeft;
+
+    uint32_t oldFreq = TestSysFreq(testOsc.oscCon);
+    uint32_t toleranceUs = TEST_TOLERANCE_US + 4000000 / ((oldFreq < sysFreq) ? oldFreq : sysFreq);
+
+    testOsc.writeCount = 0;
+    testOsc.invCount = 0;
+    testOsc.switchCount = 0;
+    testOsc.frcSwitchCount = 0;
+    testOsc.pbDivWriteCount = 0;
+    testOsc.pbDivEarlyCount = 0;
+    testOsc.pllMultLiveCount = 0;
+    testOsc.freqChangeCount = 0;
+    testOsc.freqMax = TestSysFreq(testOsc.oscCon);
+
+    TestCheck(OSC_ConfigOsc(oscConfig), "configuration", step);
+
+    result.timeUs = (uint32_t)(testOsc.lockUs - testOsc.unlockUs);
+    result.reportedUs = OSC_GetSwitchTimeUs();
+
+    uint32_t oscCon = testOsc.oscCon;
+    uint32_t pbDiv = (oscCon & OSC_PBDIV_MASK) >> OSC_PBDIV_POS;
+
+    TestCheck(((oscCon & OSC_COSC_MASK) >> OSC_COSC_POS) == (uint32_t)oscSource, "current source", step);
+    TestCheck(!(oscCon & OSC_OSWEN_MASK), "no clock switch pending", step);
+    TestCheck(TestSysFreq(oscCon) == sysFreq, "SYSCLK of model", step);
+    TestCheck(OSC_GetSysFreq() == sysFreq, "SYSCLK of clock tree cache", step);
+    TestCheck(OSC_GetPbFreq() == (sysFreq >> pbDiv), "PBCLK of clock tree cache", step);
+    TestCheck((sysFreq >> pbDiv) == pbFreq, "PBDIV", step);
+    TestCheck(testOsc.pbDivEarlyCount == 0, "PBDIV written when ready only", step);
+    TestCheck(testOsc.pllMultLiveCount == 0, "PLLMULT not changed while PLL is running", step);
+    TestCheck((result.reportedUs + toleranceUs >= result.timeUs) && (result.reportedUs <= result.timeUs + toleranceUs),
+              "measured switch time", step);
+
+    return result;
+}
+
+
+/*
+ *  Checks retune within current source: single INV write of divider, no
+ *  clock switch, SYSCLK changes once and never exceeds old or new setting
+ */
+static void TestFastRetune(const char *step, uint32_t oldFreq, uint32_t sysFreq, bool isPbDiv)
+{
+    TestCheck(testOsc.switchCount == 0, "no clock switch", step);
+    TestCheck(testOsc.invCount == 1u + isPbDiv, "single INV write of divider", step);
+    TestCheck(testOsc.writeCount == 2u + isPbDiv, "divider, PBDIV and SOSCEN writes only", step);
+    TestCheck(testOsc.freqChangeCount == (oldFreq != sysFreq), "no intermediate SYSCLK", step);
+    TestCheck(testOsc.freqMax == ((oldFreq > sysFreq) ? oldFreq : sysFreq), "SYSCLK not above old or new setting", step);
+    TestCheck(testOsc.pbDivWriteCount == isPbDiv, "PBDIV written if changed only", step);
+}
+
+
+/*
+ *  Checks clock switch through FRC: two switches with wait for each
+ */
+static void TestFullSwitch(const char *step, TestStep_t result)
+{
+    TestCheck((testOsc.switchCount == 2) && (testOsc.frcSwitchCount == 1), "clock switch through FRC", step);
+    TestCheck(testOsc.freqChangeCount == 2, "SYSCLK of FRC in between", step);
+    TestCheck(result.timeUs >= 2 * TEST_SWITCH_US, "waits for both clock switches", step);
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+
+    /* FRCPLL at 40 MHz (FPLLIDIV = 2, PLLMULT = 20, PLLODIV = 2), clock
+     * switching enabled */
+    HostPoke(HOST_DEVCFG2_ADDR, CFG_FPLLIDIV_2 << CFG_FPLLIDIV_POS);
+    testOsc.oscCon = (OSC_COSC_FRCPLL << OSC_COSC_POS) | (OSC_COSC_FRCPLL << OSC_NOSC_POS) |
+                     (OSC_PLLMULT_20 << OSC_PLLMULT_POS) | (OSC_PLLODIV_2 << OSC_PLLODIV_POS) | OSC_PBDIVRDY_MASK;
+    HostPoke(HOST_OSCCON_ADDR, testOsc.oscCon);
+
+    HostModelAdd(&testOscModel);
+
+    TestCheck(OSC_GetSysFreq() == 40000000, "initial SYSCLK", "initial");
+
+    /* PLLODIV only, PBDIV unchanged */
+    TestStep_t fastStep = TestConfig("FRCPLL 40 -> 20 MHz", OSC_COSC_FRCPLL, 20000000, 20000000);
+    TestFastRetune("FRCPLL 40 -> 20 MHz", 40000000, 20000000, false);
+
+    /* PLLODIV and PBDIV (ready) */
+    TestConfig("FRCPLL 20 -> 40 MHz, PBCLK 10 MHz", OSC_COSC_FRCPLL, 40000000, 10000000);
+    TestFastRetune("FRCPLL 20 -> 40 MHz, PBCLK 10 MHz", 20000000, 40000000, true);
+
+    /* PBDIV only, previous PBDIV write not yet ready */
+    TestStep_t pbStep = TestConfig("PBCLK 10 -> 20 MHz", OSC_COSC_FRCPLL, 40000000, 20000000);
+    TestFastRetune("PBCLK 10 -> 20 MHz", 40000000, 40000000, true);
+    TestCheck((pbStep.startPbDivLeft != 0) && (pbStep.timeUs >= pbStep.startPbDivLeft), "waits for PBDIVRDY", "PBCLK 10 -> 20 MHz");
+
+    /* PLLMULT change */
+    TestStep_t fullStep = TestConfig("FRCPLL 40 -> 48 MHz", OSC_COSC_FRCPLL, 48000000, 24000000);
+    TestFullSwitch("FRCPLL 40 -> 48 MHz", fullStep);
+
+    /* Source change, then FRCDIV only */
+    TestFullSwitch("FRCPLL -> FRCDIV 4 MHz", TestConfig("FRCPLL -> FRCDIV 4 MHz", OSC_COSC_FRCDIV, 4000000, 4000000));
+    TestConfig("FRCDIV 4 -> 1 MHz", OSC_COSC_FRCDIV, 1000000, 1000000);
+    TestFastRetune("FRCDIV 4 -> 1 MHz", 4000000, 1000000, false);
+
+    /* SOSC waits for SOSCRDY */
+    TestStep_t soscStep = TestConfig("FRCDIV -> SOSC", OSC_COSC_SOSC, OSC_SOSC_FREQ, OSC_SOSC_FREQ);
+    TestCheck((HostPeek(HOST_OSCCON_ADDR) & OSC_SOSCRDY_MASK) && (soscStep.timeUs >= 2 * TEST_SWITCH_US + TEST_SOSC_US),
+              "waits for SOSCRDY", "FRCDIV -> SOSC");
+
+    TestFullSwitch("SOSC -> FRCPLL 40 MHz", TestConfig("SOSC -> FRCPLL 40 MHz", OSC_COSC_FRCPLL, 40000000, 40000000));
+    TestCheck(!(HostPeek(HOST_OSCCON_ADDR) & OSC_SOSCEN_MASK), "SOSC disabled", "SOSC -> FRCPLL 40 MHz");
+
+    /* Retune is far shorter than clock switch */
+    TestCheck(fastStep.reportedUs * 10 < fullStep.reportedUs, "retune shorter than clock switch", "comparison");
+
+    printf("%u checks, %u failed (retune %u us, clock switch %u us with %u us switch delay)\n",
+           checkCount, failCount, fastStep.reportedUs, fullStep.reportedUs, TEST_SWITCH_US);
+
+    return (failCount == 0) ? 0 : 1;
+}
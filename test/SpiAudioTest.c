@@ -0,0 +1,257 @@
+/*
+ *  Host test of SPI_StartAudioStream() on the SPI register model: full-duplex
+ *  ping-pong streaming in Audio (I2S, 16-bit) and Framed (32-bit) mode keeps
+ *  the sample sequence without gap at the buffer swap, each half is reported
+ *  only once its RX data has arrived, a stalled application is counted as
+ *  TX underruns and RX overruns
+ */
+#include "HostSfr.h"
+#include "../Spi/Spi.c"
+#include "HostSpi.h"
+
+#define TEST_FRAME_TICKS    24
+#define TEST_HALF_MAX       32
+#define TEST_HALF_COUNT     12          // Halves streamed per mode
+#define TEST_MAX_TICKS      200000
+
+/** Stream under test **/
+static uint32_t testHalfSize;
+static uint32_t testFrameSize;
+static uint32_t testFrameMask;
+static uint32_t txBuf[2 * TEST_HALF_MAX];
+static uint32_t rxBuf[2 * TEST_HALF_MAX];
+
+/** Slave device: MOSI sample sequence (from first sample on), MISO frame
+ * counter (frames clocked before stream start are received too) **/
+static bool testIsChecking;
+static uint32_t testMosiCount;
+static uint32_t testMosiErrorCount;
+static uint32_t testMisoCount;
+static uint32_t testRxLast;
+
+/** Half callbacks **/
+static uint32_t testHalfDone;
+static uint32_t testHalfOrderErrorCount;
+static uint32_t testRxErrorCount;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what, const char *mode)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s (%s)\n", what, mode);
+        failCount++;
+    }
+}
+
+
+/*
+ *  Sample with given index of stream
+ */
+static uint32_t TestSample(uint32_t idx)
+{
+    return (0x10203040u + idx * 0x01010101u * 7) & testFrameMask;
+}
+
+
+static void TestFrameSet(uint32_t *bufPtr, uint32_t idx, uint32_t value)
+{
+    if( testFrameSize == 2 )
+    {
+        ((uint16_t *)bufPtr)[idx] = (uint16_t)value;
+    }
+    else
+    {
+        bufPtr[idx] = value;
+    }
+}
+
+
+static uint32_t TestFrameGet(const uint32_t *bufPtr, uint32_t idx)
+{
+    return (testFrameSize == 2) ? ((const uint16_t *)bufPtr)[idx] : bufPtr[idx];
+}
+
+
+/*
+ *  Slave device (codec): checks MOSI sample sequence once first sample is
+ *  seen (underrun frames clocked before are zero), returns frame counter
+ */
+static uint32_t TestDeviceShift(uint32_t module, uint32_t data)
+{
+    (void)module;
+
+    if( testIsChecking && ((testMosiCount != 0) || (data == TestSample(0))) )
+    {
+        if( data != TestSample(testMosiCount) )
+        {
+            testMosiErrorCount++;
+        }
+        testMosiCount++;
+    }
+
+    return ++testMisoCount & testFrameMask;
+}
+
+
+/*
+ *  Half callback: received half must be complete and continue frame counter
+ *  of previous half, transmitted half is refilled with samples of its next
+ *  period
+ */
+static void TestHalfDone(uint32_t half)
+{
+    uint32_t baseIdx = testHalfDone * testHalfSize;
+    uint32_t *txHalfPtr = (uint32_t *)((uint8_t *)txBuf + half * testHalfSize * testFrameSize);
+    uint32_t *rxHalfPtr = (uint32_t *)((uint8_t *)rxBuf + half * testHalfSize * testFrameSize);
+
+    if( half != (testHalfDone & 1) )
+    {
+        testHalfOrderErrorCount++;
+    }
+
+    for( uint32_t idx = 0; idx < testHalfSize; idx++ )
+    {
+        uint32_t rxFrame = TestFrameGet(rxHalfPtr, idx);
+
+        if( (rxFrame == 0) || ((testRxLast != 0) && (rxFrame != ((testRxLast + 1) & testFrameMask))) )
+        {
+            testRxErrorCount++;
+        }
+        testRxLast = rxFrame;
+
+        TestFrameSet(rxHalfPtr, idx, 0);
+        TestFrameSet(txHalfPtr, idx, TestSample(baseIdx + 2 * testHalfSize + idx));
+    }
+
+    testHalfDone++;
+}
+
+
+static bool TestIsStreamed(void)
+{
+    return testHalfDone >= TEST_HALF_COUNT;
+}
+
+
+/*
+ *  Streams given number of halves, then stalls the application (no ISR) and
+ *  checks error counters
+ */
+static void TestStream(const char *mode, uint32_t halfSize)
+{
+    uint32_t underrunCount, overrunCount;
+
+    testHalfSize = halfSize;
+    testHalfDone = 0;
+    testHalfOrderErrorCount = 0;
+    testRxErrorCount = 0;
+    testMosiCount = 0;
+    testMosiErrorCount = 0;
+    testMisoCount = 0;
+    testRxLast = 0;
+    testIsChecking = true;
+
+    memset(rxBuf, 0, sizeof(rxBuf));
+    for( uint32_t idx = 0; idx < 2 * halfSize; idx++ )
+    {
+        TestFrameSet(txBuf, idx, TestSample(idx));
+    }
+
+    /* Half must be longer than FIFO */
+    uint32_t depth = SpiContextGet(&SPI1_MODULE)->fifoOps->fifoDepth;
+    TestCheck(!SPI_StartAudioStream(&SPI1_MODULE, rxBuf, txBuf, depth, TestHalfDone), "half of FIFO depth rejected", mode);
+
+    TestCheck(SPI_StartAudioStream(&SPI1_MODULE, rxBuf, txBuf, halfSize, TestHalfDone), "stream started", mode);
+    TestCheck(HostSpiRun(TestIsStreamed, TEST_MAX_TICKS), "halves streamed", mode);
+
+    /* Continuous sample sequence across swaps (an underrun shifts zero frame,
+     * RX halves also hold frames clocked before stream start) */
+    TestCheck((testMosiCount >= (TEST_HALF_COUNT - 1) * halfSize) && (testMosiErrorCount == 0), "MOSI sequence without gap", mode);
+    TestCheck(hostSpi[0].idleTicks == 0, "SCK clocks continuously", mode);
+    TestCheck(testHalfOrderErrorCount == 0, "halves reported alternately", mode);
+    TestCheck(testRxErrorCount == 0, "half reported after its RX data arrived", mode);
+    TestCheck(SPI_GetAudioErrorCount(&SPI1_MODULE, &underrunCount, &overrunCount) && (underrunCount == 0) && (overrunCount == 0),
+              "no underrun or overrun", mode);
+    TestCheck(SPI_IsSpiBusy(&SPI1_MODULE), "module busy while streaming", mode);
+
+    /* Stalled application: TX FIFO runs empty, RX FIFO overflows */
+    testIsChecking = false;
+    HostIdle(4 * halfSize * TEST_FRAME_TICKS);
+    HostSpiService();
+
+    TestCheck(SPI_GetAudioErrorCount(&SPI1_MODULE, &underrunCount, &overrunCount) && (underrunCount != 0) && (overrunCount != 0),
+              "stall counted as underrun and overrun", mode);
+
+    TestCheck(SPI_StopAudioStream(&SPI1_MODULE), "stream stopped", mode);
+    TestCheck(!(HostPeek(HOST_IEC1_ADDR) & (IC_SPI1TXIE_MASK | IC_SPI1EIE_MASK)), "sources disabled", mode);
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+    HostSpiInit();
+
+    hostSpi[0].frameTicks = TEST_FRAME_TICKS;
+    hostSpi[0].device = TestDeviceShift;
+
+    /* Audio Protocol Interface mode: I2S, 16-bit data in 16-bit channel */
+    SpiAudioConfig_t audioConfig = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = SS1_RPA0},
+        .dataWidth = SPI_WIDTH_16DATA_16CH,
+        .protocolMode = SPI_AUDMOD_I2S,
+        .clkMode = SPI_CLK_MODE_1,
+        .sckFreq = 1536000
+    };
+
+    testFrameSize = 2;
+    testFrameMask = 0xFFFF;
+    TestCheck(SPI_ConfigAudioModeSfr(&SPI1_MODULE, audioConfig), "configuration", "Audio");
+    hostSpi[0].idleTicks = 0;
+    TestStream("Audio", 24);
+
+    /* Framed mode: 32-bit frames, frame sync pulse every second frame */
+    SpiFramedConfig_t framedConfig = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = SS1_RPA0},
+        .frameWidth = SPI_WIDTH_32BIT,
+        .syncCount = SPI_FRMCNT_2,
+        .isSyncActiveHigh = true,
+        .clkMode = SPI_CLK_MODE_0,
+        .sckFreq = 2048000
+    };
+
+    testFrameSize = 4;
+    testFrameMask = 0xFFFFFFFF;
+    TestCheck(SPI_ConfigFramedModeSfr(&SPI1_MODULE, framedConfig), "configuration", "Framed");
+
+    uint32_t con = HostPeek(HOST_SPI_ADDR(0) + HOST_SPI_CON);
+    TestCheck((con & SPI_FRMEN_MASK) && !(con & SPI_CKE_MASK) && !(con & SPI_FRMSYNC_MASK) && (con & SPI_FRMPOL_MASK) &&
+              (((con & SPI_FRMCNT_MASK) >> SPI_FRMCNT_POS) == SPI_FRMCNT_2), "SPIxCON frame sync settings", "Framed");
+
+    hostSpi[0].idleTicks = 0;
+    TestStream("Framed", 10);
+
+    /* Streaming needs Audio or Framed mode */
+    SpiStandardConfig_t spiConfig = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = GPIO_RPA0},
+        .frameWidth = SPI_WIDTH_16BIT,
+        .clkMode = SPI_CLK_MODE_0,
+        .sckFreq = 2000000
+    };
+
+    TestCheck(SPI_ConfigStandardModeSfr(&SPI1_MODULE, spiConfig), "configuration", "Standard");
+    TestCheck(!SPI_StartAudioStream(&SPI1_MODULE, rxBuf, txBuf, 24, TestHalfDone), "stream rejected", "Standard");
+
+    printf("%u checks, %u failed\n", checkCount, failCount);
+
+    return (failCount == 0) ? 0 : 1;
+}
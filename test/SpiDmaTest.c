@@ -0,0 +1,229 @@
+/*
+ *  Host test of SPI_MasterWriteDma() on the SPI/DMA register model: frame and
+ *  byte order of 8/16/32-bit frames in both directions, dummy write and dummy
+ *  read, completion callback executed once after last frame is shifted out
+ *  and no ISR waiting for the bus
+ */
+#include "HostSfr.h"
+#include "../Spi/Spi.c"
+#include "HostSpi.h"
+
+#define TEST_SS_PIN         GPIO_RPA0
+#define TEST_FRAME_TICKS    40
+#define TEST_MAX_TICKS      200000
+#define TEST_MAX_SIZE       70
+
+/** Frames seen by Slave device **/
+static uint32_t testMosi[TEST_MAX_SIZE + 1];
+static uint32_t testMosiCount;
+static uint32_t testSsErrorCount;
+
+/** Completion callback **/
+static uint32_t testDoneCount;
+static bool testIsBusAtDone;            // Frames pending or Slave Select active at callback
+
+/** Longest time spent in single ISR dispatch **/
+static uint64_t testIsrMaxTicks;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what, uint32_t width, uint32_t mode)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s (frame width %u, mode %u)\n", what, width, mode);
+        failCount++;
+    }
+}
+
+
+/*
+ *  Slave device: records MOSI frame and returns frame derived from it
+ */
+static uint32_t TestDeviceShift(uint32_t module, uint32_t data)
+{
+    (void)module;
+
+    if( !HostSsIsActive(TEST_SS_PIN) )
+    {
+        testSsErrorCount++;
+    }
+
+    if( testMosiCount < TEST_MAX_SIZE + 1 )
+    {
+        testMosi[testMosiCount] = data;
+    }
+    testMosiCount++;
+
+    return ~data ^ 0x5A5A5A5A;
+}
+
+
+static void TestDone(void)
+{
+    testDoneCount++;
+    testIsBusAtDone = hostSpi[0].isShifting || (hostSpi[0].txCount != 0) || HostSsIsActive(TEST_SS_PIN);
+}
+
+
+/*
+ *  Runs ISRs until transfer is done, keeps longest ISR dispatch
+ */
+static bool TestRun(void)
+{
+    uint64_t endTick = hostTick + TEST_MAX_TICKS;
+
+    while( SPI_IsSpiBusy(&SPI1_MODULE) )
+    {
+        if( hostTick >= endTick )
+        {
+            return false;
+        }
+
+        HostIdle(1);
+
+        uint64_t startTick = hostTick;
+        HostSpiService();
+        testIsrMaxTicks = (hostTick - startTick > testIsrMaxTicks) ? (hostTick - startTick) : testIsrMaxTicks;
+    }
+
+    return true;
+}
+
+
+/*
+ *  Frame value of buffer element
+ */
+static uint32_t TestFrameGet(const void *bufPtr, uint32_t idx, uint32_t frameSize)
+{
+    if( frameSize == 1 )
+    {
+        return ((const uint8_t *)bufPtr)[idx];
+    }
+    if( frameSize == 2 )
+    {
+        return ((const uint16_t *)bufPtr)[idx];
+    }
+
+    return ((const uint32_t *)bufPtr)[idx];
+}
+
+
+/*
+ *  Transfers packet with given frame width (mode 0: normal, 1: dummy write,
+ *  2: dummy read)
+ */
+static void TestCase(SpiFrameWidth_t frameWidth, uint32_t mode, uint32_t size)
+{
+    static uint32_t txBuf[TEST_MAX_SIZE];
+    static uint32_t rxBuf[TEST_MAX_SIZE + 1];
+    static const uint32_t widthBits[] = {8, 16, 32};
+    uint32_t frameSize = widthBits[frameWidth] / 8;
+    uint32_t frameMask = (frameSize == 4) ? 0xFFFFFFFF : ((1u << (8 * frameSize)) - 1);
+    uint32_t width = widthBits[frameWidth];
+
+    SpiStandardConfig_t spiConfig = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = TEST_SS_PIN},
+        .frameWidth = frameWidth,
+        .clkMode = SPI_CLK_MODE_0,
+        .sckFreq = 2000000
+    };
+
+    TestCheck(SPI_ConfigStandardModeSfr(&SPI1_MODULE, spiConfig), "configuration", width, mode);
+    TestCheck(SPI_EnableSsState(&SPI1_MODULE, TEST_SS_PIN), "Slave Select", width, mode);
+
+    /* Byte pattern exposes byte order of each frame */
+    uint8_t *txBytePtr = (uint8_t *)txBuf;
+
+    for( uint32_t idx = 0; idx < sizeof(txBuf); idx++ )
+    {
+        txBytePtr[idx] = (uint8_t)(0x11 + idx * 0x13);
+    }
+    memset(rxBuf, 0xEE, sizeof(rxBuf));
+
+    testMosiCount = 0;
+    testSsErrorCount = 0;
+    testDoneCount = 0;
+    testIsBusAtDone = false;
+
+    volatile void *txPtr = (mode == 1) ? NULL : txBuf;
+    volatile void *rxPtr = (mode == 2) ? NULL : rxBuf;
+
+    TestCheck(SPI_MasterWriteDma(&SPI1_MODULE, rxPtr, txPtr, size, TestDone), "transfer started", width, mode);
+    TestCheck(TestRun(), "transfer done", width, mode);
+
+    TestCheck(testDoneCount == 1, "callback executed once", width, mode);
+    TestCheck(!testIsBusAtDone, "callback after last frame and Slave Select release", width, mode);
+    TestCheck((testMosiCount == size) && (testSsErrorCount == 0), "frames framed by Slave Select", width, mode);
+
+    bool isTxOk = true;
+    bool isRxOk = true;
+
+    for( uint32_t idx = 0; idx < size; idx++ )
+    {
+        /* Dummy write sends zero frames */
+        uint32_t txFrame = (mode == 1) ? 0 : TestFrameGet(txBuf, idx, frameSize);
+
+        isTxOk = isTxOk && (testMosi[idx] == txFrame);
+
+        if( mode != 2 )
+        {
+            isRxOk = isRxOk && (TestFrameGet(rxBuf, idx, frameSize) == ((~txFrame ^ 0x5A5A5A5A) & frameMask));
+        }
+    }
+
+    TestCheck(isTxOk, "MOSI frames and byte order", width, mode);
+    TestCheck(isRxOk, "MISO frames and byte order", width, mode);
+
+    /* Bytes behind RX packet are untouched */
+    if( mode != 2 )
+    {
+        TestCheck(((uint8_t *)rxBuf)[size * frameSize] == 0xEE, "RX buffer bound", width, mode);
+    }
+
+    /* Module and DMA channels are free for next transfer */
+    TestCheck(!SPI_IsSpiBusy(&SPI1_MODULE) && (dmaCtx == NULL), "module released", width, mode);
+    TestCheck(!(HostPeek(HOST_IEC1_ADDR) & (IC_DMA0IE_MASK | IC_DMA1IE_MASK | IC_SPI1TXIE_MASK)), "sources disabled", width, mode);
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+    HostSpiInit();
+
+    hostSpi[0].frameTicks = TEST_FRAME_TICKS;
+    hostSpi[0].device = TestDeviceShift;
+
+    static const uint32_t sizeList[] = {1, 3, 17, TEST_MAX_SIZE};
+
+    for( uint32_t width = SPI_WIDTH_8BIT; width <= SPI_WIDTH_32BIT; width++ )
+    {
+        for( uint32_t mode = 0; mode < 3; mode++ )
+        {
+            for( uint32_t idx = 0; idx < sizeof(sizeList) / sizeof(sizeList[0]); idx++ )
+            {
+                TestCase(width, mode, sizeList[idx]);
+            }
+        }
+    }
+
+    /* No ISR waits for frames being shifted out (a tick passes per SFR access,
+     * TX FIFO alone holds up to 16 frames of 8-bit width) */
+    checkCount++;
+    if( testIsrMaxTicks >= 2 * TEST_FRAME_TICKS )
+    {
+        fprintf(stderr, "FAIL: ISR took %llu ticks\n", (unsigned long long)testIsrMaxTicks);
+        failCount++;
+    }
+
+    printf("%u checks, %u failed (longest ISR %llu ticks, frame %u ticks)\n", checkCount, failCount,
+           (unsigned long long)testIsrMaxTicks, TEST_FRAME_TICKS);
+
+    return (failCount == 0) ? 0 : 1;
+}
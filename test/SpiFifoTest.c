@@ -0,0 +1,363 @@
+/*
+ *  Host test of frame-width-specialized FIFO routines: TX FIFO fill and RX
+ *  FIFO drain of 8/16/32-bit frames with normal and dummy data are compared
+ *  with a reference copy of the routines which decoded SPIxCON.MODE and the
+ *  dummy flags on every call (executed host instructions and SFR accesses
+ *  on the SPI register model, same frames and RX data)
+ */
+#include "HostSfr.h"
+#include "../Spi/Spi.c"
+#include "HostSpi.h"
+
+#define TEST_SS_PIN         GPIO_RPA0
+#define TEST_FRAME_TICKS    4
+
+/** Context of reference routines (dummy flags instead of bound routines) **/
+typedef struct {
+    SpiSfr_t           *spiSfr;
+    volatile void      *txDataPtr;
+    volatile void      *rxDataPtr;
+    volatile uint32_t   txDataSize;
+    volatile uint32_t   rxDataSize;
+    volatile uint32_t   txSegCount;
+    volatile uint32_t   rxSegCount;
+    volatile bool       isDummyWrite;
+    volatile bool       isDummyRead;
+} TestRefCtx_t;
+
+/** Frames seen by Slave device **/
+static uint32_t testMosi[16];
+static uint32_t testMosiCount;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what, uint32_t width, bool isDummy)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s (frame width %u, %s data)\n", what, width, isDummy ? "dummy" : "normal");
+        failCount++;
+    }
+}
+
+
+/*
+ *  Slave device: records MOSI frame and returns its complement
+ */
+static uint32_t TestDeviceShift(uint32_t module, uint32_t data)
+{
+    (void)module;
+
+    if( testMosiCount < 16 )
+    {
+        testMosi[testMosiCount] = data;
+    }
+    testMosiCount++;
+
+    return ~data;
+}
+
+
+/*
+ *  Reference: TX FIFO fill with frame width decoded from SPIxCON.MODE and
+ *  dummy flag tested in every loop
+ */
+static __attribute__((noinline)) bool TestRefWrite(TestRefCtx_t *const ctx)
+{
+    SpiFrameWidth_t frameWidth = (ctx->spiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
+    uint32_t fifoFree;
+    uint32_t tempSize;
+
+    if( frameWidth == SPI_WIDTH_8BIT )
+    {
+        fifoFree = 16;
+    }
+    else if( frameWidth == SPI_WIDTH_16BIT )
+    {
+        fifoFree = 8;
+    }
+    else if( frameWidth == SPI_WIDTH_32BIT )
+    {
+        fifoFree = 4;
+    }
+    else
+    {
+        return false;
+    }
+
+    do
+    {
+        tempSize = (ctx->txDataSize > fifoFree) ? fifoFree : ctx->txDataSize;
+        ctx->txDataSize -= tempSize;
+        fifoFree -= tempSize;
+
+        if( ctx->isDummyWrite )
+        {
+            while( tempSize-- )
+            {
+                ctx->spiSfr->SPIxBUF.W = dummyTxData;
+            }
+        }
+        else if( frameWidth == SPI_WIDTH_8BIT )
+        {
+            while( tempSize-- )
+            {
+                ctx->spiSfr->SPIxBUF.W = *((uint8_t *)ctx->txDataPtr);
+                ctx->txDataPtr = (uint8_t *)ctx->txDataPtr + 1;
+            }
+        }
+        else if( frameWidth == SPI_WIDTH_16BIT )
+        {
+            while( tempSize-- )
+            {
+                ctx->spiSfr->SPIxBUF.W = *((uint16_t *)ctx->txDataPtr);
+                ctx->txDataPtr = (uint16_t *)ctx->txDataPtr + 1;
+            }
+        }
+        else
+        {
+            while( tempSize-- )
+            {
+                ctx->spiSfr->SPIxBUF.W = *((uint32_t *)ctx->txDataPtr);
+                ctx->txDataPtr = (uint32_t *)ctx->txDataPtr + 1;
+            }
+        }
+    }
+    while( (fifoFree != 0) && (ctx->txDataSize == 0) && (ctx->txSegCount != 0) );
+
+    return true;
+}
+
+
+/*
+ *  Reference: RX FIFO drain with frame width decoded from SPIxCON.MODE and
+ *  dummy flag tested in every loop
+ */
+static __attribute__((noinline)) bool TestRefRead(TestRefCtx_t *const ctx)
+{
+    SpiFrameWidth_t frameWidth = (ctx->spiSfr->SPIxCON.W & SPI_MODE_MASK) >> SPI_MODE_POS;
+    uint32_t tempSize;
+
+    if( frameWidth > SPI_WIDTH_32BIT )
+    {
+        return false;
+    }
+
+    do
+    {
+        tempSize = (ctx->spiSfr->SPIxSTAT.W & SPI_RXBUFELM_MASK) >> SPI_RXBUFELM_POS;
+        tempSize = (tempSize > ctx->rxDataSize) ? ctx->rxDataSize : tempSize;
+        ctx->rxDataSize -= tempSize;
+
+        if( ctx->isDummyRead )
+        {
+            while( tempSize-- )
+            {
+                dummyRxData = ctx->spiSfr->SPIxBUF.W;
+            }
+        }
+        else if( frameWidth == SPI_WIDTH_8BIT )
+        {
+            while( tempSize-- )
+            {
+                *((uint8_t *)ctx->rxDataPtr) = ctx->spiSfr->SPIxBUF.W;
+                ctx->rxDataPtr = (uint8_t *)ctx->rxDataPtr + 1;
+            }
+        }
+        else if( frameWidth == SPI_WIDTH_16BIT )
+        {
+            while( tempSize-- )
+            {
+                *((uint16_t *)ctx->rxDataPtr) = ctx->spiSfr->SPIxBUF.W;
+                ctx->rxDataPtr = (uint16_t *)ctx->rxDataPtr + 1;
+            }
+        }
+        else
+        {
+            while( tempSize-- )
+            {
+                *((uint32_t *)ctx->rxDataPtr) = ctx->spiSfr->SPIxBUF.W;
+                ctx->rxDataPtr = (uint32_t *)ctx->rxDataPtr + 1;
+            }
+        }
+    }
+    while( !(ctx->spiSfr->SPIxSTAT.W & SPI_SPIRBE_MASK) && (ctx->rxDataSize == 0) && (ctx->rxSegCount != 0) );
+
+    return true;
+}
+
+
+/** Bound routines under test (not inlined into measured code) **/
+static __attribute__((noinline)) void TestWrite(SpiContext_t *const ctx)
+{
+    SpiWrite(ctx);
+}
+
+static __attribute__((noinline)) void TestRead(SpiContext_t *const ctx)
+{
+    SpiRead(ctx);
+}
+
+
+/*
+ *  Cost of one FIFO fill and one FIFO drain (host instructions and SFR
+ *  accesses)
+ */
+typedef struct {
+    uint64_t    fillSteps;
+    uint64_t    drainSteps;
+    uint64_t    fillAccesses;
+    uint64_t    drainAccesses;
+} TestCost_t;
+
+
+/*
+ *  Lets frames in TX FIFO shift out to RX FIFO
+ */
+static void TestShiftAll(uint32_t frameCount)
+{
+    HostIdle((frameCount + 2) * TEST_FRAME_TICKS);
+}
+
+
+/*
+ *  Given number of frames through bound routines (isRef false) or reference
+ *  routines (isRef true)
+ */
+static TestCost_t TestMeasure(uint32_t size, bool isDummy, bool isRef, void *rxBuf, const void *txBuf)
+{
+    SpiContext_t *const ctx = SpiContextGet(&SPI1_MODULE);
+    TestRefCtx_t refCtx = {
+        .spiSfr = &SPI1_MODULE,
+        .txDataPtr = isDummy ? NULL : (void *)txBuf,
+        .rxDataPtr = isDummy ? NULL : rxBuf,
+        .txDataSize = size,
+        .rxDataSize = size,
+        .isDummyWrite = isDummy,
+        .isDummyRead = isDummy
+    };
+    TestCost_t cost;
+    uint64_t startTick;
+
+    SpiPacketSet(ctx, isDummy ? NULL : rxBuf, isDummy ? NULL : (void *)txBuf, size);
+    testMosiCount = 0;
+
+    startTick = hostTick;
+    HostCountBegin();
+    if( isRef )
+    {
+        TestRefWrite(&refCtx);
+    }
+    else
+    {
+        TestWrite(ctx);
+    }
+    cost.fillSteps = HostCountEnd();
+    cost.fillAccesses = hostTick - startTick;
+
+    TestShiftAll(size);
+
+    startTick = hostTick;
+    HostCountBegin();
+    if( isRef )
+    {
+        TestRefRead(&refCtx);
+    }
+    else
+    {
+        TestRead(ctx);
+    }
+    cost.drainSteps = HostCountEnd();
+    cost.drainAccesses = hostTick - startTick;
+
+    return cost;
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+    HostSpiInit();
+
+    static const uint32_t widthBits[] = {8, 16, 32};
+    static uint32_t txBuf[4];
+    static uint32_t rxBuf[2][4];
+    uint64_t newTotal = 0;
+    uint64_t refTotal = 0;
+
+    hostSpi[0].frameTicks = TEST_FRAME_TICKS;
+    hostSpi[0].device = TestDeviceShift;
+
+    for( uint32_t idx = 0; idx < sizeof(txBuf); idx++ )
+    {
+        ((uint8_t *)txBuf)[idx] = (uint8_t)(0x21 + idx * 0x35);
+    }
+
+    printf("frame  data    fill new/ref  drain new/ref  per frame new/ref (host instructions)\n");
+
+    for( uint32_t width = SPI_WIDTH_8BIT; width <= SPI_WIDTH_32BIT; width++ )
+    {
+        SpiStandardConfig_t spiConfig = {
+            .isMasterEnabled = true,
+            .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = TEST_SS_PIN},
+            .frameWidth = width,
+            .clkMode = SPI_CLK_MODE_0,
+            .sckFreq = 2000000
+        };
+
+        TestCheck(SPI_ConfigStandardModeSfr(&SPI1_MODULE, spiConfig), "configuration", widthBits[width], false);
+
+        for( uint32_t dummy = 0; dummy < 2; dummy++ )
+        {
+            bool isDummy = (dummy != 0);
+            uint32_t depth = SpiContextGet(&SPI1_MODULE)->fifoOps->fifoDepth;
+            uint32_t mosi[2][16];
+
+            memset(rxBuf, 0, sizeof(rxBuf));
+
+            /* Full FIFO */
+            TestCost_t newCost = TestMeasure(depth, isDummy, false, rxBuf[0], txBuf);
+            memcpy(mosi[0], testMosi, sizeof(mosi[0]));
+            TestCost_t refCost = TestMeasure(depth, isDummy, true, rxBuf[1], txBuf);
+            memcpy(mosi[1], testMosi, sizeof(mosi[1]));
+
+            /* Same frames on the bus and same RX data */
+            TestCheck(memcmp(mosi[0], mosi[1], sizeof(mosi[0])) == 0, "MOSI frames match reference", widthBits[width], isDummy);
+            TestCheck(memcmp(rxBuf[0], rxBuf[1], sizeof(rxBuf[0])) == 0, "RX data matches reference", widthBits[width], isDummy);
+            TestCheck(isDummy || ((((uint8_t *)rxBuf[0])[0] ^ ((uint8_t *)txBuf)[0]) == 0xFF), "RX data received",
+                      widthBits[width], isDummy);
+
+            /* SPIxCON is not read to decode frame width */
+            TestCheck(newCost.fillAccesses + 1 == refCost.fillAccesses, "fill without SPIxCON access", widthBits[width], isDummy);
+            TestCheck(newCost.drainAccesses + 1 == refCost.drainAccesses, "drain without SPIxCON access", widthBits[width], isDummy);
+
+            /* Single frame: instructions per frame are the difference to full
+             * FIFO (call of bound routine is a fixed cost) */
+            TestCost_t newOne = TestMeasure(1, isDummy, false, rxBuf[0], txBuf);
+            TestCost_t refOne = TestMeasure(1, isDummy, true, rxBuf[1], txBuf);
+            uint64_t newFrame = (newCost.fillSteps + newCost.drainSteps - newOne.fillSteps - newOne.drainSteps) / (depth - 1);
+            uint64_t refFrame = (refCost.fillSteps + refCost.drainSteps - refOne.fillSteps - refOne.drainSteps) / (depth - 1);
+
+            TestCheck(newFrame <= refFrame, "instructions per frame", widthBits[width], isDummy);
+
+            newTotal += newCost.fillSteps + newCost.drainSteps;
+            refTotal += refCost.fillSteps + refCost.drainSteps;
+
+            printf("%2u-bit %-6s  %4llu/%-4llu     %4llu/%-4llu        %2llu/%-2llu\n", widthBits[width], isDummy ? "dummy" : "normal",
+                   (unsigned long long)newCost.fillSteps, (unsigned long long)refCost.fillSteps,
+                   (unsigned long long)newCost.drainSteps, (unsigned long long)refCost.drainSteps,
+                   (unsigned long long)newFrame, (unsigned long long)refFrame);
+        }
+    }
+
+    TestCheck(newTotal < refTotal, "fewer instructions in total", 0, false);
+
+    printf("%u checks, %u failed (host instructions: bound %llu, reference %llu)\n", checkCount, failCount,
+           (unsigned long long)newTotal, (unsigned long long)refTotal);
+
+    return (failCount == 0) ? 0 : 1;
+}
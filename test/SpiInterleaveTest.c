@@ -0,0 +1,185 @@
+/*
+ *  Host test of per-module Slave Select state: SPI1 and SPI2 Masters run
+ *  interrupt-driven full-duplex transfers of different frame width and SCK
+ *  speed at the same time on the SPI register model, each Slave device checks
+ *  that only its own Slave Select pin frames its data
+ */
+#include "HostSfr.h"
+#include "../Spi/Spi.c"
+#include "HostSpi.h"
+
+#define TEST_COUNT(array)   (sizeof(array) / sizeof(array[0]))
+
+#define TEST_SPI1_SS        GPIO_RPA0
+#define TEST_SPI2_SS        GPIO_RPB3
+#define TEST_SPI1_SIZE      40
+#define TEST_SPI2_SIZE      24
+#define TEST_MAX_TICKS      100000
+
+/** Frames seen by Slave device of each module **/
+typedef struct {
+    uint32_t    data[64];
+    uint32_t    count;
+    uint32_t    ssErrorCount;       // Frames without own or with foreign Slave Select
+} TestDevice_t;
+
+static TestDevice_t testDevice[HOST_SPI_COUNT];
+static const uint32_t testSsPin[HOST_SPI_COUNT] = {TEST_SPI1_SS, TEST_SPI2_SS};
+
+/* Transfer of module in progress (its Slave Select pin may be active) */
+static volatile bool testIsActive[HOST_SPI_COUNT];
+
+/* Frames shifted while other module was shifting too */
+static uint32_t testOverlapCount;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s\n", what);
+        failCount++;
+    }
+}
+
+
+/*
+ *  Slave device: records MOSI frame and returns its complement as MISO frame
+ */
+static uint32_t TestDeviceShift(uint32_t module, uint32_t data)
+{
+    TestDevice_t *devPtr = &testDevice[module];
+    uint32_t other = module ^ 1;
+
+    if( !HostSsIsActive(testSsPin[module]) || (!testIsActive[other] && HostSsIsActive(testSsPin[other])) )
+    {
+        devPtr->ssErrorCount++;
+    }
+
+    if( hostSpi[other].isShifting )
+    {
+        testOverlapCount++;
+    }
+
+    if( devPtr->count < TEST_COUNT(devPtr->data) )
+    {
+        devPtr->data[devPtr->count++] = data;
+    }
+
+    return ~data;
+}
+
+
+static bool TestIsIdle(void)
+{
+    return !SPI_IsSpiBusy(&SPI1_MODULE) && !SPI_IsSpiBusy(&SPI2_MODULE);
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+    HostSpiInit();
+
+    SpiStandardConfig_t spi1Config = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = TEST_SPI1_SS},
+        .frameWidth = SPI_WIDTH_8BIT,
+        .clkMode = SPI_CLK_MODE_0,
+        .sckFreq = 4000000
+    };
+    SpiStandardConfig_t spi2Config = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI2_RPA2, .sdoPin = SDO2_RPB2, .ss1Pin = TEST_SPI2_SS},
+        .frameWidth = SPI_WIDTH_16BIT,
+        .clkMode = SPI_CLK_MODE_0,
+        .sckFreq = 1000000
+    };
+
+    TestCheck(SPI_ConfigStandardModeSfr(&SPI1_MODULE, spi1Config), "SPI1 configuration");
+    TestCheck(SPI_EnableSsState(&SPI1_MODULE, TEST_SPI1_SS), "SPI1 Slave Select enabled");
+
+    /* Configuring SPI2 keeps Slave Select state of SPI1 */
+    TestCheck(SPI_ConfigStandardModeSfr(&SPI2_MODULE, spi2Config), "SPI2 configuration");
+    TestCheck(SPI_GetSsState(&SPI1_MODULE).pioA == (1u << PIO_PIN_POS(TEST_SPI1_SS)), "SPI1 state kept by SPI2 configuration");
+    TestCheck(SPI_GetSsState(&SPI2_MODULE).pioB == 0, "SPI2 state empty after configuration");
+
+    /* Pins of other module are not part of the state */
+    TestCheck(!SPI_EnableSsState(&SPI2_MODULE, TEST_SPI1_SS), "SPI1 pin rejected by SPI2");
+    SpiSsState_t foreignState = {1u << PIO_PIN_POS(TEST_SPI1_SS), 1u << PIO_PIN_POS(TEST_SPI2_SS)};
+    TestCheck(SPI_SetSsState(&SPI2_MODULE, foreignState), "SPI2 state set");
+    TestCheck((SPI_GetSsState(&SPI2_MODULE).pioA == 0) &&
+              (SPI_GetSsState(&SPI2_MODULE).pioB == (1u << PIO_PIN_POS(TEST_SPI2_SS))), "SPI2 state masked");
+
+    /* SPI2 frames take about three times longer than SPI1 frames */
+    hostSpi[0].frameTicks = 7;
+    hostSpi[1].frameTicks = 23;
+    hostSpi[0].device = TestDeviceShift;
+    hostSpi[1].device = TestDeviceShift;
+
+    static uint8_t tx1[TEST_SPI1_SIZE];
+    static uint8_t rx1[TEST_SPI1_SIZE];
+    static uint16_t tx2[TEST_SPI2_SIZE];
+    static uint16_t rx2[TEST_SPI2_SIZE];
+
+    for( uint32_t idx = 0; idx < TEST_SPI1_SIZE; idx++ )
+    {
+        tx1[idx] = (uint8_t)(idx * 7 + 1);
+    }
+    for( uint32_t idx = 0; idx < TEST_SPI2_SIZE; idx++ )
+    {
+        tx2[idx] = (uint16_t)(idx * 0x0101 + 0x1234);
+    }
+
+    /* SPI1 alone: SPI2 Slave Select stays inactive */
+    testIsActive[0] = true;
+    TestCheck(SPI_MasterWrite(&SPI1_MODULE, rx1, tx1, TEST_SPI1_SIZE), "SPI1 transfer started");
+    TestCheck(HostSpiRun(TestIsIdle, TEST_MAX_TICKS), "SPI1 transfer done");
+    testIsActive[0] = false;
+
+    TestCheck(testDevice[0].count == TEST_SPI1_SIZE, "SPI1 frame count");
+    TestCheck(testDevice[0].ssErrorCount == 0, "SPI1 alone asserts own Slave Select only");
+
+    /* Interleaved: SPI2 starts while SPI1 is transferring */
+    memset(testDevice, 0, sizeof(testDevice));
+    memset(rx1, 0, sizeof(rx1));
+    testIsActive[0] = true;
+    testIsActive[1] = true;
+
+    TestCheck(SPI_MasterWrite(&SPI1_MODULE, rx1, tx1, TEST_SPI1_SIZE), "SPI1 transfer started");
+    HostIdle(50);
+    HostSpiService();
+    TestCheck(SPI_MasterWrite(&SPI2_MODULE, rx2, tx2, TEST_SPI2_SIZE), "SPI2 transfer started during SPI1 transfer");
+    TestCheck(HostSpiRun(TestIsIdle, TEST_MAX_TICKS), "interleaved transfers done");
+
+    testIsActive[0] = false;
+    testIsActive[1] = false;
+
+    TestCheck(!HostSsIsActive(TEST_SPI1_SS) && !HostSsIsActive(TEST_SPI2_SS), "Slave Select pins released");
+    TestCheck((testDevice[0].ssErrorCount == 0) && (testDevice[1].ssErrorCount == 0), "Slave Select framing");
+    TestCheck((testDevice[0].count == TEST_SPI1_SIZE) && (testDevice[1].count == TEST_SPI2_SIZE), "frame counts");
+
+    bool isDataOk = true;
+
+    for( uint32_t idx = 0; idx < TEST_SPI1_SIZE; idx++ )
+    {
+        isDataOk = isDataOk && (testDevice[0].data[idx] == tx1[idx]) && (rx1[idx] == (uint8_t)~tx1[idx]);
+    }
+    for( uint32_t idx = 0; idx < TEST_SPI2_SIZE; idx++ )
+    {
+        isDataOk = isDataOk && (testDevice[1].data[idx] == tx2[idx]) && (rx2[idx] == (uint16_t)~tx2[idx]);
+    }
+    TestCheck(isDataOk, "full-duplex data of both modules");
+
+    /* Transfers really overlapped */
+    TestCheck(testOverlapCount != 0, "transfers overlapped");
+
+    printf("%u checks, %u failed (%u overlapping frames)\n", checkCount, failCount, testOverlapCount);
+
+    return (failCount == 0) ? 0 : 1;
+}
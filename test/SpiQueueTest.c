@@ -0,0 +1,259 @@
+/*
+ *  Host test of SPI_QueueJob() on the SPI register model: jobs of mixed frame
+ *  width and Slave Select pin are queued at once and chained from ISR, the
+ *  bus idle time between first and last frame is compared with submitting
+ *  the same jobs one by one from a polling main loop; the configured frame
+ *  width must be restored once the queue drains
+ */
+#include "HostSfr.h"
+#include "../Spi/Spi.c"
+#include "HostSpi.h"
+
+#define TEST_SS1_PIN        GPIO_RPA0
+#define TEST_SS2_PIN        GPIO_RPB3
+#define TEST_FRAME_TICKS    10
+#define TEST_POLL_TICKS     40          // Main loop period of sequential submission
+#define TEST_MAX_TICKS      100000
+#define TEST_MAX_FRAMES     256
+
+/** Frames seen by Slave devices (Slave Select pin index per frame) **/
+static uint32_t testMosi[TEST_MAX_FRAMES];
+static uint32_t testSsIdx[TEST_MAX_FRAMES];
+static uint32_t testFrameCount;
+static uint64_t testFirstTick;
+static uint64_t testLastTick;
+
+/** Completion order of jobs **/
+static uint32_t testDoneOrder[8];
+static uint32_t testDoneCount;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s\n", what);
+        failCount++;
+    }
+}
+
+
+/*
+ *  Slave devices: record MOSI frame, active Slave Select pin (2 if none or
+ *  both) and return complement of frame
+ */
+static uint32_t TestDeviceShift(uint32_t module, uint32_t data)
+{
+    bool isSs1 = HostSsIsActive(TEST_SS1_PIN);
+    bool isSs2 = HostSsIsActive(TEST_SS2_PIN);
+
+    (void)module;
+
+    if( testFrameCount == 0 )
+    {
+        testFirstTick = hostTick;
+    }
+    testLastTick = hostTick;
+
+    if( testFrameCount < TEST_MAX_FRAMES )
+    {
+        testMosi[testFrameCount] = data;
+        testSsIdx[testFrameCount] = (isSs1 != isSs2) ? (isSs1 ? 0 : 1) : 2;
+    }
+    testFrameCount++;
+
+    return ~data;
+}
+
+
+/** Job completion functions **/
+static void TestDone0(void) { testDoneOrder[testDoneCount++] = 0; }
+static void TestDone1(void) { testDoneOrder[testDoneCount++] = 1; }
+static void TestDone2(void) { testDoneOrder[testDoneCount++] = 2; }
+static void TestDone3(void) { testDoneOrder[testDoneCount++] = 3; }
+
+/** Jobs: mixed frame widths and Slave devices **/
+static uint8_t tx0[20], rx0[20];
+static uint16_t tx1[12], rx1[12];
+static uint8_t tx2[33], rx2[33];
+static uint32_t tx3[6], rx3[6];
+
+static SpiJob_t testJob[] = {
+    {TEST_SS1_PIN, tx0, rx0, 20, SPI_WIDTH_8BIT,  TestDone0},
+    {TEST_SS2_PIN, tx1, rx1, 12, SPI_WIDTH_16BIT, TestDone1},
+    {TEST_SS1_PIN, tx2, rx2, 33, SPI_WIDTH_8BIT,  TestDone2},
+    {TEST_SS2_PIN, tx3, rx3, 6,  SPI_WIDTH_32BIT, TestDone3},
+};
+#define TEST_JOB_COUNT  (sizeof(testJob) / sizeof(testJob[0]))
+
+
+static bool TestIsIdle(void)
+{
+    return !SPI_IsSpiBusy(&SPI1_MODULE);
+}
+
+
+static void TestReset(void)
+{
+    testFrameCount = 0;
+    testDoneCount = 0;
+
+    memset(rx0, 0, sizeof(rx0));
+    memset(rx1, 0, sizeof(rx1));
+    memset(rx2, 0, sizeof(rx2));
+    memset(rx3, 0, sizeof(rx3));
+}
+
+
+/*
+ *  Checks frames, Slave Select, RX data and completion order of all jobs
+ *  Returns bus idle ticks between first and last frame
+ */
+static uint64_t TestVerify(const char *name)
+{
+    uint32_t frameIdx = 0;
+    uint32_t frameTotal = 0;
+    bool isOk = (testFrameCount <= TEST_MAX_FRAMES) && (testDoneCount == TEST_JOB_COUNT);
+
+    for( uint32_t jobIdx = 0; isOk && (jobIdx < TEST_JOB_COUNT); jobIdx++ )
+    {
+        const SpiJob_t *job = &testJob[jobIdx];
+        uint32_t ssIdx = (job->ssPin == TEST_SS1_PIN) ? 0 : 1;
+
+        isOk = (testDoneOrder[jobIdx] == jobIdx);
+
+        for( uint32_t idx = 0; isOk && (idx < job->txSize); idx++, frameIdx++ )
+        {
+            uint32_t txFrame, rxFrame;
+
+            if( job->frameWidth == SPI_WIDTH_8BIT )
+            {
+                txFrame = ((uint8_t *)job->txPtr)[idx];
+                rxFrame = ((uint8_t *)job->rxPtr)[idx] ^ 0xFF;
+            }
+            else if( job->frameWidth == SPI_WIDTH_16BIT )
+            {
+                txFrame = ((uint16_t *)job->txPtr)[idx];
+                rxFrame = ((uint16_t *)job->rxPtr)[idx] ^ 0xFFFF;
+            }
+            else
+            {
+                txFrame = ((uint32_t *)job->txPtr)[idx];
+                rxFrame = ~((uint32_t *)job->rxPtr)[idx];
+            }
+
+            isOk = (testMosi[frameIdx] == txFrame) && (rxFrame == txFrame) && (testSsIdx[frameIdx] == ssIdx);
+        }
+
+        frameTotal += job->txSize;
+    }
+
+    isOk = isOk && (testFrameCount == frameTotal);
+    checkCount++;
+
+    if( !isOk )
+    {
+        fprintf(stderr, "FAIL: %s: frames, Slave Select or completion order\n", name);
+        failCount++;
+    }
+
+    return (testLastTick - testFirstTick) - (uint64_t)(frameTotal - 1) * TEST_FRAME_TICKS;
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+    HostSpiInit();
+
+    SpiStandardConfig_t spiConfig = {
+        .isMasterEnabled = true,
+        .pinSelect = {.sdiPin = SDI1_RPB1, .sdoPin = SDO1_RPA1, .ss1Pin = TEST_SS1_PIN, .ss2Pin = TEST_SS2_PIN},
+        .frameWidth = SPI_WIDTH_16BIT,
+        .clkMode = SPI_CLK_MODE_0,
+        .sckFreq = 2000000
+    };
+
+    TestCheck(SPI_ConfigStandardModeSfr(&SPI1_MODULE, spiConfig), "configuration");
+    TestCheck(SPI_EnableSsState(&SPI1_MODULE, TEST_SS2_PIN), "Slave Select");
+
+    hostSpi[0].frameTicks = TEST_FRAME_TICKS;
+    hostSpi[0].device = TestDeviceShift;
+
+    for( uint32_t idx = 0; idx < sizeof(tx0); idx++ )
+    {
+        tx0[idx] = (uint8_t)(idx * 3 + 1);
+    }
+    for( uint32_t idx = 0; idx < sizeof(tx2); idx++ )
+    {
+        tx2[idx] = (uint8_t)(idx * 5 + 7);
+    }
+    for( uint32_t idx = 0; idx < 12; idx++ )
+    {
+        tx1[idx] = (uint16_t)(0xA000 + idx * 0x0111);
+    }
+    for( uint32_t idx = 0; idx < 6; idx++ )
+    {
+        tx3[idx] = 0x01020304u * (idx + 1);
+    }
+
+    /* Sequential: next job submitted by main loop polling for completion */
+    TestReset();
+
+    for( uint32_t jobIdx = 0; jobIdx < TEST_JOB_COUNT; jobIdx++ )
+    {
+        TestCheck(SPI_QueueJob(&SPI1_MODULE, testJob[jobIdx]), "sequential job queued");
+
+        while( SPI_GetQueueCount(&SPI1_MODULE) != 0 )
+        {
+            HostIdle(TEST_POLL_TICKS);
+            HostSpiService();
+        }
+    }
+    TestCheck(HostSpiRun(TestIsIdle, TEST_MAX_TICKS), "sequential jobs done");
+
+    uint64_t seqGap = TestVerify("sequential");
+
+    /* Queued: all jobs submitted at once, chained from ISR */
+    TestReset();
+
+    for( uint32_t jobIdx = 0; jobIdx < TEST_JOB_COUNT; jobIdx++ )
+    {
+        TestCheck(SPI_QueueJob(&SPI1_MODULE, testJob[jobIdx]), "job queued");
+    }
+    TestCheck(SPI_GetQueueCount(&SPI1_MODULE) == TEST_JOB_COUNT, "queue count");
+    TestCheck(HostSpiRun(TestIsIdle, TEST_MAX_TICKS), "queued jobs done");
+
+    uint64_t queueGap = TestVerify("queued");
+
+    TestCheck(queueGap < seqGap, "queued jobs leave less bus idle time");
+
+    /* Frame width of configured mode is back for non-queued transfers */
+    TestCheck(((HostPeek(HOST_SPI_ADDR(0) + HOST_SPI_CON) & SPI_MODE_MASK) >> SPI_MODE_POS) == SPI_WIDTH_16BIT,
+              "configured frame width restored");
+
+    static uint16_t txCfg[10] = {0x1234, 0xFEDC, 0x0F0F, 0xF0F0, 0x8001, 0x7FFE, 0x0000, 0xFFFF, 0x5555, 0xAAAA};
+    static uint16_t rxCfg[10];
+
+    testFrameCount = 0;
+    TestCheck(SPI_MasterWrite(&SPI1_MODULE, rxCfg, txCfg, 10), "transfer after queue");
+    TestCheck(HostSpiRun(TestIsIdle, TEST_MAX_TICKS), "transfer after queue done");
+
+    bool isCfgOk = (testFrameCount == 10);
+
+    for( uint32_t idx = 0; isCfgOk && (idx < 10); idx++ )
+    {
+        isCfgOk = (testMosi[idx] == txCfg[idx]) && (rxCfg[idx] == (uint16_t)~txCfg[idx]);
+    }
+    TestCheck(isCfgOk, "16-bit frames after queue of other widths");
+
+    printf("%u checks, %u failed (bus idle ticks: queued %llu, sequential %llu)\n", checkCount, failCount,
+           (unsigned long long)queueGap, (unsigned long long)seqGap);
+
+    return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+/*
+ *  Host test of the table-driven timer ISR dispatch: ISR_Tmr1..5 sharing
+ *  IsrDispatch() must leave the same SFR writes, timebase, pulse capture and
+ *  handler calls as a reference with the five duplicated ISR bodies used
+ *  before (16-bit and 32-bit mode, gate, timebase and capture variants), the
+ *  host instructions of both are reported ("make size" reports code size)
+ */
+#include "HostSfr.h"
+#include "../Tmr/Tmr.c"
+#include <string.h>
+
+/** Timer input clock returned by OSC stubs **/
+uint32_t OSC_GetPbFreq(void) { return 40000000; }
+uint32_t OSC_GetSysFreq(void) { return 40000000; }
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    (void)preHook;
+    (void)postHook;
+    return true;
+}
+bool PIO_ConfigPpsSfr(const uint32_t pinCode) { (void)pinCode; return true; }
+
+#define TEST_SFR_BASE       0xBF800600UL    // TMR1 to TMR5
+#define TEST_SFR_SIZE       (TMR_INSTANCE_COUNT * 0x200)
+
+/** Machine state compared after ISR **/
+typedef struct {
+    uint8_t         tmrSfr[TEST_SFR_SIZE];
+    uint8_t         icSfr[sizeof(IcSfr_t)];
+    TmrState_t      tmrState[TMR_INSTANCE_COUNT];
+    TmrPulse_t      pulse[8];
+    uint32_t        timebaseHigh;
+    uint32_t        handlerCount;
+} TestSnapshot_t;
+
+static TmrPulse_t testPulse[8];
+static uint32_t testHandlerCount;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestHandler(void) { testHandlerCount++; }
+
+
+/******************************************************************************/
+/*----------Reference: duplicated ISR bodies with per-timer constants---------*/
+/******************************************************************************/
+
+static __attribute__((noinline)) void TestRefIsrTmr1(void)
+{
+    if( (icSfr->ICxIEC0.W & IC_T1IE_MASK) && (icSfr->ICxIFS0.W & IC_T1IF_MASK) )
+    {
+        icSfr->ICxIFS0.CLR = IC_T1IF_MASK;
+
+        if( tmrState[0].status.isGateCont == false )
+        {
+            TMR1_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+        }
+
+        PulseCaptureStore(&tmrDesc[0]);
+        SampleStore(&tmrDesc[0]);
+
+        IC_PROFILE_CALL(IC_PROFILE_TMR1, tmrState[0].isrHandler());
+    }
+}
+
+
+static __attribute__((noinline)) void TestRefIsrTmr2(void)
+{
+    if( (icSfr->ICxIEC0.W & IC_T2IE_MASK) && (icSfr->ICxIFS0.W & IC_T2IF_MASK) )
+    {
+        icSfr->ICxIFS0.CLR = IC_T2IF_MASK;
+
+        if( tmrState[1].status.isGateCont == false )
+        {
+            TMR2_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+        }
+
+        PulseCaptureStore(&tmrDesc[1]);
+        SampleStore(&tmrDesc[1]);
+
+        IC_PROFILE_CALL(IC_PROFILE_TMR2, tmrState[1].isrHandler());
+    }
+}
+
+
+static __attribute__((noinline)) void TestRefIsrTmr3(void)
+{
+    if( (icSfr->ICxIEC0.W & IC_T3IE_MASK) && (icSfr->ICxIFS0.W & IC_T3IF_MASK) )
+    {
+        /* 32-bit mode */
+        if( TMR2_MODULE.TMRxCON.W & TMR_T32_MASK )
+        {
+            if( isTimebaseOn )
+            {
+                uint32_t intrStatus = IC_GetInterruptState();
+                IC_DisableInterrupts();
+
+                timebaseHigh++;
+                icSfr->ICxIFS0.CLR = IC_T3IF_MASK;
+
+                IC_SetInterruptState(intrStatus);
+            }
+            else
+            {
+                icSfr->ICxIFS0.CLR = IC_T3IF_MASK;
+            }
+
+            if( tmrState[1].status.isGateCont == false )
+            {
+                TMR2_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+            }
+
+            PulseCaptureStore(&tmrDesc[1]);
+            SampleStore(&tmrDesc[1]);
+        }
+        /* 16-bit mode */
+        else
+        {
+            icSfr->ICxIFS0.CLR = IC_T3IF_MASK;
+
+            if( tmrState[2].status.isGateCont == false )
+            {
+                TMR3_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+            }
+
+            PulseCaptureStore(&tmrDesc[2]);
+            SampleStore(&tmrDesc[2]);
+        }
+
+        IC_PROFILE_CALL(IC_PROFILE_TMR3, tmrState[2].isrHandler());
+    }
+}
+
+
+static __attribute__((noinline)) void TestRefIsrTmr4(void)
+{
+    if( (icSfr->ICxIEC0.W & IC_T4IE_MASK) && (icSfr->ICxIFS0.W & IC_T4IF_MASK) )
+    {
+        icSfr->ICxIFS0.CLR = IC_T4IF_MASK;
+
+        if( tmrState[3].status.isGateCont == false )
+        {
+            TMR4_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+        }
+
+        PulseCaptureStore(&tmrDesc[3]);
+        SampleStore(&tmrDesc[3]);
+
+        IC_PROFILE_CALL(IC_PROFILE_TMR4, tmrState[3].isrHandler());
+    }
+}
+
+
+static __attribute__((noinline)) void TestRefIsrTmr5(void)
+{
+    if( (icSfr->ICxIEC0.W & IC_T5IE_MASK) && (icSfr->ICxIFS0.W & IC_T5IF_MASK) )
+    {
+        icSfr->ICxIFS0.CLR = IC_T5IF_MASK;
+
+        /* 32-bit mode */
+        if( TMR4_MODULE.TMRxCON.W & TMR_T32_MASK )
+        {
+            if( tmrState[3].status.isGateCont == false )
+            {
+                TMR4_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+            }
+
+            PulseCaptureStore(&tmrDesc[3]);
+            SampleStore(&tmrDesc[3]);
+        }
+        /* 16-bit mode */
+        else
+        {
+            if( tmrState[4].status.isGateCont == false )
+            {
+                TMR5_MODULE.TMRxCON.CLR = TMR_ON_MASK;
+            }
+
+            PulseCaptureStore(&tmrDesc[4]);
+            SampleStore(&tmrDesc[4]);
+        }
+
+        IC_PROFILE_CALL(IC_PROFILE_TMR5, tmrState[4].isrHandler());
+    }
+}
+
+
+/******************************************************************************/
+/*------------------------------------Test------------------------------------*/
+/******************************************************************************/
+
+static void (*const testIsr[TMR_INSTANCE_COUNT])(void) = {ISR_Tmr1, ISR_Tmr2, ISR_Tmr3, ISR_Tmr4, ISR_Tmr5};
+static void (*const testRefIsr[TMR_INSTANCE_COUNT])(void) = {TestRefIsrTmr1, TestRefIsrTmr2, TestRefIsrTmr3, TestRefIsrTmr4,
+                                                             TestRefIsrTmr5};
+
+/** Scenario start state (restored before each ISR run) **/
+static TestSnapshot_t testStart;
+
+
+static void TestSave(TestSnapshot_t *const snapPtr)
+{
+    memcpy(snapPtr->tmrSfr, (const void *)TEST_SFR_BASE, TEST_SFR_SIZE);
+    memcpy(snapPtr->icSfr, (const void *)&IC_MODULE, sizeof(IcSfr_t));
+    memcpy(snapPtr->tmrState, tmrState, sizeof(tmrState));
+    memcpy(snapPtr->pulse, testPulse, sizeof(testPulse));
+    snapPtr->timebaseHigh = timebaseHigh;
+    snapPtr->handlerCount = testHandlerCount;
+}
+
+
+static void TestRestore(const TestSnapshot_t *const snapPtr)
+{
+    memcpy((void *)TEST_SFR_BASE, snapPtr->tmrSfr, TEST_SFR_SIZE);
+    memcpy((void *)&IC_MODULE, snapPtr->icSfr, sizeof(IcSfr_t));
+    memcpy(tmrState, snapPtr->tmrState, sizeof(tmrState));
+    memcpy(testPulse, snapPtr->pulse, sizeof(testPulse));
+    timebaseHigh = snapPtr->timebaseHigh;
+    testHandlerCount = snapPtr->handlerCount;
+}
+
+
+/*
+ *  Prepares interrupt of given timer (32-bit: lower timer of pair counts)
+ */
+static void TestScenario(uint32_t tmrIdx, bool isMode32, bool isGateCont, bool isCapture, bool isTimebase)
+{
+    memset((void *)TEST_SFR_BASE, 0, TEST_SFR_SIZE);
+    memset((void *)&IC_MODULE, 0, sizeof(IcSfr_t));
+    memset(testPulse, 0, sizeof(testPulse));
+
+    uint32_t cntIdx = isMode32 ? (uint32_t)tmrDesc[tmrIdx].lowerIdx : tmrIdx;
+    TmrState_t *statePtr = &tmrState[cntIdx];
+
+    for( uint32_t idx = 0; idx < TMR_INSTANCE_COUNT; idx++ )
+    {
+        tmrState[idx].isrHandler = TestHandler;
+        tmrState[idx].status.isMode32 = false;
+        tmrState[idx].status.isGateCont = false;
+        tmrState[idx].pulseCapture.bufferPtr = NULL;
+        tmrState[idx].sampling.isOn = false;
+        tmrDesc[idx].tmrSfr->TMRxCON.W = TMR_ON_MASK;
+    }
+
+    statePtr->status.isMode32 = isMode32;
+    statePtr->status.isGateCont = isGateCont;
+    tmrDesc[cntIdx].tmrSfr->TMRxCON.W |= isMode32 ? TMR_T32_MASK : 0;
+    tmrDesc[cntIdx].tmrSfr->TMRxTMR.W = 1234 + tmrIdx;
+
+    if( isCapture )
+    {
+        statePtr->pulseCapture.bufferPtr = testPulse;
+        statePtr->pulseCapture.mask = 7;
+        statePtr->pulseCapture.head = 3;
+        statePtr->pulseCapture.tail = 1;
+        statePtr->pulseCapture.minWidth = 0xFFFFFFFF;
+    }
+
+    isTimebaseOn = isTimebase;
+    timebaseHigh = 7;
+
+    icSfr->ICxIEC0.W = tmrDesc[tmrIdx].iecMask;
+    icSfr->ICxIFS0.W = tmrDesc[tmrIdx].ifsMask;
+
+    TestSave(&testStart);
+}
+
+
+/*
+ *  Runs both ISRs from scenario start, compares resulting state, adds host
+ *  instructions
+ */
+static void TestCompare(uint32_t tmrIdx, const char *name, bool isCalled, uint64_t *stepsPtr, uint64_t *refStepsPtr)
+{
+    static TestSnapshot_t result;
+    static TestSnapshot_t refResult;
+
+    TestRestore(&testStart);
+    HostCountBegin();
+    testIsr[tmrIdx]();
+    *stepsPtr += HostCountEnd();
+    TestSave(&result);
+
+    TestRestore(&testStart);
+    HostCountBegin();
+    testRefIsr[tmrIdx]();
+    *refStepsPtr += HostCountEnd();
+    TestSave(&refResult);
+
+    checkCount++;
+
+    if( (memcmp(&result, &refResult, sizeof(result)) != 0) || (result.handlerCount != testStart.handlerCount + isCalled) )
+    {
+        fprintf(stderr, "FAIL: ISR_Tmr%u differs from reference (%s)\n", tmrIdx + 1, name);
+        failCount++;
+    }
+}
+
+
+int main(void)
+{
+    uint64_t steps[TMR_INSTANCE_COUNT] = {0};
+    uint64_t refSteps[TMR_INSTANCE_COUNT] = {0};
+    uint32_t runCount[TMR_INSTANCE_COUNT] = {0};
+
+    HostSfrInit();
+
+    for( uint32_t tmrIdx = 0; tmrIdx < TMR_INSTANCE_COUNT; tmrIdx++ )
+    {
+        /* 32-bit mode only for upper timer of pair (TMR3 and TMR5) */
+        for( uint32_t mode = 0; mode < ((tmrDesc[tmrIdx].lowerIdx >= 0) ? 2 : 1); mode++ )
+        {
+            for( uint32_t variant = 0; variant < 8; variant++ )
+            {
+                bool isGateCont = (variant & 1) != 0;
+                bool isCapture = (variant & 2) != 0;
+                bool isTimebase = (variant & 4) != 0;
+                char name[64];
+
+                snprintf(name, sizeof(name), "%s, gate %s, capture %s, timebase %s", mode ? "32-bit" : "16-bit",
+                         isGateCont ? "continuous" : "single", isCapture ? "on" : "off", isTimebase ? "on" : "off");
+
+                TestScenario(tmrIdx, mode != 0, isGateCont, isCapture, isTimebase);
+                TestCompare(tmrIdx, name, true, &steps[tmrIdx], &refSteps[tmrIdx]);
+                runCount[tmrIdx]++;
+            }
+        }
+
+        /* Flag clear: nothing is done */
+        TestScenario(tmrIdx, false, false, false, false);
+        icSfr->ICxIFS0.W = 0;
+        TestSave(&testStart);
+        TestCompare(tmrIdx, "flag clear", false, &steps[tmrIdx], &refSteps[tmrIdx]);
+    }
+
+    printf("%u checks, %u failed\n", checkCount, failCount);
+    printf("host instructions per ISR (table dispatch / duplicated bodies):");
+
+    for( uint32_t tmrIdx = 0; tmrIdx < TMR_INSTANCE_COUNT; tmrIdx++ )
+    {
+        printf(" TMR%u %llu / %llu", tmrIdx + 1, (unsigned long long)(steps[tmrIdx] / (runCount[tmrIdx] + 1)),
+               (unsigned long long)(refSteps[tmrIdx] / (runCount[tmrIdx] + 1)));
+    }
+    printf("\n");
+
+    return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,313 @@
+/*
+ *  Host test of the cached fixed-point factors of timeout mode: for every
+ *  TmrClkDiv_t x TmrTimeUnit_t combination (16-bit and 32-bit timers, several
+ *  PBCLK frequencies) PRx programmed by TMR_SetTimeoutPeriod() and the time
+ *  returned by TMR_ReadTimerPeriod() must equal exact 64-bit division, and
+ *  both must execute fewer instructions than the division they replace
+ */
+#include "HostSfr.h"
+#include "../Tmr/Tmr.c"
+
+/** Timer input clock returned by OSC stubs **/
+static uint32_t hostPbFreq;
+
+uint32_t OSC_GetPbFreq(void) { return hostPbFreq; }
+uint32_t OSC_GetSysFreq(void) { return hostPbFreq; }
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    (void)preHook;
+    (void)postHook;
+    return true;
+}
+bool PIO_ConfigPpsSfr(const uint32_t pinCode) { (void)pinCode; return true; }
+
+#define TEST_COUNT(array)   (sizeof(array) / sizeof(array[0]))
+#define TEST_LINEAR_MAX     2000        // Values tested one by one, then stepped by 1/64
+
+/** Timer under test **/
+typedef struct {
+    TmrSfr_t        *tmrSfr;
+    TmrBitMode_t    bitMode;
+    const char      *name;
+} TestTimer_t;
+
+/** Instruction counts of fixed-point code and division reference **/
+typedef struct {
+    uint64_t    setSteps;
+    uint64_t    setRefSteps;
+    uint64_t    readSteps;
+    uint64_t    readRefSteps;
+    uint32_t    setCount;
+    uint32_t    readCount;
+} TestBench_t;
+
+static TestBench_t testBench;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what, const TestTimer_t *timerPtr, uint32_t clkDiv, uint32_t timeUnit,
+                      uint32_t clkFreq, uint32_t value)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        if( failCount < 10 )
+        {
+            fprintf(stderr, "FAIL: %s (%s, clkDiv %u, unit %u, clk %u, value %u)\n", what, timerPtr->name, clkDiv, timeUnit,
+                    clkFreq, value);
+        }
+        failCount++;
+    }
+}
+
+
+/*
+ *  64-bit division of a core without 64-bit divide (shift-subtract over
+ *  quotient bits, as generic compiler runtime routines do)
+ */
+static __attribute__((noinline)) uint64_t TestRefDiv(uint64_t num, uint64_t den)
+{
+    if( den > num )
+    {
+        return 0;
+    }
+
+    uint32_t shift = (uint32_t)(__builtin_clzll(den) - __builtin_clzll(num));
+    uint64_t rem = num;
+    uint64_t quot = 0;
+
+    den <<= shift;
+
+    for( uint32_t idx = 0; idx <= shift; idx++ )
+    {
+        quot <<= 1;
+
+        if( rem >= den )
+        {
+            rem -= den;
+            quot |= 1;
+        }
+        den >>= 1;
+    }
+
+    return quot;
+}
+
+
+/*
+ *  Reference of TMR_SetTimeoutPeriod() computing PRx by division on every call
+ */
+static __attribute__((noinline)) bool TestRefSetTimeoutPeriod(TmrSfr_t *const tmrSfr, uint32_t period)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+
+    if( (descPtr == NULL) || (period == 0) || (tmrSfr->TMRxCON.W & TMR_TGATE_MASK) )
+    {
+        return false;
+    }
+
+    tmrSfr->TMRxTMR.CLR = 0xFFFFFFFF;
+    tmrSfr->TMRxPR.CLR = 0xFFFFFFFF;
+
+    const TmrToutParam_t *toutParamPtr = &descPtr->statePtr->toutParam;
+    uint64_t unit = (uint64_t)toutParamPtr->clkDiv * toutParamPtr->timeUnit;
+
+    if( unit == 0 )
+    {
+        return false;
+    }
+
+    uint64_t counts = TestRefDiv((uint64_t)period * toutParamPtr->clkFreq + unit / 2, unit);
+
+    counts = TimeoutCountsLimit(counts, descPtr->statePtr->status.isMode32 ? 0x100000000 : 0x10000);
+    tmrSfr->TMRxPR.SET = (uint32_t)(counts - 1);
+
+    return true;
+}
+
+
+/*
+ *  Reference of TMR_ReadTimerPeriod() computing time by division
+ */
+static __attribute__((noinline)) uint32_t TestRefReadTimerPeriod(TmrSfr_t *const tmrSfr)
+{
+    const TmrDesc_t *descPtr = DescGet(tmrSfr);
+
+    if( (descPtr == NULL) || (descPtr->statePtr->toutParam.timeUnit == 0) )
+    {
+        return 0;
+    }
+
+    const TmrToutParam_t *toutParamPtr = &descPtr->statePtr->toutParam;
+    uint64_t time = TestRefDiv((uint64_t)tmrSfr->TMRxTMR.W * toutParamPtr->clkDiv * toutParamPtr->timeUnit, toutParamPtr->clkFreq);
+
+    return (time > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)time;
+}
+
+
+/*
+ *  Returns pre-scaler factor programmed into TxCON
+ */
+static uint32_t TestDivFactor(TmrSfr_t *const tmrSfr)
+{
+    static const uint32_t tmr1Div[] = {1, 8, 64, 256};
+    uint32_t code = (tmrSfr->TMRxCON.W & TMR_TCKPS_MASK) >> TMR_TCKPS_POS;
+
+    return (tmrSfr == &TMR1_MODULE) ? tmr1Div[code & 0x03] : ((code <= 6) ? (1u << code) : 256);
+}
+
+
+/*
+ *  Next test value: all values up to TEST_LINEAR_MAX, then steps of about
+ *  1/64 up to the limit, limit itself last
+ */
+static uint64_t TestNextValue(uint64_t value, uint64_t limit)
+{
+    uint64_t next = (value < TEST_LINEAR_MAX) ? (value + 1) : (value + value / 64 + 1);
+
+    return ((value < limit) && (next > limit)) ? limit : next;
+}
+
+
+/*
+ *  Checks PRx and timer period of one configuration against exact division,
+ *  counts instructions of every 512th value
+ */
+static void TestCase(const TestTimer_t *timerPtr, TmrClkDiv_t clkDiv, TmrTimeUnit_t timeUnit, uint32_t clkFreq)
+{
+    TmrSfr_t *const tmrSfr = timerPtr->tmrSfr;
+    uint32_t clkDivCode = (tmrSfr == &TMR1_MODULE) ? Tmr1ClkDivGet(clkDiv) : clkDiv;
+    TmrTimeoutConfig_t tmrConfig = {
+        .bitMode = timerPtr->bitMode,
+        .clkDiv = clkDiv,
+        .clkSrc = TMR_CLK_SRC_PBCLK,
+        .timeUnit = timeUnit
+    };
+
+    /* Host memory keeps TxCON value written before, as set by hardware */
+    hostPbFreq = clkFreq;
+    tmrSfr->TMRxCON.W = (timerPtr->bitMode << TMR_T32_POS) | (clkDivCode << TMR_TCKPS_POS);
+    TestCheck(TMR_ConfigTimeoutModeSfr(tmrSfr, tmrConfig), "configuration", timerPtr, clkDiv, timeUnit, clkFreq, 0);
+
+    uint64_t unit = (uint64_t)TestDivFactor(tmrSfr) * timeUnit;
+    uint64_t maxCounts = (timerPtr->bitMode == TMR_BITMODE_32BIT) ? 0x100000000 : 0x10000;
+    bool isSetOk = true;
+    bool isReadOk = true;
+    uint32_t sampleIdx = 0;
+
+    /* Periods up to the one exceeding PRx range (saturated) */
+    uint64_t periodLimit = ((maxCounts + 1) * unit) / clkFreq + 1;
+    periodLimit = (periodLimit > 0xFFFFFFFF) ? 0xFFFFFFFF : periodLimit;
+
+    for( uint64_t period = 1; isSetOk && (period <= periodLimit); period = TestNextValue(period, periodLimit) )
+    {
+        uint64_t counts = ((uint64_t)period * clkFreq + unit / 2) / unit;
+        uint32_t prValue = (uint32_t)(TimeoutCountsLimit(counts, maxCounts) - 1);
+
+        if( (sampleIdx++ & 511) == 0 )
+        {
+            HostCountBegin();
+            TMR_SetTimeoutPeriod(tmrSfr, (uint32_t)period);
+            testBench.setSteps += HostCountEnd();
+
+            isSetOk = (tmrSfr->TMRxPR.SET == prValue);
+
+            HostCountBegin();
+            TestRefSetTimeoutPeriod(tmrSfr, (uint32_t)period);
+            testBench.setRefSteps += HostCountEnd();
+
+            isSetOk = isSetOk && (tmrSfr->TMRxPR.SET == prValue);
+            testBench.setCount++;
+        }
+        else
+        {
+            isSetOk = TMR_SetTimeoutPeriod(tmrSfr, (uint32_t)period) && (tmrSfr->TMRxPR.SET == prValue);
+        }
+
+        TestCheck(isSetOk, "TMR_SetTimeoutPeriod() PRx differs from exact division", timerPtr, clkDiv, timeUnit, clkFreq,
+                  (uint32_t)period);
+    }
+
+    /* Whole count range of timer */
+    sampleIdx = 0;
+
+    for( uint64_t count = 0; isReadOk && (count < maxCounts); count = TestNextValue(count, maxCounts - 1) )
+    {
+        uint64_t time = (count * unit) / clkFreq;
+        uint32_t expected = (time > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)time;
+        uint32_t result;
+
+        tmrSfr->TMRxTMR.W = (uint32_t)count;
+
+        if( (sampleIdx++ & 511) == 0 )
+        {
+            HostCountBegin();
+            result = TMR_ReadTimerPeriod(tmrSfr);
+            testBench.readSteps += HostCountEnd();
+
+            HostCountBegin();
+            isReadOk = (TestRefReadTimerPeriod(tmrSfr) == expected);
+            testBench.readRefSteps += HostCountEnd();
+
+            testBench.readCount++;
+        }
+        else
+        {
+            result = TMR_ReadTimerPeriod(tmrSfr);
+        }
+
+        isReadOk = isReadOk && (result == expected);
+
+        TestCheck(isReadOk, "TMR_ReadTimerPeriod() differs from exact division", timerPtr, clkDiv, timeUnit, clkFreq,
+                  (uint32_t)count);
+    }
+}
+
+
+int main(void)
+{
+    static const TestTimer_t timerList[] = {
+        {&TMR1_MODULE, TMR_BITMODE_16BIT, "TMR1"},
+        {&TMR3_MODULE, TMR_BITMODE_16BIT, "TMR3"},
+        {&TMR2_MODULE, TMR_BITMODE_32BIT, "TMR2/3 32-bit"}
+    };
+    static const TmrClkDiv_t clkDivList[] = {TMR_CLK_DIV_1, TMR_CLK_DIV_2, TMR_CLK_DIV_4, TMR_CLK_DIV_8,
+                                             TMR_CLK_DIV_16, TMR_CLK_DIV_32, TMR_CLK_DIV_64, TMR_CLK_DIV_256};
+    static const TmrTimeUnit_t unitList[] = {TMR_TIME_UNIT_S, TMR_TIME_UNIT_MS, TMR_TIME_UNIT_US};
+    static const uint32_t clkList[] = {80000000, 48000000, 40000000, 10000000, 3333333, 31250};
+
+    HostSfrInit();
+
+    for( uint32_t tmrIdx = 0; tmrIdx < TEST_COUNT(timerList); tmrIdx++ )
+    {
+        for( uint32_t divIdx = 0; divIdx < TEST_COUNT(clkDivList); divIdx++ )
+        {
+            for( uint32_t unitIdx = 0; unitIdx < TEST_COUNT(unitList); unitIdx++ )
+            {
+                for( uint32_t clkIdx = 0; clkIdx < TEST_COUNT(clkList); clkIdx++ )
+                {
+                    TestCase(&timerList[tmrIdx], clkDivList[divIdx], unitList[unitIdx], clkList[clkIdx]);
+                }
+            }
+        }
+    }
+
+    /* Benchmark: cached factor against division on every call */
+    checkCount++;
+    if( (testBench.setSteps >= testBench.setRefSteps) || (testBench.readSteps >= testBench.readRefSteps) )
+    {
+        fprintf(stderr, "FAIL: fixed-point conversion not cheaper than division\n");
+        failCount++;
+    }
+
+    printf("%u checks, %u failed\n", checkCount, failCount);
+    printf("host instructions per call (fixed-point / division): TMR_SetTimeoutPeriod() %llu / %llu, "
+           "TMR_ReadTimerPeriod() %llu / %llu\n",
+           (unsigned long long)(testBench.setSteps / testBench.setCount), (unsigned long long)(testBench.setRefSteps / testBench.setCount),
+           (unsigned long long)(testBench.readSteps / testBench.readCount), (unsigned long long)(testBench.readRefSteps / testBench.readCount));
+
+    return (failCount == 0) ? 0 : 1;
+}
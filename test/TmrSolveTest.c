@@ -0,0 +1,239 @@
+/*
+ *  Host test of TMR_SolveTimeoutPeriod(): solution is compared with brute-force
+ *  search over pre-scaler x PRx x bit mode, and PRx programmed by
+ *  TMR_SetTimeoutPeriod() for the chosen configuration must equal the solved
+ *  PRx value
+ */
+#include "HostSfr.h"
+#include "../Tmr/Tmr.c"
+
+/** Timer input clock returned by OSC stubs **/
+static uint32_t hostPbFreq;
+
+uint32_t OSC_GetPbFreq(void) { return hostPbFreq; }
+uint32_t OSC_GetSysFreq(void) { return hostPbFreq; }
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    (void)preHook;
+    (void)postHook;
+    return true;
+}
+bool PIO_ConfigPpsSfr(const uint32_t pinCode) { (void)pinCode; return true; }
+
+/** 32-bit PRx values are searched within this distance of the ideal one (the
+ ** error is V-shaped in PRx, so the minimum always lies inside) **/
+#define TEST_PR32_WINDOW    4096
+
+#define TEST_COUNT(array)   (sizeof(array) / sizeof(array[0]))
+
+typedef struct {
+    bool        isFound;
+    uint32_t    bitMode;
+    uint32_t    clkDiv;
+    uint64_t    error;
+} TestBest_t;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+/*
+ *  Returns pre-scaler factor of TmrClkDiv_t value
+ */
+static uint32_t TestDivFactor(TmrClkDiv_t clkDiv)
+{
+    return (clkDiv <= 6) ? (1u << clkDiv) : 256;
+}
+
+
+/*
+ *  Returns period error of PRx value in units of (clkFreq * timeUnit)^-1 s
+ */
+static uint64_t TestError(uint64_t prValue, uint64_t unit, uint64_t target)
+{
+    uint64_t achieved = (prValue + 1) * unit;
+
+    return (achieved > target) ? (achieved - target) : (target - achieved);
+}
+
+
+/*
+ *  Exhaustive search over bit mode, pre-scaler and PRx (PRx = 0 generates no
+ *  interrupt flag and is not a valid timeout), first best on equal error
+ */
+static TestBest_t TestBruteForce(TmrSfr_t *const tmrSfr, uint32_t clkFreq, uint32_t period, uint32_t tolerance, uint32_t timeUnit)
+{
+    static const TmrClkDiv_t tmr1ClkDiv[] = {TMR_CLK_DIV_1, TMR_CLK_DIV_8, TMR_CLK_DIV_64, TMR_CLK_DIV_256};
+    static const TmrClkDiv_t tmrClkDiv[] = {TMR_CLK_DIV_1, TMR_CLK_DIV_2, TMR_CLK_DIV_4, TMR_CLK_DIV_8,
+                                            TMR_CLK_DIV_16, TMR_CLK_DIV_32, TMR_CLK_DIV_64, TMR_CLK_DIV_256};
+
+    const TmrClkDiv_t *clkDivPtr = (tmrSfr == &TMR1_MODULE) ? tmr1ClkDiv : tmrClkDiv;
+    uint32_t clkDivCount = (tmrSfr == &TMR1_MODULE) ? 4 : 8;
+    uint32_t bitModeCount = ((tmrSfr == &TMR2_MODULE) || (tmrSfr == &TMR4_MODULE)) ? 2 : 1;
+
+    uint64_t target = (uint64_t)period * clkFreq;
+    TestBest_t best = {0};
+
+    for( uint32_t mode = 0; mode < bitModeCount; mode++ )
+    {
+        uint64_t prMax = (mode == TMR_BITMODE_16BIT) ? 0xFFFF : 0xFFFFFFFF;
+
+        for( uint32_t idx = 0; idx < clkDivCount; idx++ )
+        {
+            uint64_t unit = (uint64_t)TestDivFactor(clkDivPtr[idx]) * timeUnit;
+            uint64_t prFirst = 1;
+            uint64_t prLast = prMax;
+
+            if( mode == TMR_BITMODE_32BIT )
+            {
+                uint64_t ideal = target / unit;
+
+                prFirst = (ideal > TEST_PR32_WINDOW) ? (ideal - TEST_PR32_WINDOW) : 1;
+                prLast = (ideal + TEST_PR32_WINDOW < prMax) ? (ideal + TEST_PR32_WINDOW) : prMax;
+
+                if( prFirst > prLast )
+                {
+                    prFirst = prLast;
+                }
+            }
+
+            for( uint64_t prValue = prFirst; prValue <= prLast; prValue++ )
+            {
+                uint64_t error = TestError(prValue, unit, target);
+
+                if( !best.isFound || (error < best.error) )
+                {
+                    best.isFound = true;
+                    best.bitMode = mode;
+                    best.clkDiv = clkDivPtr[idx];
+                    best.error = error;
+                }
+            }
+        }
+    }
+
+    if( best.error > (uint64_t)tolerance * clkFreq )
+    {
+        best.isFound = false;
+    }
+
+    return best;
+}
+
+
+static void TestFail(const char *what, TmrSfr_t *const tmrSfr, uint32_t clkFreq, uint32_t period, uint32_t tolerance, uint32_t timeUnit)
+{
+    if( failCount < 10 )
+    {
+        fprintf(stderr, "FAIL: %s (TMR%d, clk %u, period %u, tolerance %u, unit %u)\n", what,
+                (int)(DescGet(tmrSfr) - tmrDesc) + 1, clkFreq, period, tolerance, timeUnit);
+    }
+
+    failCount++;
+}
+
+
+/*
+ *  Checks solution against brute force and TMR_SetTimeoutPeriod()
+ */
+static void TestCase(TmrSfr_t *const tmrSfr, uint32_t clkFreq, uint32_t period, uint32_t tolerance, uint32_t timeUnit)
+{
+    TmrTimeoutSolution_t solution;
+    bool isFound = TMR_SolveTimeoutPeriod(tmrSfr, clkFreq, period, tolerance, timeUnit, &solution);
+    TestBest_t best = TestBruteForce(tmrSfr, clkFreq, period, tolerance, timeUnit);
+
+    checkCount++;
+
+    if( isFound != best.isFound )
+    {
+        TestFail(isFound ? "solution found, none expected" : "no solution found", tmrSfr, clkFreq, period, tolerance, timeUnit);
+        return;
+    }
+
+    if( !isFound )
+    {
+        return;
+    }
+
+    uint64_t unit = (uint64_t)TestDivFactor(solution.clkDiv) * timeUnit;
+    uint64_t error = TestError(solution.prValue, unit, (uint64_t)period * clkFreq);
+
+    if( (solution.bitMode != best.bitMode) || (solution.clkDiv != best.clkDiv) || (error != best.error) ||
+        (solution.prValue == 0) || ((solution.bitMode == TMR_BITMODE_16BIT) && (solution.prValue > 0xFFFF)) )
+    {
+        TestFail("solution differs from brute force", tmrSfr, clkFreq, period, tolerance, timeUnit);
+        return;
+    }
+
+    if( solution.period != (uint32_t)(((solution.prValue + 1ULL) * unit + clkFreq / 2) / clkFreq) )
+    {
+        TestFail("achieved period mismatch", tmrSfr, clkFreq, period, tolerance, timeUnit);
+        return;
+    }
+
+    /* Configure timer as TMR_ConfigTimeoutModeAuto() does (host memory keeps
+     * TxCON value written before, as set by hardware) */
+    uint32_t clkDivCode = (tmrSfr == &TMR1_MODULE) ? Tmr1ClkDivGet(solution.clkDiv) : solution.clkDiv;
+    TmrTimeoutConfig_t tmrConfig = {
+        .bitMode = solution.bitMode,
+        .clkDiv = solution.clkDiv,
+        .clkSrc = TMR_CLK_SRC_PBCLK,
+        .timeUnit = timeUnit
+    };
+
+    hostPbFreq = clkFreq;
+    tmrSfr->TMRxCON.W = (solution.bitMode << TMR_T32_POS) | (clkDivCode << TMR_TCKPS_POS);
+
+    if( !TMR_ConfigTimeoutModeSfr(tmrSfr, tmrConfig) || !TMR_SetTimeoutPeriod(tmrSfr, period) )
+    {
+        TestFail("configuration failed", tmrSfr, clkFreq, period, tolerance, timeUnit);
+        return;
+    }
+
+    /* Last value written to PRx */
+    if( tmrSfr->TMRxPR.SET != solution.prValue )
+    {
+        TestFail("TMR_SetTimeoutPeriod() programs other PRx", tmrSfr, clkFreq, period, tolerance, timeUnit);
+    }
+}
+
+
+int main(void)
+{
+    HostSfrInit();
+
+    TmrSfr_t *const tmrList[] = {&TMR1_MODULE, &TMR2_MODULE, &TMR3_MODULE, &TMR4_MODULE};
+    static const uint32_t clkList[] = {40000000, 48000000, 10000000, 8000000, 1000000, 31250};
+    static const uint32_t unitList[] = {TMR_TIME_UNIT_S, TMR_TIME_UNIT_MS, TMR_TIME_UNIT_US};
+    static const uint32_t periodList[] = {1, 2, 3, 7, 10, 33, 100, 333, 1000, 1024, 4095, 9999, 65535, 65536,
+                                          100000, 262144, 1000000, 3333333, 60000000};
+
+    for( uint32_t tmrIdx = 0; tmrIdx < TEST_COUNT(tmrList); tmrIdx++ )
+    {
+        for( uint32_t clkIdx = 0; clkIdx < TEST_COUNT(clkList); clkIdx++ )
+        {
+            for( uint32_t unitIdx = 0; unitIdx < TEST_COUNT(unitList); unitIdx++ )
+            {
+                for( uint32_t periodIdx = 0; periodIdx < TEST_COUNT(periodList); periodIdx++ )
+                {
+                    uint32_t period = periodList[periodIdx];
+
+                    /* Periods of more than about 100 s are of no interest */
+                    if( ((uint64_t)period * 1000000 / unitList[unitIdx]) > 100000000 )
+                    {
+                        continue;
+                    }
+
+                    /* Exact, 1 % and generous tolerance */
+                    TestCase(tmrList[tmrIdx], clkList[clkIdx], period, 0, unitList[unitIdx]);
+                    TestCase(tmrList[tmrIdx], clkList[clkIdx], period, period / 100, unitList[unitIdx]);
+                    TestCase(tmrList[tmrIdx], clkList[clkIdx], period, period, unitList[unitIdx]);
+                }
+            }
+        }
+    }
+
+    printf("%u checks, %u failed\n", checkCount, failCount);
+
+    return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/*
+ *  Host test of tickless core timer scheduling: the simulated CP0 count runs
+ *  across its 32-bit wrap with random interrupt latency, every wheel timer
+ *  callback must run at its deadline (accumulated from the start count, no
+ *  drift) and far fewer interrupts than one per millisecond are taken
+ */
+#include "HostSfr.h"
+#include "../Tmr/Tmr.c"
+
+/** System clock returned by OSC stubs (core timer counts at half of it) **/
+static uint32_t hostSysFreq = 40000000;
+
+uint32_t OSC_GetPbFreq(void) { return hostSysFreq; }
+uint32_t OSC_GetSysFreq(void) { return hostSysFreq; }
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    (void)preHook;
+    (void)postHook;
+    return true;
+}
+bool PIO_ConfigPpsSfr(const uint32_t pinCode) { (void)pinCode; return true; }
+
+#define TEST_TICK_COUNT     20000       // Core timer counts per 1 ms tick
+#define TEST_RUN_MS         10000
+#define TEST_WRAP_MS        300         // Count wraps this long after start
+#define TEST_LATENCY_MAX    (TEST_TICK_COUNT / 4)
+#define TEST_LATE_START_MS  2500        // Timer started between two ticks
+#define TEST_TIMER_COUNT    5
+
+typedef struct {
+    TmrWheelTimer_t wheel;
+    uint32_t        period;             // ms
+    bool            isPeriodic;
+    uint32_t        deadline;           // Core timer count of next expiry
+    uint32_t        fireCount;
+    uint32_t        lateMax;            // Largest count past deadline
+    uint32_t        missCount;          // Callbacks before deadline or too late
+} TestTimer_t;
+
+/** Periodic fast and slow timer, one-shot within and beyond the wheel span,
+ ** one-shot started between two ticks **/
+static TestTimer_t testTimer[TEST_TIMER_COUNT] = {
+    {.period = 7, .isPeriodic = true},
+    {.period = 250, .isPeriodic = true},
+    {.period = 1000, .isPeriodic = false},
+    {.period = 5000, .isPeriodic = false},
+    {.period = 3, .isPeriodic = false}
+};
+
+static uint32_t testLatencySeed = 12345;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s\n", what);
+        failCount++;
+    }
+}
+
+
+/*
+ *  Checks callback count against deadline of timer
+ */
+static void TestFired(TestTimer_t *timerPtr)
+{
+    uint32_t late = hostCoreCount - timerPtr->deadline;
+
+    if( late > TEST_LATENCY_MAX )
+    {
+        timerPtr->missCount++;
+    }
+    timerPtr->lateMax = (late > timerPtr->lateMax) ? late : timerPtr->lateMax;
+
+    timerPtr->deadline += timerPtr->period * TEST_TICK_COUNT;
+    timerPtr->fireCount++;
+}
+
+static void TestFired0(void) { TestFired(&testTimer[0]); }
+static void TestFired1(void) { TestFired(&testTimer[1]); }
+static void TestFired2(void) { TestFired(&testTimer[2]); }
+static void TestFired3(void) { TestFired(&testTimer[3]); }
+static void TestFired4(void) { TestFired(&testTimer[4]); }
+
+static void (*const testHandler[TEST_TIMER_COUNT])(void) = {TestFired0, TestFired1, TestFired2, TestFired3, TestFired4};
+
+
+/*
+ *  Interrupt latency of 0 to TEST_LATENCY_MAX counts
+ */
+static uint32_t TestLatency(void)
+{
+    testLatencySeed = testLatencySeed * 1103515245 + 12345;
+
+    return (testLatencySeed >> 8) % (TEST_LATENCY_MAX + 1);
+}
+
+
+int main(void)
+{
+    uint32_t isrCount = 0;
+    bool isLateStarted = false;
+    bool isWrapped = false;
+
+    HostSfrInit();
+
+    /* First timer start configures core timer at this count */
+    uint32_t startCount = 0u - TEST_WRAP_MS * TEST_TICK_COUNT;
+    hostCoreCount = startCount;
+
+    for( uint32_t idx = 0; idx < TEST_TIMER_COUNT - 1; idx++ )
+    {
+        testTimer[idx].deadline = startCount + testTimer[idx].period * TEST_TICK_COUNT;
+        TestCheck(TMR_StartWheelTimer(&testTimer[idx].wheel, testTimer[idx].period, testTimer[idx].isPeriodic, testHandler[idx]),
+                  "timer started");
+    }
+
+    /* Compare is programmed for the nearest deadline only */
+    TestCheck(hostCoreCompare == testTimer[0].deadline, "compare at nearest deadline");
+
+    while( (hostCoreCompare - startCount) <= TEST_RUN_MS * TEST_TICK_COUNT )
+    {
+        uint32_t compare = hostCoreCompare;
+
+        /* Timer started between two ticks expires on the tick grid, compare
+         * is brought forward if its deadline is nearer */
+        if( !isLateStarted && ((compare - startCount) >= TEST_LATE_START_MS * TEST_TICK_COUNT) )
+        {
+            TestTimer_t *timerPtr = &testTimer[TEST_TIMER_COUNT - 1];
+            uint32_t lateStart = hostCoreCount + TEST_TICK_COUNT / 3;
+            uint32_t gridTick = (lateStart - startCount) / TEST_TICK_COUNT;
+
+            hostCoreCount = lateStart;
+            timerPtr->deadline = startCount + (gridTick + timerPtr->period) * TEST_TICK_COUNT;
+            TestCheck(TMR_StartWheelTimer(&timerPtr->wheel, timerPtr->period, false, testHandler[TEST_TIMER_COUNT - 1]),
+                      "timer started between ticks");
+            TestCheck(hostCoreCompare == (((timerPtr->deadline - lateStart) < (compare - lateStart)) ? timerPtr->deadline : compare),
+                      "compare at nearest deadline after start");
+
+            isLateStarted = true;
+            compare = hostCoreCompare;
+        }
+
+        hostCoreCount = compare + TestLatency();
+        isWrapped = isWrapped || (hostCoreCount < startCount);
+
+        ISR_CoreTmr();
+        isrCount++;
+
+        TestCheck((hostCoreCompare - hostCoreCount) <= TMR_WHEEL_SLOTS * TMR_WHEEL_SLOTS * TEST_TICK_COUNT, "compare ahead of count");
+    }
+
+    TestCheck(isWrapped, "core timer count wrapped");
+
+    uint32_t expiryCount = 0;
+
+    for( uint32_t idx = 0; idx < TEST_TIMER_COUNT; idx++ )
+    {
+        TestTimer_t *timerPtr = &testTimer[idx];
+        uint32_t runMs = (idx == TEST_TIMER_COUNT - 1) ? timerPtr->period : TEST_RUN_MS;
+        uint32_t expected = timerPtr->isPeriodic ? (runMs / timerPtr->period) : 1;
+
+        TestCheck(timerPtr->fireCount == expected, "expiry count");
+        TestCheck(timerPtr->missCount == 0, "callback at deadline within interrupt latency");
+        expiryCount += timerPtr->fireCount;
+    }
+
+    /* Interrupts only for expiries and level 1 cascades, at most one per
+     * TMR_WHEEL_SLOTS ticks (1 ms tick: one per millisecond) */
+    TestCheck(isrCount <= expiryCount + TEST_RUN_MS / TMR_WHEEL_SLOTS + 1, "interrupts for expiries and cascades only");
+    TestCheck(isrCount < TEST_RUN_MS / 4, "fewer interrupts than periodic tick");
+
+    printf("%u checks, %u failed (%u interrupts for %u expiries in %u ms, largest lateness %u of %u counts latency)\n",
+           checkCount, failCount, isrCount, expiryCount, TEST_RUN_MS, testTimer[0].lateMax, TEST_LATENCY_MAX);
+
+    return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/*
+ *  Host test of the core timer wheel: ISR_CoreTmr() cost (host instructions)
+ *  with 1, 64 and 512 armed timers, an ISR expiring a single timer must cost
+ *  the same regardless of the other timers armed, one-shot and periodic
+ *  timers expire the expected number of times
+ */
+#include "HostSfr.h"
+#include "../Tmr/Tmr.c"
+
+/** System clock returned by OSC stubs (core timer counts at half of it) **/
+static uint32_t hostSysFreq = 40000000;
+
+uint32_t OSC_GetPbFreq(void) { return hostSysFreq; }
+uint32_t OSC_GetSysFreq(void) { return hostSysFreq; }
+bool OSC_AddClkHook(void (*preHook)(const OscClkState_t *const statePtr), void (*postHook)(const OscClkState_t *const statePtr))
+{
+    (void)preHook;
+    (void)postHook;
+    return true;
+}
+bool PIO_ConfigPpsSfr(const uint32_t pinCode) { (void)pinCode; return true; }
+
+#define TEST_TIMER_MAX      512
+#define TEST_PROBE_PERIOD   10          // Probe timer period (ms)
+#define TEST_OTHER_PERIOD   300         // Shortest period of other timers (ms)
+#define TEST_RUN_MS         4000
+
+static TmrWheelTimer_t testTimer[TEST_TIMER_MAX];
+static TmrWheelTimer_t testProbe;
+
+/** Callbacks **/
+static uint32_t testProbeCount;
+static uint32_t testOtherCount;
+
+/** ISR cost of one timer count **/
+typedef struct {
+    uint64_t    singleSteps;            // Largest ISR expiring probe timer only
+    uint64_t    totalSteps;
+    uint32_t    isrCount;
+    uint32_t    expiryCount;
+} TestCost_t;
+
+static uint32_t checkCount;
+static uint32_t failCount;
+
+
+static void TestCheck(bool isPassed, const char *what, uint32_t timerCount)
+{
+    checkCount++;
+
+    if( !isPassed )
+    {
+        fprintf(stderr, "FAIL: %s (%u timers)\n", what, timerCount);
+        failCount++;
+    }
+}
+
+
+static void TestProbeDone(void) { testProbeCount++; }
+static void TestOtherDone(void) { testOtherCount++; }
+
+
+/*
+ *  Lets the core timer count reach compare and executes the ISR, returns
+ *  executed host instructions
+ */
+static uint64_t TestIsr(void)
+{
+    hostCoreCount = hostCoreCompare;
+
+    HostCountBegin();
+    ISR_CoreTmr();
+
+    return HostCountEnd();
+}
+
+
+/*
+ *  Arms probe timer and "timerCount - 1" other timers, runs the wheel for
+ *  TEST_RUN_MS and measures ISR cost
+ */
+static TestCost_t TestRun(uint32_t timerCount)
+{
+    TestCost_t cost = {0};
+    uint32_t expectedOther = 0;
+    uint32_t startCount = hostCoreCount;
+    uint32_t tickCount = OSC_GetSysFreq() / 1000 / 2;
+
+    testProbeCount = 0;
+    testOtherCount = 0;
+
+    /* Other timers expire after the probe window (periodic and one-shot,
+     * periods spread over level 1 within the wheel span) */
+    for( uint32_t idx = 0; idx + 1 < timerCount; idx++ )
+    {
+        uint32_t period = TEST_OTHER_PERIOD + idx * 7;
+        bool isPeriodic = (idx & 1) == 0;
+
+        TestCheck(TMR_StartWheelTimer(&testTimer[idx], period, isPeriodic, TestOtherDone), "timer started", timerCount);
+        expectedOther += isPeriodic ? (TEST_RUN_MS / period) : (period <= TEST_RUN_MS);
+    }
+    TestCheck(TMR_StartWheelTimer(&testProbe, TEST_PROBE_PERIOD, true, TestProbeDone), "probe started", timerCount);
+
+    /* Probe window: only the probe timer expires (no cascade of other timers) */
+    while( testProbeCount < (TEST_OTHER_PERIOD - TMR_WHEEL_SLOTS) / TEST_PROBE_PERIOD )
+    {
+        uint32_t probeCount = testProbeCount;
+        uint64_t steps = TestIsr();
+
+        TestCheck((testProbeCount == probeCount + 1) && (testOtherCount == 0), "probe expired alone", timerCount);
+        cost.singleSteps = (steps > cost.singleSteps) ? steps : cost.singleSteps;
+        cost.totalSteps += steps;
+        cost.isrCount++;
+    }
+
+    /* Remaining run time */
+    while( (hostCoreCompare - startCount) <= TEST_RUN_MS * tickCount )
+    {
+        cost.totalSteps += TestIsr();
+        cost.isrCount++;
+    }
+
+    cost.expiryCount = testProbeCount + testOtherCount;
+
+    TestCheck(testProbeCount == TEST_RUN_MS / TEST_PROBE_PERIOD, "periodic probe expiries", timerCount);
+    TestCheck(testOtherCount == expectedOther, "expiries of other timers", timerCount);
+
+    /* Disarm periodic timers and one-shot timers not yet expired */
+    TestCheck(TMR_StopWheelTimer(&testProbe), "probe stopped", timerCount);
+    for( uint32_t idx = 0; idx + 1 < timerCount; idx++ )
+    {
+        uint32_t period = TEST_OTHER_PERIOD + idx * 7;
+        bool isArmed = ((idx & 1) == 0) || (period > TEST_RUN_MS);
+
+        TestCheck(TMR_StopWheelTimer(&testTimer[idx]) == isArmed, "one-shot disarmed after expiry", timerCount);
+    }
+
+    return cost;
+}
+
+
+int main(void)
+{
+    static const uint32_t timerCountList[] = {1, 64, 512};
+    TestCost_t cost[3];
+
+    HostSfrInit();
+
+    for( uint32_t idx = 0; idx < 3; idx++ )
+    {
+        cost[idx] = TestRun(timerCountList[idx]);
+    }
+
+    /* Armed timers that do not expire are not touched by the ISR */
+    for( uint32_t idx = 1; idx < 3; idx++ )
+    {
+        TestCheck(cost[idx].singleSteps == cost[0].singleSteps, "single-expiry ISR cost independent of armed timers",
+                  timerCountList[idx]);
+    }
+
+    printf("%u checks, %u failed\n", checkCount, failCount);
+
+    for( uint32_t idx = 0; idx < 3; idx++ )
+    {
+        printf("%4u timers: single-expiry ISR %llu, %u ISRs for %u expiries, %llu instructions per ISR\n",
+               timerCountList[idx], (unsigned long long)cost[idx].singleSteps, cost[idx].isrCount, cost[idx].expiryCount,
+               (unsigned long long)(cost[idx].totalSteps / cost[idx].isrCount));
+    }
+
+    return (failCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,18 @@
+/*
+ *  Host stand-in for XC32 CP0 access (core timer count is advanced by test)
+ */
+#ifndef CP0DEFS_H
+#define CP0DEFS_H
+
+#include <stdint.h>
+
+extern uint32_t hostCoreCount;
+extern uint32_t hostCoreCompare;
+
+/** Macros as in XC32 (usable from extern inline driver functions), reads are
+ ** not reordered against SFR accesses like mfc0 **/
+#define _CP0_GET_COUNT()            (*(volatile uint32_t *)&hostCoreCount)
+#define _CP0_GET_COMPARE()          (*(volatile uint32_t *)&hostCoreCompare)
+#define _CP0_SET_COMPARE(value)     (hostCoreCompare = (uint32_t)(value))
+
+#endif
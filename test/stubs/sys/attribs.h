@@ -0,0 +1,26 @@
+/*
+ *  Host stand-in for XC32 interrupt attributes and builtins
+ */
+#ifndef SYS_ATTRIBS_H
+#define SYS_ATTRIBS_H
+
+#include <stdint.h>
+
+extern uint32_t hostIsrState;
+
+#define __ISR(vector, ipl)
+
+#define IPL1SOFT    1
+#define IPL2SOFT    2
+#define IPL3SOFT    3
+#define IPL4SOFT    4
+#define IPL5SOFT    5
+#define IPL6SOFT    6
+#define IPL7SOFT    7
+
+#define __builtin_enable_interrupts()   (hostIsrState = 1)
+#define __builtin_disable_interrupts()  (hostIsrState = 0)
+#define __builtin_set_isr_state(state)  (hostIsrState = (state))
+#define __builtin_get_isr_state()       (hostIsrState)
+
+#endif
@@ -0,0 +1,10 @@
+/*
+ *  Host stand-in for XC32 device header (SFRs are reached through the module
+ *  base address macros, see HostSfr.h)
+ */
+#ifndef XC_H
+#define XC_H
+
+#include <stdint.h>
+
+#endif